@@ -702,7 +702,7 @@ JNIEXPORT jboolean JNICALL Java_org_dolphinemu_dolphinemu_NativeLibrary_ConvertD
   case DiscIO::BlobType::RVZ:
     success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), in_path, out_path,
                                         format == DiscIO::BlobType::RVZ, compression,
-                                        jCompressionLevel, jBlockSize, callback);
+                                        jCompressionLevel, jBlockSize, false, callback);
     break;
 
   default:
@@ -3,7 +3,10 @@
 
 #include "SHA1.h"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
+#include <cstring>
 #include <memory>
 
 #include <mbedtls/sha1.h>
@@ -57,13 +60,13 @@ private:
   mbedtls_sha1_context ctx{};
 };
 
+static constexpr size_t BLOCK_LEN = 64;
+static constexpr u32 K[4]{0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6};
+static constexpr u32 H[5]{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
 class BlockContext : public Context
 {
 protected:
-  static constexpr size_t BLOCK_LEN = 64;
-  static constexpr u32 K[4]{0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6};
-  static constexpr u32 H[5]{0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
-
   virtual void ProcessBlock(const u8* msg) = 0;
   virtual Digest GetDigest() = 0;
 
@@ -152,10 +155,29 @@ private:
 
 #ifdef _M_X86_64
 
-// Uses the dedicated SHA1 instructions. Normal SSE(AVX*) would be needed for parallel
-// multi-message processing. While Dolphin could gain from such implementation, it requires the
-// calling code to be modified and/or making the SHA1 implementation asynchronous so it can
-// optimistically batch.
+using X64WorkBlock = CyclicArray<__m128i, 4>;
+
+ATTRIBUTE_TARGET("ssse3")
+static inline __m128i byterev_16B(__m128i x)
+{
+  return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+template <size_t I>
+ATTRIBUTE_TARGET("sha")
+static inline __m128i MsgSchedule(X64WorkBlock* wblock)
+{
+  auto& w = *wblock;
+  // Update and return this location
+  auto& wx = w[I];
+  // Do all the xors and rol(x,1) required for 4 rounds of msg schedule
+  wx = _mm_sha1msg1_epu32(wx, w[I + 1]);
+  wx = _mm_xor_si128(wx, w[I + 2]);
+  wx = _mm_sha1msg2_epu32(wx, w[I + 3]);
+  return wx;
+}
+
+// Uses the dedicated SHA1 instructions
 class ContextX64SHA1 final : public BlockContext
 {
 public:
@@ -166,27 +188,7 @@ public:
   }
 
 private:
-  using WorkBlock = CyclicArray<__m128i, 4>;
-
-  ATTRIBUTE_TARGET("ssse3")
-  static inline __m128i byterev_16B(__m128i x)
-  {
-    return _mm_shuffle_epi8(x, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
-  }
-
-  template <size_t I>
-  ATTRIBUTE_TARGET("sha")
-  static inline __m128i MsgSchedule(WorkBlock* wblock)
-  {
-    auto& w = *wblock;
-    // Update and return this location
-    auto& wx = w[I];
-    // Do all the xors and rol(x,1) required for 4 rounds of msg schedule
-    wx = _mm_sha1msg1_epu32(wx, w[I + 1]);
-    wx = _mm_xor_si128(wx, w[I + 2]);
-    wx = _mm_sha1msg2_epu32(wx, w[I + 3]);
-    return wx;
-  }
+  using WorkBlock = X64WorkBlock;
 
   ATTRIBUTE_TARGET("sha")
   virtual void ProcessBlock(const u8* msg) override
@@ -247,6 +249,215 @@ private:
   std::array<__m128i, 2> state{};
 };
 
+// A plain SHA-1 implementation which hashes eight messages in lockstep, one in each 32-bit lane of
+// the vectors. It's used on CPUs which have AVX2 but not the SHA instructions, and on CPUs which
+// have both if it's measured to be faster (see IsAVX2FasterThanSHAInstructions). It's driven by
+// CalculateDigestsBatched, which takes care of the padding.
+class BatchAVX2
+{
+public:
+  static constexpr size_t LANES = 8;
+
+  BatchAVX2()
+  {
+    for (size_t i = 0; i < m_state.size(); ++i)
+      m_state[i].fill(H[i]);
+  }
+
+  ATTRIBUTE_TARGET("avx2")
+  void ProcessBlocks(const u8* const msgs[LANES])
+  {
+    std::array<__m256i, 16> w;
+    for (size_t i = 0; i < w.size(); ++i)
+    {
+      w[i] = _mm256_set_epi32(ReadBE32(msgs[7] + i * 4), ReadBE32(msgs[6] + i * 4),
+                              ReadBE32(msgs[5] + i * 4), ReadBE32(msgs[4] + i * 4),
+                              ReadBE32(msgs[3] + i * 4), ReadBE32(msgs[2] + i * 4),
+                              ReadBE32(msgs[1] + i * 4), ReadBE32(msgs[0] + i * 4));
+    }
+
+    __m256i a = _mm256_load_si256((const __m256i*)m_state[0].data());
+    __m256i b = _mm256_load_si256((const __m256i*)m_state[1].data());
+    __m256i c = _mm256_load_si256((const __m256i*)m_state[2].data());
+    __m256i d = _mm256_load_si256((const __m256i*)m_state[3].data());
+    __m256i e = _mm256_load_si256((const __m256i*)m_state[4].data());
+
+    for (size_t t = 0; t < 80; ++t)
+    {
+      // The message schedule only needs the last 16 words, see FIPS 180-4 6.1.3
+      __m256i wt = w[t % 16];
+      if (t >= 16)
+      {
+        wt = _mm256_xor_si256(_mm256_xor_si256(w[(t - 3) % 16], w[(t - 8) % 16]),
+                              _mm256_xor_si256(w[(t - 14) % 16], wt));
+        wt = Rotl<1>(wt);
+        w[t % 16] = wt;
+      }
+
+      __m256i f;
+      if (t < 20)
+        f = _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+      else if (t >= 40 && t < 60)
+        f = _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+      else
+        f = _mm256_xor_si256(b, _mm256_xor_si256(c, d));
+
+      const __m256i k = _mm256_set1_epi32(K[t / 20]);
+      const __m256i temp = _mm256_add_epi32(_mm256_add_epi32(Rotl<5>(a), f),
+                                            _mm256_add_epi32(_mm256_add_epi32(e, k), wt));
+      e = d;
+      d = c;
+      c = Rotl<30>(b);
+      b = a;
+      a = temp;
+    }
+
+    AddToState(0, a);
+    AddToState(1, b);
+    AddToState(2, c);
+    AddToState(3, d);
+    AddToState(4, e);
+  }
+
+  Digest GetDigest(size_t lane) const
+  {
+    Digest digest;
+    for (size_t i = 0; i < m_state.size(); ++i)
+    {
+      const u32 value = Common::swap32(m_state[i][lane]);
+      std::memcpy(&digest[i * sizeof(u32)], &value, sizeof(u32));
+    }
+    return digest;
+  }
+
+private:
+  static u32 ReadBE32(const u8* ptr)
+  {
+    u32 value;
+    std::memcpy(&value, ptr, sizeof(u32));
+    return Common::swap32(value);
+  }
+
+  template <int N>
+  ATTRIBUTE_TARGET("avx2")
+  static inline __m256i Rotl(__m256i x)
+  {
+    return _mm256_or_si256(_mm256_slli_epi32(x, N), _mm256_srli_epi32(x, 32 - N));
+  }
+
+  ATTRIBUTE_TARGET("avx2")
+  void AddToState(size_t i, __m256i x)
+  {
+    __m256i* state = (__m256i*)m_state[i].data();
+    _mm256_store_si256(state, _mm256_add_epi32(_mm256_load_si256(state), x));
+  }
+
+  // a, b, c, d and e, one lane per message
+  alignas(32) std::array<std::array<u32, LANES>, 5> m_state;
+};
+
+template <typename Batch>
+static void CalculateDigestsBatched(const u8* msgs, size_t msg_len, size_t stride, size_t count,
+                                    Digest* digests)
+{
+  constexpr size_t LANES = Batch::LANES;
+  constexpr size_t MSG_LEN_SIZE = sizeof(u64);
+
+  const size_t full_blocks = msg_len / BLOCK_LEN;
+  const size_t tail_len = msg_len % BLOCK_LEN;
+  const size_t final_len = tail_len + 1 + MSG_LEN_SIZE > BLOCK_LEN ? BLOCK_LEN * 2 : BLOCK_LEN;
+
+  // Since all messages have the same length, the padding (which is zero apart from the 0x80 byte
+  // and the message length) only has to be set up once.
+  std::array<std::array<u8, BLOCK_LEN * 2>, LANES> final_blocks{};
+  const Common::BigEndianValue<u64> msg_bitlen(static_cast<u64>(msg_len) * 8);
+  for (auto& final_block : final_blocks)
+  {
+    final_block[tail_len] = 0x80;
+    std::memcpy(&final_block[final_len - MSG_LEN_SIZE], &msg_bitlen, MSG_LEN_SIZE);
+  }
+
+  for (size_t first = 0; first < count; first += LANES)
+  {
+    // If there aren't enough messages left to fill all lanes, hash the last one multiple times
+    std::array<const u8*, LANES> lane_msgs;
+    for (size_t lane = 0; lane < LANES; ++lane)
+      lane_msgs[lane] = msgs + std::min(first + lane, count - 1) * stride;
+
+    Batch batch;
+    std::array<const u8*, LANES> blocks;
+
+    for (size_t i = 0; i < full_blocks; ++i)
+    {
+      for (size_t lane = 0; lane < LANES; ++lane)
+        blocks[lane] = lane_msgs[lane] + i * BLOCK_LEN;
+      batch.ProcessBlocks(blocks.data());
+    }
+
+    for (size_t lane = 0; lane < LANES; ++lane)
+      std::memcpy(final_blocks[lane].data(), lane_msgs[lane] + full_blocks * BLOCK_LEN, tail_len);
+
+    for (size_t offset = 0; offset < final_len; offset += BLOCK_LEN)
+    {
+      for (size_t lane = 0; lane < LANES; ++lane)
+        blocks[lane] = final_blocks[lane].data() + offset;
+      batch.ProcessBlocks(blocks.data());
+    }
+
+    for (size_t lane = 0; lane < LANES && first + lane < count; ++lane)
+      digests[first + lane] = batch.GetDigest(lane);
+  }
+}
+
+// Whether hashing eight messages at once with AVX2 is faster than hashing them one after another
+// with the SHA instructions. This depends on how fast sha1rnds4 is on the CPU, so it's measured.
+static bool IsAVX2FasterThanSHAInstructions()
+{
+  constexpr size_t MSG_LEN = 0x400;
+  constexpr size_t COUNT = BatchAVX2::LANES;
+  const std::vector<u8> msgs(MSG_LEN * COUNT);
+  std::array<Digest, COUNT> digests;
+
+  using Clock = std::chrono::steady_clock;
+  const auto measure = [](Clock::duration* best, const auto& hash) {
+    const Clock::time_point start = Clock::now();
+    for (int i = 0; i < 8; ++i)
+      hash();
+    *best = std::min(*best, Clock::now() - start);
+  };
+
+  const auto hash_avx2 = [&] {
+    CalculateDigestsBatched<BatchAVX2>(msgs.data(), MSG_LEN, MSG_LEN, COUNT, digests.data());
+  };
+  const auto hash_sha = [&] {
+    for (size_t i = 0; i < COUNT; ++i)
+    {
+      ContextX64SHA1 sha_context;
+      Context& context = sha_context;
+      context.Update(msgs.data() + i * MSG_LEN, MSG_LEN);
+      digests[i] = context.Finish();
+    }
+  };
+
+  // Warm up first, since the upper halves of the AVX registers may still be powered down
+  for (int i = 0; i < 8; ++i)
+  {
+    hash_avx2();
+    hash_sha();
+  }
+
+  // Take the best of a few alternating runs, so that a single interruption doesn't decide it
+  Clock::duration avx2_time = Clock::duration::max();
+  Clock::duration sha_time = Clock::duration::max();
+  for (int i = 0; i < 8; ++i)
+  {
+    measure(&avx2_time, hash_avx2);
+    measure(&sha_time, hash_sha);
+  }
+
+  return avx2_time < sha_time;
+}
+
 #endif
 
 #ifdef _M_ARM_64
@@ -372,4 +583,23 @@ Digest CalculateDigest(const u8* msg, size_t len)
   ctx->Update(msg, len);
   return ctx->Finish();
 }
+
+void CalculateDigests(const u8* msgs, size_t msg_len, size_t stride, size_t count,
+                      Digest* digests)
+{
+#ifdef _M_X86_64
+  if (cpu_info.bAVX2 && count >= BatchAVX2::LANES)
+  {
+    // On CPUs with the SHA instructions (see CreateContext for why SSSE3 is checked too), those
+    // are used unless AVX2 turns out to be faster
+    static const bool use_avx2 =
+        !(cpu_info.bSHA1 && cpu_info.bSSSE3) || IsAVX2FasterThanSHAInstructions();
+    if (use_avx2)
+      return CalculateDigestsBatched<BatchAVX2>(msgs, msg_len, stride, count, digests);
+  }
+#endif
+
+  for (size_t i = 0; i < count; ++i)
+    digests[i] = CalculateDigest(msgs + i * stride, msg_len);
+}
 }  // namespace Common::SHA1
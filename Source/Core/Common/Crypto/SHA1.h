@@ -32,6 +32,12 @@ std::unique_ptr<Context> CreateContext();
 
 Digest CalculateDigest(const u8* msg, size_t len);
 
+// Calculates the digests of count messages which are msg_len bytes long each, with message i
+// starting at msgs + i * stride. This gives the same result as calling CalculateDigest on each
+// message, but is faster when the CPU can hash several messages in parallel.
+void CalculateDigests(const u8* msgs, size_t msg_len, size_t stride, size_t count,
+                      Digest* digests);
+
 template <typename T>
 inline Digest CalculateDigest(const std::vector<T>& msg)
 {
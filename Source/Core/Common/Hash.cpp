@@ -4,6 +4,7 @@
 #include "Common/Hash.h"
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cstring>
 
@@ -12,6 +13,7 @@
 #include "Common/BitUtils.h"
 #include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
+#include "Common/Inline.h"
 #include "Common/Intrinsics.h"
 
 #ifdef _M_ARM_64
@@ -20,6 +22,7 @@
 #else
 #include <arm_acle.h>
 #endif
+#include <arm_neon.h>
 #endif
 
 namespace Common
@@ -425,6 +428,245 @@ static u64 GetHash64_ARMv8_CRC32(const u8* src, u32 len, u32 samples)
 
 #endif
 
+#if defined(_M_X86_64) || defined(_M_ARM_64)
+
+// Hashing every word of a large texture is limited by how fast the CRC32 instruction can be
+// issued. These kernels instead hash blocks of 128 bytes in 16 64-bit lanes, using the
+// multiply-accumulate step of XXH3: each lane adds the product of the low and high halves of its
+// data xored with a key, plus the data of the neighboring lane. The keys change with every block
+// so that the order of the blocks matters, and the lanes are scrambled every few blocks so that
+// no bits get lost. The AVX2 and NEON kernels give the same results.
+
+constexpr u32 WIDE_HASH_BLOCK_SIZE = 128;
+constexpr u32 WIDE_HASH_LANES = WIDE_HASH_BLOCK_SIZE / sizeof(u64);
+constexpr u32 WIDE_HASH_SCRAMBLE_INTERVAL = 8;
+constexpr u64 WIDE_HASH_KEY_STEP = 0x9e3779b97f4a7c15;
+constexpr u32 WIDE_HASH_SCRAMBLE_PRIME = 0x9e3779b1;
+
+alignas(32) constexpr std::array<u64, WIDE_HASH_LANES> WIDE_HASH_KEYS = {
+    0x2dc7a20888a2a74c, 0xd06abbf717ea20ea, 0xb72ebc7e257844e2, 0xace2cb53024b5ae3,
+    0x5340b0a6df9119fe, 0x970d12db310041fc, 0x9c6ab76b55712e7e, 0x63d63a0db82457ee,
+    0xbb16a7c08ce27286, 0x5f2b55b6e13a878e, 0x0795a7118c93a99d, 0x27a9245d666bac9e,
+    0xc1d7b23c607d9ea9, 0x3aebdf349440ac1b, 0xc442481ea2303c96, 0xc57ce9acbeca696b,
+};
+
+// Below this size, finalizing the lanes costs more than is saved by hashing them in parallel
+constexpr u32 WIDE_HASH_MIN_SIZE = 1024;
+
+static bool UseWideHash(u32 len, u32 samples)
+{
+  // Sampled hashes only touch a few words, and are left to the CRC32 functions
+  const bool full_hash = samples == 0 || len / 8 / samples <= 1;
+  return full_hash && len >= WIDE_HASH_MIN_SIZE;
+}
+
+// Multiplies to 128 bits and folds the halves together
+static u64 MultiplyFold64(u64 a, u64 b)
+{
+#if defined(_MSC_VER) && defined(_M_X86_64)
+  u64 high;
+  const u64 low = _umul128(a, b, &high);
+  return low ^ high;
+#elif defined(_MSC_VER)
+  return (a * b) ^ __umulh(a, b);
+#else
+  const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+  return static_cast<u64>(product) ^ static_cast<u64>(product >> 64);
+#endif
+}
+
+static u64 FinalizeWideHash(const std::array<u64, WIDE_HASH_LANES>& lanes, u32 len)
+{
+  u64 h = len * 0x9e3779b185ebca87;
+  for (u32 i = 0; i < WIDE_HASH_LANES; i += 2)
+    h += MultiplyFold64(lanes[i] ^ WIDE_HASH_KEYS[i], lanes[i + 1] ^ WIDE_HASH_KEYS[i + 1]);
+  return fmix64(h);
+}
+
+#endif
+
+#if defined(_M_X86_64)
+
+// The lanes are kept in separate variables, since compilers fail to keep arrays of them in
+// registers
+
+FUNCTION_TARGET_AVX2
+static DOLPHIN_FORCE_INLINE void WideHashAccumulateAVX2(__m256i& acc, __m256i& key,
+                                                         const u8* data_ptr)
+{
+  const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data_ptr));
+  const __m256i data_key = _mm256_xor_si256(data, key);
+  const __m256i product = _mm256_mul_epu32(data_key, _mm256_srli_epi64(data_key, 32));
+  const __m256i swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+  acc = _mm256_add_epi64(acc, _mm256_add_epi64(product, swapped));
+  key = _mm256_add_epi64(key, _mm256_set1_epi64x(WIDE_HASH_KEY_STEP));
+}
+
+FUNCTION_TARGET_AVX2
+static DOLPHIN_FORCE_INLINE void WideHashScrambleAVX2(__m256i& acc, int index)
+{
+  const __m256i key =
+      _mm256_load_si256(reinterpret_cast<const __m256i*>(WIDE_HASH_KEYS.data()) + index);
+  const __m256i prime = _mm256_set1_epi32(WIDE_HASH_SCRAMBLE_PRIME);
+  const __m256i scrambled =
+      _mm256_xor_si256(_mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47)), key);
+  const __m256i product_low = _mm256_mul_epu32(scrambled, prime);
+  const __m256i product_high = _mm256_mul_epu32(_mm256_srli_epi64(scrambled, 32), prime);
+  acc = _mm256_add_epi64(product_low, _mm256_slli_epi64(product_high, 32));
+}
+
+FUNCTION_TARGET_AVX2
+static u64 GetHash64_AVX2(const u8* src, u32 len, u32 samples)
+{
+  if (!UseWideHash(len, samples))
+    return GetHash64_SSE42_CRC32(src, len, samples);
+
+  const __m256i* const keys = reinterpret_cast<const __m256i*>(WIDE_HASH_KEYS.data());
+  __m256i acc0 = _mm256_setzero_si256();
+  __m256i acc1 = _mm256_setzero_si256();
+  __m256i acc2 = _mm256_setzero_si256();
+  __m256i acc3 = _mm256_setzero_si256();
+  __m256i key0 = _mm256_load_si256(keys + 0);
+  __m256i key1 = _mm256_load_si256(keys + 1);
+  __m256i key2 = _mm256_load_si256(keys + 2);
+  __m256i key3 = _mm256_load_si256(keys + 3);
+
+  // The last block is padded with zeroes. They can't be confused with data since the length gets
+  // hashed as well.
+  alignas(32) std::array<u8, WIDE_HASH_BLOCK_SIZE> tail;
+  const u32 block_count = (len + WIDE_HASH_BLOCK_SIZE - 1) / WIDE_HASH_BLOCK_SIZE;
+  for (u32 block = 0; block < block_count; ++block)
+  {
+    const u8* data_ptr = src + block * WIDE_HASH_BLOCK_SIZE;
+    if (block == block_count - 1 && len % WIDE_HASH_BLOCK_SIZE != 0)
+    {
+      tail.fill(0);
+      std::memcpy(tail.data(), data_ptr, len % WIDE_HASH_BLOCK_SIZE);
+      data_ptr = tail.data();
+    }
+
+    WideHashAccumulateAVX2(acc0, key0, data_ptr);
+    WideHashAccumulateAVX2(acc1, key1, data_ptr + 32);
+    WideHashAccumulateAVX2(acc2, key2, data_ptr + 64);
+    WideHashAccumulateAVX2(acc3, key3, data_ptr + 96);
+
+    if ((block + 1) % WIDE_HASH_SCRAMBLE_INTERVAL == 0)
+    {
+      WideHashScrambleAVX2(acc0, 0);
+      WideHashScrambleAVX2(acc1, 1);
+      WideHashScrambleAVX2(acc2, 2);
+      WideHashScrambleAVX2(acc3, 3);
+    }
+  }
+
+  alignas(32) std::array<u64, WIDE_HASH_LANES> lanes;
+  __m256i* const lanes_ptr = reinterpret_cast<__m256i*>(lanes.data());
+  _mm256_store_si256(lanes_ptr + 0, acc0);
+  _mm256_store_si256(lanes_ptr + 1, acc1);
+  _mm256_store_si256(lanes_ptr + 2, acc2);
+  _mm256_store_si256(lanes_ptr + 3, acc3);
+
+  return FinalizeWideHash(lanes, len);
+}
+
+#elif defined(_M_ARM_64)
+
+// The lanes are kept in separate variables, since compilers fail to keep arrays of them in
+// registers
+
+static DOLPHIN_FORCE_INLINE void WideHashAccumulateNEON(uint64x2_t& acc, uint64x2_t& key,
+                                                         const u8* data_ptr)
+{
+  const uint64x2_t data = vreinterpretq_u64_u8(vld1q_u8(data_ptr));
+  const uint64x2_t data_key = veorq_u64(data, key);
+  acc = vaddq_u64(acc, vextq_u64(data, data, 1));
+  acc = vmlal_u32(acc, vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+  key = vaddq_u64(key, vdupq_n_u64(WIDE_HASH_KEY_STEP));
+}
+
+static DOLPHIN_FORCE_INLINE void WideHashScrambleNEON(uint64x2_t& acc, int index)
+{
+  const uint64x2_t key = vld1q_u64(WIDE_HASH_KEYS.data() + index * 2);
+  const uint32x2_t prime = vdup_n_u32(WIDE_HASH_SCRAMBLE_PRIME);
+  const uint64x2_t scrambled = veorq_u64(veorq_u64(acc, vshrq_n_u64(acc, 47)), key);
+  const uint64x2_t product_high = vmull_u32(vshrn_n_u64(scrambled, 32), prime);
+  acc = vmlal_u32(vshlq_n_u64(product_high, 32), vmovn_u64(scrambled), prime);
+}
+
+static u64 GetHash64_ARMv8_NEON(const u8* src, u32 len, u32 samples)
+{
+  if (!UseWideHash(len, samples))
+    return GetHash64_ARMv8_CRC32(src, len, samples);
+
+  const u64* const keys = WIDE_HASH_KEYS.data();
+  uint64x2_t acc0 = vdupq_n_u64(0);
+  uint64x2_t acc1 = vdupq_n_u64(0);
+  uint64x2_t acc2 = vdupq_n_u64(0);
+  uint64x2_t acc3 = vdupq_n_u64(0);
+  uint64x2_t acc4 = vdupq_n_u64(0);
+  uint64x2_t acc5 = vdupq_n_u64(0);
+  uint64x2_t acc6 = vdupq_n_u64(0);
+  uint64x2_t acc7 = vdupq_n_u64(0);
+  uint64x2_t key0 = vld1q_u64(keys + 0);
+  uint64x2_t key1 = vld1q_u64(keys + 2);
+  uint64x2_t key2 = vld1q_u64(keys + 4);
+  uint64x2_t key3 = vld1q_u64(keys + 6);
+  uint64x2_t key4 = vld1q_u64(keys + 8);
+  uint64x2_t key5 = vld1q_u64(keys + 10);
+  uint64x2_t key6 = vld1q_u64(keys + 12);
+  uint64x2_t key7 = vld1q_u64(keys + 14);
+
+  // The last block is padded with zeroes. They can't be confused with data since the length gets
+  // hashed as well.
+  std::array<u8, WIDE_HASH_BLOCK_SIZE> tail;
+  const u32 block_count = (len + WIDE_HASH_BLOCK_SIZE - 1) / WIDE_HASH_BLOCK_SIZE;
+  for (u32 block = 0; block < block_count; ++block)
+  {
+    const u8* data_ptr = src + block * WIDE_HASH_BLOCK_SIZE;
+    if (block == block_count - 1 && len % WIDE_HASH_BLOCK_SIZE != 0)
+    {
+      tail.fill(0);
+      std::memcpy(tail.data(), data_ptr, len % WIDE_HASH_BLOCK_SIZE);
+      data_ptr = tail.data();
+    }
+
+    WideHashAccumulateNEON(acc0, key0, data_ptr);
+    WideHashAccumulateNEON(acc1, key1, data_ptr + 16);
+    WideHashAccumulateNEON(acc2, key2, data_ptr + 32);
+    WideHashAccumulateNEON(acc3, key3, data_ptr + 48);
+    WideHashAccumulateNEON(acc4, key4, data_ptr + 64);
+    WideHashAccumulateNEON(acc5, key5, data_ptr + 80);
+    WideHashAccumulateNEON(acc6, key6, data_ptr + 96);
+    WideHashAccumulateNEON(acc7, key7, data_ptr + 112);
+
+    if ((block + 1) % WIDE_HASH_SCRAMBLE_INTERVAL == 0)
+    {
+      WideHashScrambleNEON(acc0, 0);
+      WideHashScrambleNEON(acc1, 1);
+      WideHashScrambleNEON(acc2, 2);
+      WideHashScrambleNEON(acc3, 3);
+      WideHashScrambleNEON(acc4, 4);
+      WideHashScrambleNEON(acc5, 5);
+      WideHashScrambleNEON(acc6, 6);
+      WideHashScrambleNEON(acc7, 7);
+    }
+  }
+
+  std::array<u64, WIDE_HASH_LANES> lanes;
+  vst1q_u64(lanes.data() + 0, acc0);
+  vst1q_u64(lanes.data() + 2, acc1);
+  vst1q_u64(lanes.data() + 4, acc2);
+  vst1q_u64(lanes.data() + 6, acc3);
+  vst1q_u64(lanes.data() + 8, acc4);
+  vst1q_u64(lanes.data() + 10, acc5);
+  vst1q_u64(lanes.data() + 12, acc6);
+  vst1q_u64(lanes.data() + 14, acc7);
+
+  return FinalizeWideHash(lanes, len);
+}
+
+#endif
+
 using TextureHashFunction = u64 (*)(const u8* src, u32 len, u32 samples);
 static u64 SetHash64Function(const u8* src, u32 len, u32 samples);
 static TextureHashFunction s_texture_hash_func = SetHash64Function;
@@ -433,10 +675,15 @@ static u64 SetHash64Function(const u8* src, u32 len, u32 samples)
 {
   if (cpu_info.bCRC32)
   {
-#if defined(_M_X86_64) || defined(_M_X86)
+#if defined(_M_X86_64)
+    if (cpu_info.bAVX2)
+      s_texture_hash_func = &GetHash64_AVX2;
+    else
+      s_texture_hash_func = &GetHash64_SSE42_CRC32;
+#elif defined(_M_X86)
     s_texture_hash_func = &GetHash64_SSE42_CRC32;
 #elif defined(_M_ARM_64)
-    s_texture_hash_func = &GetHash64_ARMv8_CRC32;
+    s_texture_hash_func = &GetHash64_ARMv8_NEON;
 #endif
   }
   else
@@ -451,6 +698,11 @@ u64 GetHash64(const u8* src, u32 len, u32 samples)
   return s_texture_hash_func(src, len, samples);
 }
 
+u64 GetStableHash64(const u8* src, u32 len)
+{
+  return GetMurmurHash3(src, len, 0);
+}
+
 u32 StartCRC32()
 {
   return crc32_z(0L, Z_NULL, 0);
@@ -14,8 +14,13 @@ u32 HashAdler32(const u8* data, size_t len);
 // JUNK. DO NOT USE FOR NEW THINGS
 u32 HashEctor(const u8* data, size_t len);
 
-// Specialized hash function used for the texture cache
+// Specialized hash function used for the texture cache. If samples isn't 0, only about that many
+// 8-byte words spread over the data are hashed. The result depends on the CPU features of the
+// host, so it must not be stored anywhere it could be read back by another machine or build.
 u64 GetHash64(const u8* src, u32 len, u32 samples);
+// Hashes all of the data, with a result that is the same on every host. Use this for anything
+// that is written to disk.
+u64 GetStableHash64(const u8* src, u32 len);
 
 u32 StartCRC32();
 u32 UpdateCRC32(u32 crc, const u8* data, size_t len);
@@ -39,6 +39,9 @@
 #ifndef __SSE3__
 #define FUNCTION_TARGET_SSE3 [[gnu::target("sse3")]]
 #endif
+#ifndef __AVX2__
+#define FUNCTION_TARGET_AVX2 [[gnu::target("avx2")]]
+#endif
 
 #elif defined(_MSC_VER) || defined(__INTEL_COMPILER)
 
@@ -69,3 +72,6 @@
 #ifndef FUNCTION_TARGET_SSE3
 #define FUNCTION_TARGET_SSE3
 #endif
+#ifndef FUNCTION_TARGET_AVX2
+#define FUNCTION_TARGET_AVX2
+#endif
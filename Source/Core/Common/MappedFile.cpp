@@ -0,0 +1,195 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sys/vfs.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#include <sys/mount.h>
+#include <sys/param.h>
+#endif
+#endif
+
+#include "Common/CommonFuncs.h"
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace File
+{
+// Reading a file on a network share or a removable drive can fail at any moment, which is
+// reported as an error by read() but is fatal when the file is mapped. Note that on Linux, only
+// network filesystems and optical discs can be told apart from fixed disks here.
+static bool IsOnLocalFixedDisk(IOFile& file)
+{
+#ifdef _WIN32
+  const HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file.GetHandle())));
+  if (file_handle == INVALID_HANDLE_VALUE)
+    return false;
+
+  // Files on network shares don't have a volume GUID path, so this fails for them
+  std::wstring path(MAX_PATH, L'\0');
+  DWORD length = GetFinalPathNameByHandleW(file_handle, path.data(),
+                                           static_cast<DWORD>(path.size()), VOLUME_NAME_GUID);
+  if (length >= path.size())
+  {
+    path.resize(length);
+    length = GetFinalPathNameByHandleW(file_handle, path.data(), static_cast<DWORD>(path.size()),
+                                       VOLUME_NAME_GUID);
+  }
+  if (length == 0 || length >= path.size())
+    return false;
+
+  // The path starts with \\?\Volume{GUID}\, which is what GetDriveType wants
+  const size_t volume_end = path.find(L'\\', 4);
+  if (volume_end == std::wstring::npos)
+    return false;
+  path.resize(volume_end + 1);
+
+  return GetDriveTypeW(path.c_str()) == DRIVE_FIXED;
+#elif defined(__linux__) || defined(__ANDROID__)
+  struct statfs info;
+  if (fstatfs(fileno(file.GetHandle()), &info) != 0)
+    return false;
+
+  switch (static_cast<u32>(info.f_type))
+  {
+  case 0x6969:      // NFS
+  case 0x517B:      // SMB
+  case 0xFF534D42:  // CIFS
+  case 0xFE534D42:  // SMB2
+  case 0x65735546:  // FUSE (includes sshfs and most network and removable media helpers)
+  case 0x01021997:  // 9P
+  case 0x5346414F:  // AFS
+  case 0x00C36400:  // Ceph
+  case 0x73757245:  // Coda
+  case 0x9660:      // ISO 9660 (optical discs)
+  case 0x15013346:  // UDF (optical discs)
+    return false;
+  default:
+    return true;
+  }
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+  struct statfs info;
+  if (fstatfs(fileno(file.GetHandle()), &info) != 0)
+    return false;
+
+  return (info.f_flags & MNT_LOCAL) != 0;
+#else
+  return false;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+  Unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+  std::swap(m_data, other.m_data);
+  std::swap(m_size, other.m_size);
+  return *this;
+}
+
+bool MappedFile::Map(IOFile& file)
+{
+  Unmap();
+
+  if (!file.IsOpen())
+    return false;
+
+  const u64 size = file.GetSize();
+  if (size == 0 || size != static_cast<size_t>(size))
+    return false;
+
+  if (!IsOnLocalFixedDisk(file))
+    return false;
+
+#ifdef _WIN32
+  const HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file.GetHandle())));
+  if (file_handle == INVALID_HANDLE_VALUE)
+    return false;
+
+  const HANDLE mapping = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping)
+  {
+    WARN_LOG_FMT(COMMON, "CreateFileMapping failed: {}", Common::GetLastErrorString());
+    return false;
+  }
+
+  // The view keeps the mapping object alive
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if (!data)
+  {
+    WARN_LOG_FMT(COMMON, "MapViewOfFile failed: {}", Common::GetLastErrorString());
+    return false;
+  }
+#else
+  void* data = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED,
+                    fileno(file.GetHandle()), 0);
+  if (data == MAP_FAILED)
+  {
+    WARN_LOG_FMT(COMMON, "mmap failed: {}", Common::LastStrerrorString());
+    return false;
+  }
+#endif
+
+  m_data = static_cast<const u8*>(data);
+  m_size = size;
+  return true;
+}
+
+void MappedFile::Unmap()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+#else
+  munmap(const_cast<u8*>(m_data), static_cast<size_t>(m_size));
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+
+void MappedFile::Prefetch(u64 offset, u64 size) const
+{
+  if (offset >= m_size)
+    return;
+  size = std::min(size, m_size - offset);
+
+#ifdef _WIN32
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = const_cast<u8*>(m_data + offset);
+  range.NumberOfBytes = static_cast<size_t>(size);
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+  // The address passed to madvise must be page aligned
+  static const u64 page_size = static_cast<u64>(sysconf(_SC_PAGESIZE));
+  const u64 misalignment = offset % page_size;
+  madvise(const_cast<u8*>(m_data + offset - misalignment),
+          static_cast<size_t>(size + misalignment), MADV_WILLNEED);
+#endif
+}
+}  // namespace File
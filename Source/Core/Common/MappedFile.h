@@ -0,0 +1,46 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class IOFile;
+
+// A read-only memory mapping of a whole file. Reading from the mapping avoids a seek and a read
+// call per access, and processes which map the same file share its pages in the page cache.
+// Note that if the file can't be read (for instance because of a bad sector), accessing the mapping
+// raises a signal (or a structured exception on Windows) instead of reporting an error. Because of
+// that, only files on local fixed disks are mapped, and callers should make mapping opt-in.
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  // Maps the whole file which is open in the given IOFile. The IOFile can be closed afterwards.
+  // Returns false if the file couldn't be mapped or isn't on a local fixed disk, in which case it
+  // should be read normally.
+  bool Map(IOFile& file);
+  void Unmap();
+
+  bool IsMapped() const { return m_data != nullptr; }
+  const u8* GetData() const { return m_data; }
+  u64 GetSize() const { return m_size; }
+
+  // Asks the OS to start reading the given range into memory in the background.
+  void Prefetch(u64 offset, u64 size) const;
+
+private:
+  const u8* m_data = nullptr;
+  u64 m_size = 0;
+};
+}  // namespace File
@@ -0,0 +1,101 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/ThreadPool.h"
+
+#include <utility>
+
+#include "Common/Thread.h"
+
+namespace Common
+{
+ThreadPool::~ThreadPool()
+{
+  Stop();
+}
+
+void ThreadPool::Start(u32 num_workers, std::string name)
+{
+  Stop();
+
+  m_name = std::move(name);
+  m_exit = false;
+  m_generation = 0;
+  for (u32 i = 0; i < num_workers; i++)
+    m_workers.emplace_back(&ThreadPool::WorkerThread, this);
+}
+
+void ThreadPool::Stop()
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_exit = true;
+  }
+  m_work_available.notify_all();
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+  m_workers.clear();
+}
+
+void ThreadPool::ParallelFor(u32 count, const std::function<void(u32)>& func)
+{
+  if (count == 0)
+    return;
+
+  if (m_workers.empty() || count == 1)
+  {
+    for (u32 i = 0; i < count; i++)
+      func(i);
+    return;
+  }
+
+  {
+    std::lock_guard lk(m_mutex);
+    m_func = &func;
+    m_count = count;
+    m_next_index.store(0, std::memory_order_relaxed);
+    m_busy_workers = GetNumWorkers();
+    m_generation++;
+  }
+  m_work_available.notify_all();
+
+  RunTasks();
+
+  std::unique_lock lk(m_mutex);
+  m_work_done.wait(lk, [this] { return m_busy_workers == 0; });
+  m_func = nullptr;
+}
+
+void ThreadPool::RunTasks()
+{
+  for (u32 i = m_next_index.fetch_add(1, std::memory_order_relaxed); i < m_count;
+       i = m_next_index.fetch_add(1, std::memory_order_relaxed))
+  {
+    (*m_func)(i);
+  }
+}
+
+void ThreadPool::WorkerThread()
+{
+  SetCurrentThreadName(m_name.c_str());
+
+  u64 generation = 0;
+  while (true)
+  {
+    {
+      std::unique_lock lk(m_mutex);
+      m_work_available.wait(lk, [&] { return m_exit || m_generation != generation; });
+      if (m_exit)
+        return;
+      generation = m_generation;
+    }
+
+    RunTasks();
+
+    std::lock_guard lk(m_mutex);
+    if (--m_busy_workers == 0)
+      m_work_done.notify_one();
+  }
+}
+}  // namespace Common
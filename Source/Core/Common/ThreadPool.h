@@ -0,0 +1,58 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// A fixed set of worker threads for splitting a piece of work into independent tasks. The thread
+// which submits the tasks runs them as well, and waits until all of them are done.
+
+namespace Common
+{
+class ThreadPool
+{
+public:
+  ThreadPool() = default;
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ~ThreadPool();
+
+  // Stops the current workers (if any) and starts the given number of new ones. With zero
+  // workers, all tasks are run by the submitting thread.
+  void Start(u32 num_workers, std::string name);
+  void Stop();
+
+  u32 GetNumWorkers() const { return static_cast<u32>(m_workers.size()); }
+
+  // Calls func for every index in [0, count) and returns once all calls have finished. The calls
+  // may happen in any order and on any thread. Must not be called from multiple threads at once.
+  void ParallelFor(u32 count, const std::function<void(u32)>& func);
+
+private:
+  void WorkerThread();
+  void RunTasks();
+
+  std::vector<std::thread> m_workers;
+  std::string m_name;
+
+  std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_work_done;
+  u64 m_generation = 0;
+  u32 m_busy_workers = 0;
+  bool m_exit = false;
+
+  const std::function<void(u32)>* m_func = nullptr;
+  u32 m_count = 0;
+  std::atomic<u32> m_next_index = 0;
+};
+}  // namespace Common
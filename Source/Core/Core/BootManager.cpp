@@ -49,6 +49,7 @@
 #include "Core/WiiRoot.h"
 
 #include "DiscIO/Enums.h"
+#include "DiscIO/SharedChunkCache.h"
 
 #include "VideoCommon/VideoBackendBase.h"
 
@@ -142,6 +143,11 @@ bool BootCore(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
   if (!boot->riivolution_patches.empty())
     Config::SetCurrent(Config::MAIN_FAST_DISC_SPEED, true);
 
+  // Lets other Dolphin instances that run the same disc image reuse the data this one decompresses
+  DiscIO::SharedChunkCache::Configure(
+      static_cast<u64>(std::max(Config::Get(Config::MAIN_SHARED_DISC_CACHE_SIZE), 0)) * 1024 *
+      1024);
+
   Core::System::GetInstance().Initialize();
 
   Core::UpdateWantDeterminism(/*initial*/ true);
@@ -46,6 +46,12 @@ const Info<bool> GFX_DUMP_MIP_TEXTURES{{System::GFX, "Settings", "DumpMipTexture
 const Info<bool> GFX_DUMP_BASE_TEXTURES{{System::GFX, "Settings", "DumpBaseTextures"}, true};
 const Info<bool> GFX_HIRES_TEXTURES{{System::GFX, "Settings", "HiresTextures"}, false};
 const Info<bool> GFX_CACHE_HIRES_TEXTURES{{System::GFX, "Settings", "CacheHiresTextures"}, false};
+const Info<int> GFX_HIRES_TEXTURES_CACHE_SIZE{{System::GFX, "Settings", "HiresTexturesCacheSize"},
+                                              0};
+const Info<bool> GFX_HIRES_TEXTURES_DISK_CACHE{
+    {System::GFX, "Settings", "HiresTexturesDiskCache"}, false};
+const Info<bool> GFX_HIRES_TEXTURES_DISK_CACHE_COMPRESSION{
+    {System::GFX, "Settings", "HiresTexturesDiskCacheCompression"}, false};
 const Info<bool> GFX_DUMP_EFB_TARGET{{System::GFX, "Settings", "DumpEFBTarget"}, false};
 const Info<bool> GFX_DUMP_XFB_TARGET{{System::GFX, "Settings", "DumpXFBTarget"}, false};
 const Info<bool> GFX_DUMP_FRAMES_AS_IMAGES{{System::GFX, "Settings", "DumpFramesAsImages"}, false};
@@ -104,6 +110,7 @@ const Info<bool> GFX_SW_DUMP_OBJECTS{{System::GFX, "Settings", "SWDumpObjects"},
 const Info<bool> GFX_SW_DUMP_TEV_STAGES{{System::GFX, "Settings", "SWDumpTevStages"}, false};
 const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES{{System::GFX, "Settings", "SWDumpTevTexFetches"},
                                              false};
+const Info<int> GFX_SW_RASTERIZER_THREADS{{System::GFX, "Settings", "SWRasterizerThreads"}, 1};
 
 const Info<bool> GFX_PREFER_GLES{{System::GFX, "Settings", "PreferGLES"}, false};
 
@@ -48,6 +48,9 @@ extern const Info<bool> GFX_DUMP_MIP_TEXTURES;
 extern const Info<bool> GFX_DUMP_BASE_TEXTURES;
 extern const Info<bool> GFX_HIRES_TEXTURES;
 extern const Info<bool> GFX_CACHE_HIRES_TEXTURES;
+extern const Info<int> GFX_HIRES_TEXTURES_CACHE_SIZE;
+extern const Info<bool> GFX_HIRES_TEXTURES_DISK_CACHE;
+extern const Info<bool> GFX_HIRES_TEXTURES_DISK_CACHE_COMPRESSION;
 extern const Info<bool> GFX_DUMP_EFB_TARGET;
 extern const Info<bool> GFX_DUMP_XFB_TARGET;
 extern const Info<bool> GFX_DUMP_FRAMES_AS_IMAGES;
@@ -90,6 +93,7 @@ extern const Info<TriState> GFX_MTL_USE_PRESENT_DRAWABLE;
 extern const Info<bool> GFX_SW_DUMP_OBJECTS;
 extern const Info<bool> GFX_SW_DUMP_TEV_STAGES;
 extern const Info<bool> GFX_SW_DUMP_TEV_TEX_FETCHES;
+extern const Info<int> GFX_SW_RASTERIZER_THREADS;
 
 extern const Info<bool> GFX_PREFER_GLES;
 
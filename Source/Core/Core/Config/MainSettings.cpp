@@ -36,6 +36,9 @@ const Info<bool> MAIN_SKIP_IPL{{System::Main, "Core", "SkipIPL"}, true};
 const Info<PowerPC::CPUCore> MAIN_CPU_CORE{{System::Main, "Core", "CPUCore"},
                                            PowerPC::DefaultCPUCore()};
 const Info<bool> MAIN_JIT_FOLLOW_BRANCH{{System::Main, "Core", "JITFollowBranch"}, true};
+const Info<bool> MAIN_JIT_PERSISTENT_CACHE{{System::Main, "Core", "JITPersistentCache"}, false};
+const Info<bool> MAIN_JIT_TIERED_COMPILATION{{System::Main, "Core", "JITTieredCompilation"},
+                                             false};
 const Info<bool> MAIN_FASTMEM{{System::Main, "Core", "Fastmem"}, true};
 const Info<bool> MAIN_ACCURATE_CPU_CACHE{{System::Main, "Core", "AccurateCPUCache"}, false};
 const Info<bool> MAIN_DSP_HLE{{System::Main, "Core", "DSPHLE"}, true};
@@ -189,6 +192,11 @@ const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE{{System::Main, "Core", "SyncGpuMaxDis
 const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE{{System::Main, "Core", "SyncGpuMinDistance"}, -200000};
 const Info<float> MAIN_SYNC_GPU_OVERCLOCK{{System::Main, "Core", "SyncGpuOverclock"}, 1.0f};
 const Info<bool> MAIN_FAST_DISC_SPEED{{System::Main, "Core", "FastDiscSpeed"}, false};
+const Info<bool> MAIN_DISC_PREFETCH{{System::Main, "Core", "DiscPrefetch"}, false};
+const Info<int> MAIN_SHARED_DISC_CACHE_SIZE{{System::Main, "Core", "SharedDiscCacheSize"}, 0};
+const Info<bool> MAIN_MEMORY_MAPPED_DISC_READS{{System::Main, "Core", "MemoryMappedDiscReads"},
+                                              false};
+const Info<int> MAIN_DISC_CHUNK_CACHE_SIZE{{System::Main, "Core", "DiscChunkCacheSize"}, 16};
 const Info<bool> MAIN_LOW_DCBZ_HACK{{System::Main, "Core", "LowDCBZHack"}, false};
 const Info<bool> MAIN_FLOAT_EXCEPTIONS{{System::Main, "Core", "FloatExceptions"}, false};
 const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS{{System::Main, "Core", "DivByZeroExceptions"},
@@ -237,6 +245,12 @@ const Info<DiscIO::Region> MAIN_FALLBACK_REGION{{System::Main, "Core", "Fallback
 const Info<bool> MAIN_AUTO_DISC_CHANGE{{System::Main, "Core", "AutoDiscChange"}, false};
 const Info<bool> MAIN_ALLOW_SD_WRITES{{System::Main, "Core", "WiiSDCardAllowWrites"}, true};
 const Info<bool> MAIN_ENABLE_SAVESTATES{{System::Main, "Core", "EnableSaveStates"}, false};
+const Info<bool> MAIN_REWIND_ENABLED{{System::Main, "Core", "RewindEnabled"}, false};
+// Number of frames between two rewind snapshots
+const Info<u32> MAIN_REWIND_FRAME_INTERVAL{{System::Main, "Core", "RewindFrameInterval"}, 30};
+const Info<u32> MAIN_REWIND_MEMORY_BUDGET_MB{{System::Main, "Core", "RewindMemoryBudgetMB"}, 512};
+// Lets rewind snapshots only contain the memory pages written to since the last keyframe
+const Info<bool> MAIN_MEMORY_WRITE_TRACKING{{System::Main, "Core", "MemoryWriteTracking"}, false};
 const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS{
     {System::Main, "Core", "RealWiiRemoteRepeatReports"}, true};
 
@@ -54,6 +54,8 @@ namespace Config
 extern const Info<bool> MAIN_SKIP_IPL;
 extern const Info<PowerPC::CPUCore> MAIN_CPU_CORE;
 extern const Info<bool> MAIN_JIT_FOLLOW_BRANCH;
+extern const Info<bool> MAIN_JIT_PERSISTENT_CACHE;
+extern const Info<bool> MAIN_JIT_TIERED_COMPILATION;
 extern const Info<bool> MAIN_FASTMEM;
 extern const Info<bool> MAIN_ACCURATE_CPU_CACHE;
 // Should really be in the DSP section, but we're kind of stuck with bad decisions made in the past.
@@ -110,6 +112,12 @@ extern const Info<int> MAIN_SYNC_GPU_MAX_DISTANCE;
 extern const Info<int> MAIN_SYNC_GPU_MIN_DISTANCE;
 extern const Info<float> MAIN_SYNC_GPU_OVERCLOCK;
 extern const Info<bool> MAIN_FAST_DISC_SPEED;
+extern const Info<bool> MAIN_DISC_PREFETCH;
+// In MiB. 0 disables the cache.
+extern const Info<int> MAIN_SHARED_DISC_CACHE_SIZE;
+extern const Info<bool> MAIN_MEMORY_MAPPED_DISC_READS;
+// In MiB. How much decompressed data WIA and RVZ images keep in memory.
+extern const Info<int> MAIN_DISC_CHUNK_CACHE_SIZE;
 extern const Info<bool> MAIN_LOW_DCBZ_HACK;
 extern const Info<bool> MAIN_FLOAT_EXCEPTIONS;
 extern const Info<bool> MAIN_DIVIDE_BY_ZERO_EXCEPTIONS;
@@ -144,6 +152,10 @@ extern const Info<u32> MAIN_CUSTOM_RTC_VALUE;
 extern const Info<bool> MAIN_AUTO_DISC_CHANGE;
 extern const Info<bool> MAIN_ALLOW_SD_WRITES;
 extern const Info<bool> MAIN_ENABLE_SAVESTATES;
+extern const Info<bool> MAIN_REWIND_ENABLED;
+extern const Info<u32> MAIN_REWIND_FRAME_INTERVAL;
+extern const Info<u32> MAIN_REWIND_MEMORY_BUDGET_MB;
+extern const Info<bool> MAIN_MEMORY_WRITE_TRACKING;
 extern const Info<DiscIO::Region> MAIN_FALLBACK_REGION;
 extern const Info<bool> MAIN_REAL_WII_REMOTE_REPEAT_REPORTS;
 extern const Info<s32> MAIN_OVERRIDE_BOOT_IOS;
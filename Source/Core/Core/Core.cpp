@@ -56,6 +56,7 @@
 #include "Core/HW/GCKeyboard.h"
 #include "Core/HW/GCPad.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
@@ -70,6 +71,7 @@
 #include "Core/PowerPC/JitInterface.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/State.h"
+#include "Core/StateRewind.h"
 #include "Core/System.h"
 #include "Core/WiiRoot.h"
 
@@ -114,6 +116,7 @@ static bool s_is_throttler_temp_disabled = false;
 static std::atomic<double> s_last_actual_emulation_speed{1.0};
 static bool s_frame_step = false;
 static std::atomic<bool> s_stop_frame_step;
+static bool s_write_tracking_unavailable = false;
 
 #ifdef USE_MEMORYWATCHER
 static std::unique_ptr<MemoryWatcher> s_memory_watcher;
@@ -159,10 +162,34 @@ double GetActualEmulationSpeed()
   return s_last_actual_emulation_speed;
 }
 
+// Write tracking is used by the rewind buffer for incremental snapshots and by the texture cache
+// to skip hashing textures in memory that wasn't written to
+static void UpdateMemoryWriteTracking()
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+  if (!Config::Get(Config::MAIN_MEMORY_WRITE_TRACKING))
+  {
+    memory.DisableWriteTracking();
+    return;
+  }
+
+  if (!memory.IsWriteTrackingEnabled() && !s_write_tracking_unavailable &&
+      !memory.EnableWriteTracking())
+  {
+    WARN_LOG_FMT(CORE, "Memory write tracking is unavailable with the current settings");
+    s_write_tracking_unavailable = true;
+  }
+
+  memory.UpdateWriteGenerations();
+}
+
 void FrameUpdateOnCPUThread()
 {
   if (NetPlay::IsNetPlayRunning())
     NetPlay::NetPlayClient::SendTimeBase();
+
+  UpdateMemoryWriteTracking();
+  ::State::RewindFrameUpdate();
 }
 
 void OnFrameEnd()
@@ -248,6 +275,8 @@ bool Init(std::unique_ptr<BootParameters> boot, const WindowSystemInfo& wsi)
   // Drain any left over jobs
   HostDispatchJobs();
 
+  s_write_tracking_unavailable = false;
+
   INFO_LOG_FMT(BOOT, "Starting core = {} mode", SConfig::GetInstance().bWii ? "Wii" : "GameCube");
   INFO_LOG_FMT(BOOT, "CPU Thread separate = {}",
                Core::System::GetInstance().IsDualCoreMode() ? "Yes" : "No");
@@ -29,10 +29,6 @@
 namespace CoreTiming
 {
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
-static bool operator>(const Event& left, const Event& right)
-{
-  return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-}
 static bool operator<(const Event& left, const Event& right)
 {
   return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
@@ -40,6 +36,196 @@ static bool operator<(const Event& left, const Event& right)
 
 static constexpr int MAX_SLICE_LENGTH = 20000;
 
+bool EventQueue::Less(u32 a, u32 b) const
+{
+  return m_nodes[a].event < m_nodes[b].event;
+}
+
+// Makes the root with the later event the leftmost child of the other one.
+u32 EventQueue::Meld(u32 a, u32 b)
+{
+  if (a == INVALID_INDEX)
+    return b;
+  if (b == INVALID_INDEX)
+    return a;
+
+  if (Less(b, a))
+    std::swap(a, b);
+
+  Node& parent = m_nodes[a];
+  Node& child = m_nodes[b];
+  child.sibling = parent.child;
+  if (child.sibling != INVALID_INDEX)
+    m_nodes[child.sibling].prev = b;
+  child.prev = a;
+  parent.child = b;
+  return a;
+}
+
+// Melds a list of siblings into a single heap using the standard two-pass pairing.
+u32 EventQueue::MergePairs(u32 first)
+{
+  if (first == INVALID_INDEX)
+    return INVALID_INDEX;
+
+  m_merge_scratch.clear();
+  u32 current = first;
+  while (current != INVALID_INDEX)
+  {
+    const u32 a = current;
+    const u32 b = m_nodes[a].sibling;
+    current = b != INVALID_INDEX ? m_nodes[b].sibling : INVALID_INDEX;
+
+    m_nodes[a].sibling = m_nodes[a].prev = INVALID_INDEX;
+    if (b != INVALID_INDEX)
+      m_nodes[b].sibling = m_nodes[b].prev = INVALID_INDEX;
+
+    m_merge_scratch.push_back(Meld(a, b));
+  }
+
+  u32 result = m_merge_scratch.back();
+  for (size_t i = m_merge_scratch.size() - 1; i-- > 0;)
+    result = Meld(m_merge_scratch[i], result);
+  return result;
+}
+
+// Takes a node out of the heap, keeping its children in the heap.
+void EventQueue::Detach(u32 index)
+{
+  Node& node = m_nodes[index];
+  const u32 children = node.child;
+  node.child = INVALID_INDEX;
+
+  if (index == m_root)
+  {
+    m_root = MergePairs(children);
+    return;
+  }
+
+  Node& prev = m_nodes[node.prev];
+  if (prev.child == index)
+    prev.child = node.sibling;
+  else
+    prev.sibling = node.sibling;
+  if (node.sibling != INVALID_INDEX)
+    m_nodes[node.sibling].prev = node.prev;
+  node.sibling = node.prev = INVALID_INDEX;
+
+  const u32 subtree = MergePairs(children);
+  m_root = Meld(m_root, subtree);
+}
+
+void EventQueue::UnlinkFromType(u32 index)
+{
+  Node& node = m_nodes[index];
+  if (node.type_prev != INVALID_INDEX)
+    m_nodes[node.type_prev].type_next = node.type_next;
+  else
+    node.event.type->first_queued_event = node.type_next;
+  if (node.type_next != INVALID_INDEX)
+    m_nodes[node.type_next].type_prev = node.type_prev;
+  node.type_prev = node.type_next = INVALID_INDEX;
+}
+
+void EventQueue::FreeNode(u32 index)
+{
+  Node& node = m_nodes[index];
+  node.event.type = nullptr;
+  node.sibling = m_free_list;
+  m_free_list = index;
+  --m_size;
+}
+
+void EventQueue::Push(const Event& event)
+{
+  u32 index;
+  if (m_free_list != INVALID_INDEX)
+  {
+    index = m_free_list;
+    m_free_list = m_nodes[index].sibling;
+    m_nodes[index] = Node{};
+  }
+  else
+  {
+    index = static_cast<u32>(m_nodes.size());
+    m_nodes.emplace_back();
+  }
+
+  Node& node = m_nodes[index];
+  node.event = event;
+  node.type_next = event.type->first_queued_event;
+  if (node.type_next != INVALID_INDEX)
+    m_nodes[node.type_next].type_prev = index;
+  event.type->first_queued_event = index;
+
+  ++m_size;
+  m_root = Meld(m_root, index);
+}
+
+Event EventQueue::Pop()
+{
+  const u32 index = m_root;
+  const Event event = m_nodes[index].event;
+  UnlinkFromType(index);
+  Detach(index);
+  FreeNode(index);
+  return event;
+}
+
+void EventQueue::RemoveAll(EventType* event_type)
+{
+  u32 index = event_type->first_queued_event;
+  while (index != INVALID_INDEX)
+  {
+    const u32 next = m_nodes[index].type_next;
+    Detach(index);
+    FreeNode(index);
+    index = next;
+  }
+  event_type->first_queued_event = INVALID_INDEX;
+}
+
+void EventQueue::Clear()
+{
+  for (const Node& node : m_nodes)
+  {
+    if (node.event.type)
+      node.event.type->first_queued_event = INVALID_INDEX;
+  }
+  m_nodes.clear();
+  m_root = INVALID_INDEX;
+  m_free_list = INVALID_INDEX;
+  m_size = 0;
+}
+
+std::vector<Event> EventQueue::GetSortedEvents() const
+{
+  std::vector<Event> events;
+  events.reserve(m_size);
+  for (const Node& node : m_nodes)
+  {
+    if (node.event.type)
+      events.push_back(node.event);
+  }
+  std::sort(events.begin(), events.end());
+  return events;
+}
+
+void EventQueue::Rebuild()
+{
+  m_root = INVALID_INDEX;
+  for (Node& node : m_nodes)
+    node.child = node.prev = INVALID_INDEX;
+
+  for (u32 i = 0; i < m_nodes.size(); ++i)
+  {
+    if (!m_nodes[i].event.type)
+      continue;
+    m_nodes[i].sibling = INVALID_INDEX;
+    m_root = Meld(m_root, i);
+  }
+}
+
 static void EmptyTimedCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
 }
@@ -82,7 +268,7 @@ EventType* CoreTimingManager::RegisterEvent(const std::string& name, TimedCallba
 
 void CoreTimingManager::UnregisterAllEvents()
 {
-  ASSERT_MSG(POWERPC, m_event_queue.empty(), "Cannot unregister events with events pending");
+  ASSERT_MSG(POWERPC, m_event_queue.Empty(), "Cannot unregister events with events pending");
   m_event_types.clear();
 }
 
@@ -146,7 +332,10 @@ void CoreTimingManager::DoState(PointerWrap& p)
   p.DoMarker("CoreTimingData");
 
   MoveEvents();
-  p.DoEachElement(m_event_queue, [this](PointerWrap& pw, Event& ev) {
+  std::vector<Event> events;
+  if (!p.IsReadMode())
+    events = m_event_queue.GetSortedEvents();
+  p.DoEachElement(events, [this](PointerWrap& pw, Event& ev) {
     pw.Do(ev.time);
     pw.Do(ev.fifo_order);
 
@@ -182,9 +371,10 @@ void CoreTimingManager::DoState(PointerWrap& p)
   if (p.IsReadMode())
   {
     // When loading from a save state, we must assume the Event order is random and meaningless.
-    // The exact layout of the heap in memory is implementation defined, therefore it is platform
-    // and library version specific.
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    // Older savestates stored the raw std::make_heap layout, which is implementation defined.
+    m_event_queue.Clear();
+    for (const Event& ev : events)
+      m_event_queue.Push(ev);
 
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
@@ -212,7 +402,7 @@ u64 CoreTimingManager::GetIdleTicks() const
 
 void CoreTimingManager::ClearPendingEvents()
 {
-  m_event_queue.clear();
+  m_event_queue.Clear();
 }
 
 void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_type, u64 userdata,
@@ -241,8 +431,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
     if (!m_is_global_timer_sane)
       ForceExceptionCheck(cycles_into_future);
 
-    m_event_queue.emplace_back(Event{timeout, m_event_fifo_id++, userdata, event_type});
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.Push(Event{timeout, m_event_fifo_id++, userdata, event_type});
   }
   else
   {
@@ -261,15 +450,7 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
 
 void CoreTimingManager::RemoveEvent(EventType* event_type)
 {
-  auto itr = std::remove_if(m_event_queue.begin(), m_event_queue.end(),
-                            [&](const Event& e) { return e.type == event_type; });
-
-  // Removing random items breaks the invariant so we have to re-establish it.
-  if (itr != m_event_queue.end())
-  {
-    m_event_queue.erase(itr, m_event_queue.end());
-    std::make_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-  }
+  m_event_queue.RemoveAll(event_type);
 }
 
 void CoreTimingManager::RemoveAllEvents(EventType* event_type)
@@ -296,8 +477,7 @@ void CoreTimingManager::MoveEvents()
   for (Event ev; m_ts_queue.Pop(ev);)
   {
     ev.fifo_order = m_event_fifo_id++;
-    m_event_queue.emplace_back(std::move(ev));
-    std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
+    m_event_queue.Push(ev);
   }
 }
 
@@ -316,11 +496,9 @@ void CoreTimingManager::Advance()
 
   m_is_global_timer_sane = true;
 
-  while (!m_event_queue.empty() && m_event_queue.front().time <= m_globals.global_timer)
+  while (!m_event_queue.Empty() && m_event_queue.Top().time <= m_globals.global_timer)
   {
-    Event evt = std::move(m_event_queue.front());
-    std::pop_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
-    m_event_queue.pop_back();
+    const Event evt = m_event_queue.Pop();
 
     Throttle(evt.time);
     evt.type->callback(m_system, evt.userdata, m_globals.global_timer - evt.time);
@@ -329,10 +507,10 @@ void CoreTimingManager::Advance()
   m_is_global_timer_sane = false;
 
   // Still events left (scheduled in the future)
-  if (!m_event_queue.empty())
+  if (!m_event_queue.Empty())
   {
     m_globals.slice_length = static_cast<int>(
-        std::min<s64>(m_event_queue.front().time - m_globals.global_timer, MAX_SLICE_LENGTH));
+        std::min<s64>(m_event_queue.Top().time - m_globals.global_timer, MAX_SLICE_LENGTH));
   }
 
   ppc_state.downcount = CyclesToDowncount(m_globals.slice_length);
@@ -419,9 +597,7 @@ bool CoreTimingManager::GetVISkip() const
 
 void CoreTimingManager::LogPendingEvents() const
 {
-  auto clone = m_event_queue;
-  std::sort(clone.begin(), clone.end());
-  for (const Event& ev : clone)
+  for (const Event& ev : m_event_queue.GetSortedEvents())
   {
     INFO_LOG_FMT(POWERPC, "PENDING: Now: {} Pending: {} Type: {}", m_globals.global_timer, ev.time,
                  *ev.type->name);
@@ -434,11 +610,11 @@ void CoreTimingManager::AdjustEventQueueTimes(u32 new_ppc_clock, u32 old_ppc_clo
   m_throttle_clock_per_sec = new_ppc_clock;
   m_throttle_min_clock_per_sleep = new_ppc_clock / 1200;
 
-  for (Event& ev : m_event_queue)
-  {
+  // Rounding can make distinct times equal, so the queue has to re-establish its order.
+  m_event_queue.ModifyAll([&](Event& ev) {
     const s64 ticks = (ev.time - m_globals.global_timer) * new_ppc_clock / old_ppc_clock;
     ev.time = m_globals.global_timer + ticks;
-  }
+  });
 }
 
 void CoreTimingManager::Idle()
@@ -464,9 +640,7 @@ std::string CoreTimingManager::GetScheduledEventsSummary() const
   std::string text = "Scheduled events\n";
   text.reserve(1000);
 
-  auto clone = m_event_queue;
-  std::sort(clone.begin(), clone.end());
-  for (const Event& ev : clone)
+  for (const Event& ev : m_event_queue.GetSortedEvents())
   {
     text += fmt::format("{} : {} {:016x}\n", *ev.type->name, ev.time, ev.userdata);
   }
@@ -49,6 +49,10 @@ struct EventType
 {
   TimedCallback callback;
   const std::string* name;
+
+  // Head of the intrusive list of this type's pending events in the EventQueue, which lets
+  // RemoveEvent() find them without scanning the whole queue.
+  u32 first_queued_event = UINT32_MAX;
 };
 
 struct Event
@@ -59,6 +63,81 @@ struct Event
   EventType* type;
 };
 
+// Priority queue of events, ordered by time and then by fifo_order.
+//
+// This is a pairing heap whose nodes live in a pool and are addressed by index. Besides the heap
+// links, every node is part of a doubly linked list of the events of its EventType, so all events
+// of a type can be removed without scanning or rebuilding the queue. Push is O(1), Pop and
+// RemoveAll are O(log n) amortized per removed event.
+//
+// Since (time, fifo_order) is a total order, events are popped in exactly the same order as with
+// any other priority queue, which is what keeps this deterministic.
+class EventQueue
+{
+public:
+  static constexpr u32 INVALID_INDEX = UINT32_MAX;
+
+  EventQueue() = default;
+  EventQueue(const EventQueue&) = delete;
+  EventQueue& operator=(const EventQueue&) = delete;
+
+  bool Empty() const { return m_root == INVALID_INDEX; }
+  size_t Size() const { return m_size; }
+
+  const Event& Top() const { return m_nodes[m_root].event; }
+  void Push(const Event& event);
+  Event Pop();
+
+  // Removes all events of the given type.
+  void RemoveAll(EventType* event_type);
+  void Clear();
+
+  // Returns all pending events sorted by time and fifo_order.
+  std::vector<Event> GetSortedEvents() const;
+
+  // Calls func on every pending event, allowing their times to be changed, and then restores the
+  // heap order.
+  template <typename F>
+  void ModifyAll(F func)
+  {
+    for (Node& node : m_nodes)
+    {
+      if (node.event.type)
+        func(node.event);
+    }
+    Rebuild();
+  }
+
+private:
+  struct Node
+  {
+    Event event{};  // type is nullptr for nodes on the free list
+
+    // Heap links. prev is the parent for the leftmost child and the left sibling otherwise.
+    u32 child = INVALID_INDEX;
+    u32 sibling = INVALID_INDEX;
+    u32 prev = INVALID_INDEX;
+
+    // Links of the list of events of the same type
+    u32 type_prev = INVALID_INDEX;
+    u32 type_next = INVALID_INDEX;
+  };
+
+  bool Less(u32 a, u32 b) const;
+  u32 Meld(u32 a, u32 b);
+  u32 MergePairs(u32 first);
+  void Detach(u32 index);
+  void UnlinkFromType(u32 index);
+  void FreeNode(u32 index);
+  void Rebuild();
+
+  std::vector<Node> m_nodes;
+  std::vector<u32> m_merge_scratch;
+  u32 m_root = INVALID_INDEX;
+  u32 m_free_list = INVALID_INDEX;
+  size_t m_size = 0;
+};
+
 enum class FromThread
 {
   CPU,
@@ -160,11 +239,9 @@ private:
   std::unordered_map<std::string, EventType> m_event_types;
 
   // STATE_TO_SAVE
-  // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-  // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-  // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't accomodated
-  // by the standard adaptor class.
-  std::vector<Event> m_event_queue;
+  // Serialized as a flat list of events, so the savestate layout doesn't depend on the queue's
+  // internal structure.
+  EventQueue m_event_queue;
   u64 m_event_fifo_id = 0;
   std::mutex m_ts_write_lock;
   Common::SPSCQueue<Event, false> m_ts_queue;
@@ -9,6 +9,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "AudioCommon/AudioCommon.h"
@@ -41,6 +42,7 @@
 #include "DiscIO/Blob.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Enums.h"
+#include "DiscIO/PrefetchBlob.h"
 #include "DiscIO/VolumeDisc.h"
 #include "DiscIO/VolumeWii.h"
 
@@ -424,7 +426,7 @@ void DVDInterface::EjectDiscCallback(Core::System& system, u64 userdata, s64 cyc
 void DVDInterface::InsertDiscCallback(Core::System& system, u64 userdata, s64 cyclesLate)
 {
   auto& di = system.GetDVDInterface();
-  std::unique_ptr<DiscIO::VolumeDisc> new_disc = DiscIO::CreateDisc(di.m_disc_path_to_insert);
+  std::unique_ptr<DiscIO::VolumeDisc> new_disc = CreateDisc(di.m_disc_path_to_insert);
 
   if (new_disc)
     di.SetDisc(std::move(new_disc), {});
@@ -1525,4 +1527,16 @@ void DVDInterface::ScheduleReads(u64 offset, u32 length, const DiscIO::Partition
                 ticks_until_completion * 1000000 / SystemTimers::GetTicksPerSecond());
 }
 
+std::unique_ptr<DiscIO::VolumeDisc> CreateDisc(const std::string& path)
+{
+  const u64 chunk_cache_size =
+      static_cast<u64>(std::max(Config::Get(Config::MAIN_DISC_CHUNK_CACHE_SIZE), 0)) * 1024 * 1024;
+  std::unique_ptr<DiscIO::BlobReader> reader = DiscIO::CreateBlobReader(
+      path, Config::Get(Config::MAIN_MEMORY_MAPPED_DISC_READS), chunk_cache_size);
+  if (Config::Get(Config::MAIN_DISC_PREFETCH))
+    reader = DiscIO::PrefetchBlobReader::Wrap(std::move(reader), path);
+
+  return DiscIO::CreateDisc(std::move(reader));
+}
+
 }  // namespace DVD
@@ -302,4 +302,10 @@ private:
 
   Core::System& m_system;
 };
+
+// Opens a disc image for the emulated drive. If MAIN_DISC_PREFETCH is enabled, compressed images
+// are decompressed ahead of sequential reads on background threads. If
+// MAIN_MEMORY_MAPPED_DISC_READS is enabled, uncompressed images on local disks are memory mapped.
+// MAIN_DISC_CHUNK_CACHE_SIZE sets how much decompressed data WIA and RVZ images keep in memory.
+std::unique_ptr<DiscIO::VolumeDisc> CreateDisc(const std::string& path);
 }  // namespace DVD
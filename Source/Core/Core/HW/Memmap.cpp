@@ -14,10 +14,15 @@
 #include <memory>
 #include <tuple>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 #include "Common/MemArena.h"
+#include "Common/MemoryUtil.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
 #include "Core/Config/MainSettings.h"
@@ -41,6 +46,10 @@
 
 namespace Memory
 {
+// Granularity of write tracking. This is larger than the page size of most hosts, which reduces
+// the number of faults, and it is a multiple of the page size of hosts with 16 KiB pages.
+constexpr u32 TRACKED_PAGE_SIZE = 0x4000;
+
 MemoryManager::MemoryManager(Core::System& system) : m_system(system)
 {
 }
@@ -122,6 +131,7 @@ void MemoryManager::Init()
     mem_size += region.size;
   }
   m_arena.GrabSHMSegment(mem_size, "dolphin-emu");
+  m_shm_size = mem_size;
 
   m_physical_page_mappings.fill(nullptr);
 
@@ -150,6 +160,11 @@ void MemoryManager::Init()
 
   m_physical_page_mappings_base = reinterpret_cast<u8*>(m_physical_page_mappings.data());
   m_logical_page_mappings_base = reinterpret_cast<u8*>(m_logical_page_mappings.data());
+  for (auto& shm_offsets : m_logical_shm_offsets)
+  {
+    for (std::atomic<u32>& shm_offset : shm_offsets)
+      shm_offset.store(UNMAPPED_LOGICAL_PAGE, std::memory_order_relaxed);
+  }
 
   InitMMIO(wii);
 
@@ -242,6 +257,10 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
   m_logical_mapped_entries.clear();
 
   m_logical_page_mappings.fill(nullptr);
+  const u32 shm_offsets_index = m_active_logical_shm_offsets.load(std::memory_order_relaxed) ^ 1;
+  auto& shm_offsets = m_logical_shm_offsets[shm_offsets_index];
+  for (std::atomic<u32>& shm_offset : shm_offsets)
+    shm_offset.store(UNMAPPED_LOGICAL_PAGE, std::memory_order_relaxed);
 
   for (u32 i = 0; i < dbat_table.size(); ++i)
   {
@@ -279,15 +298,23 @@ void MemoryManager::UpdateLogicalMemory(const PowerPC::BatTable& dbat_table)
                   intersection_start, mapped_size, logical_address);
               exit(0);
             }
-            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size});
+            m_logical_mapped_entries.push_back({mapped_pointer, mapped_size, position});
+
+            // New mappings start out writable, so untracked writes could slip through them
+            if (m_write_tracking_enabled)
+              Common::WriteProtectMemory(mapped_pointer, mapped_size);
           }
 
           m_logical_page_mappings[i] =
               *physical_region.out_pointer + intersection_start - mapping_address;
+          shm_offsets[i].store(physical_region.shm_position + intersection_start - mapping_address,
+                               std::memory_order_relaxed);
         }
       }
     }
   }
+
+  m_active_logical_shm_offsets.store(shm_offsets_index, std::memory_order_release);
 }
 
 void MemoryManager::DoState(PointerWrap& p)
@@ -328,6 +355,26 @@ void MemoryManager::DoState(PointerWrap& p)
     return;
   }
 
+  bool dirty_pages_only =
+      m_write_tracking_enabled && m_state_mode == MemoryStateMode::DirtyPagesOnly;
+  p.Do(dirty_pages_only);
+
+  // Other threads (e.g. the GPU thread doing EFB copies) can write to memory while it's being
+  // saved, so the baseline is set before any page is copied. Writes which happen after that are
+  // either in the copy or reported as dirty afterwards.
+  if (p.IsWriteMode() && m_write_tracking_enabled &&
+      m_state_mode == MemoryStateMode::FullBaseline)
+  {
+    ResetDirtyPages();
+  }
+
+  if (dirty_pages_only)
+  {
+    DoDirtyPagesState(p);
+    p.DoMarker("Memory dirty pages");
+    return;
+  }
+
   p.DoArray(m_ram, current_ram_size);
   p.DoArray(m_l1_cache, current_l1_cache_size);
   p.DoMarker("Memory RAM");
@@ -339,10 +386,355 @@ void MemoryManager::DoState(PointerWrap& p)
   p.DoMarker("Memory EXRAM");
 }
 
+void MemoryManager::DoDirtyPagesState(PointerWrap& p)
+{
+  u32 page_size = m_tracked_page_size;
+  p.Do(page_size);
+
+  if (p.IsReadMode())
+  {
+    u32 count = 0;
+    p.Do(count);
+    for (u32 i = 0; i < count && p.IsReadMode(); ++i)
+    {
+      u32 shm_offset = 0;
+      p.Do(shm_offset);
+
+      u8* page = GetHostPointerForShmOffset(shm_offset);
+      if (!page || shm_offset + page_size > m_shm_size)
+      {
+        p.SetVerifyMode();
+        return;
+      }
+      p.DoArray(page, page_size);
+    }
+    return;
+  }
+
+  // Collect the dirty pages in the measure pass only, so that the write pass sees the same set
+  if (p.IsMeasureMode())
+  {
+    m_state_dirty_pages.clear();
+    for (u32 i = 0; i < m_shm_size / m_tracked_page_size; ++i)
+    {
+      if (IsPageDirty(i))
+        m_state_dirty_pages.push_back(i * m_tracked_page_size);
+    }
+  }
+
+  u32 count = static_cast<u32>(m_state_dirty_pages.size());
+  p.Do(count);
+  for (u32 shm_offset : m_state_dirty_pages)
+  {
+    p.Do(shm_offset);
+    p.DoArray(GetHostPointerForShmOffset(shm_offset), m_tracked_page_size);
+  }
+
+  if (p.IsWriteMode())
+    m_state_dirty_pages.clear();
+}
+
+u8* MemoryManager::GetHostPointerForShmOffset(u32 shm_offset) const
+{
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (region.active && shm_offset >= region.shm_position &&
+        shm_offset < region.shm_position + region.size)
+    {
+      return *region.out_pointer + (shm_offset - region.shm_position);
+    }
+  }
+  return nullptr;
+}
+
+template <typename F>
+void MemoryManager::ForEachMemoryView(F function)
+{
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (!region.active)
+      continue;
+
+    function(*region.out_pointer, region.size);
+    if (m_is_fastmem_arena_initialized)
+      function(m_physical_base + region.physical_address, region.size);
+  }
+
+  for (const LogicalMemoryView& entry : m_logical_mapped_entries)
+    function(static_cast<u8*>(entry.mapped_pointer), entry.mapped_size);
+}
+
+bool MemoryManager::EnableWriteTracking()
+{
+  if (m_write_tracking_enabled)
+    return true;
+
+#ifdef __APPLE__
+  return false;
+#else
+  if (!m_is_initialized || !m_is_fastmem_arena_initialized)
+    return false;
+
+#ifndef _WIN32
+  const long host_page_size = sysconf(_SC_PAGESIZE);
+  if (host_page_size <= 0 || TRACKED_PAGE_SIZE % host_page_size != 0)
+    return false;
+#endif
+
+  std::lock_guard lk(m_write_generation_mutex);
+
+  const u32 page_count = m_shm_size / TRACKED_PAGE_SIZE;
+  m_tracked_page_size = TRACKED_PAGE_SIZE;
+  if (!m_write_faults)
+  {
+    m_write_faults = std::make_unique<std::atomic<u32>[]>(page_count);
+    m_protected_write_faults = std::make_unique<std::atomic<u32>[]>(page_count);
+    m_dirty_baseline_write_faults = std::make_unique<u32[]>(page_count);
+    m_write_generation_requested = std::make_unique<std::atomic<bool>[]>(page_count);
+  }
+  for (u32 i = 0; i < page_count; ++i)
+  {
+    m_write_faults[i].store(0, std::memory_order_relaxed);
+    m_protected_write_faults[i].store(0, std::memory_order_relaxed);
+    m_write_generation_requested[i].store(false, std::memory_order_relaxed);
+  }
+  ++m_write_tracking_epoch;
+  m_write_tracking_enabled = true;
+  ResetDirtyPages();
+
+  INFO_LOG_FMT(MEMMAP, "Write tracking enabled with {} pages of {} bytes",
+               m_shm_size / m_tracked_page_size, m_tracked_page_size);
+  return true;
+#endif
+}
+
+void MemoryManager::DisableWriteTracking()
+{
+  if (!m_write_tracking_enabled)
+    return;
+
+  ForEachMemoryView([](u8* view, u32 size) { Common::UnWriteProtectMemory(view, size); });
+
+  // The arrays are kept, since a fault which happened right before the memory was unprotected may
+  // still be getting handled on another thread
+  std::lock_guard lk(m_write_generation_mutex);
+  m_write_tracking_enabled = false;
+  m_state_dirty_pages.clear();
+}
+
+void MemoryManager::ResetDirtyPages()
+{
+  if (!m_write_tracking_enabled)
+    return;
+
+  // The counts have to be read before protecting the pages. Another thread can still write to a
+  // page which is writable at this point without faulting, but only until it gets protected, so
+  // the write is seen by anything which reads the page after this returns. Writes to protected
+  // pages fault and raise the count above the baseline.
+  for (u32 i = 0; i < m_shm_size / m_tracked_page_size; ++i)
+    m_dirty_baseline_write_faults[i] = m_write_faults[i].load(std::memory_order_acquire);
+
+  ForEachMemoryView([](u8* view, u32 size) { Common::WriteProtectMemory(view, size); });
+}
+
+bool MemoryManager::IsPageDirty(u32 page) const
+{
+  return m_write_faults[page].load(std::memory_order_acquire) !=
+         m_dirty_baseline_write_faults[page];
+}
+
+size_t MemoryManager::GetDirtyPageCount() const
+{
+  if (!m_write_tracking_enabled)
+    return 0;
+
+  size_t count = 0;
+  for (u32 i = 0; i < m_shm_size / m_tracked_page_size; ++i)
+    count += IsPageDirty(i);
+  return count;
+}
+
+void MemoryManager::MarkRangeDirty(u32 address, size_t size)
+{
+  if (!m_write_tracking_enabled || size == 0)
+    return;
+
+  u8* const start = GetPointerForRange(address, size);
+  if (!start)
+    return;
+
+  for (size_t offset = 0; offset < size;)
+  {
+    const std::optional<TrackedAddress> tracked =
+        GetTrackedAddress(reinterpret_cast<uintptr_t>(start + offset));
+    if (!tracked)
+      return;
+
+    MarkPageWritten(tracked->shm_offset);
+    Common::UnWriteProtectMemory(tracked->page_start, m_tracked_page_size);
+    offset = tracked->page_start + m_tracked_page_size - start;
+  }
+}
+
+bool MemoryManager::HandleWriteTrackingFault(uintptr_t fault_address)
+{
+  if (!m_write_tracking_enabled)
+    return false;
+
+  const std::optional<TrackedAddress> tracked = GetTrackedAddress(fault_address);
+  if (!tracked)
+    return false;
+
+  MarkPageWritten(tracked->shm_offset);
+
+  // Only the view that faulted is made writable. Writes through other views of the same page
+  // fault once more, which is harmless.
+  Common::UnWriteProtectMemory(tracked->page_start, m_tracked_page_size);
+  return true;
+}
+
+void MemoryManager::MarkPageWritten(u32 shm_offset)
+{
+  const u32 page = shm_offset / m_tracked_page_size;
+  m_write_faults[page].fetch_add(1, std::memory_order_acq_rel);
+}
+
+void MemoryManager::WriteProtectPage(u32 shm_offset)
+{
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (!region.active || shm_offset < region.shm_position ||
+        shm_offset >= region.shm_position + region.size)
+    {
+      continue;
+    }
+
+    const u32 offset = shm_offset - region.shm_position;
+    Common::WriteProtectMemory(*region.out_pointer + offset, m_tracked_page_size);
+    if (m_is_fastmem_arena_initialized)
+    {
+      Common::WriteProtectMemory(m_physical_base + region.physical_address + offset,
+                                 m_tracked_page_size);
+    }
+  }
+
+  for (const LogicalMemoryView& entry : m_logical_mapped_entries)
+  {
+    if (shm_offset >= entry.shm_position && shm_offset < entry.shm_position + entry.mapped_size)
+    {
+      Common::WriteProtectMemory(
+          static_cast<u8*>(entry.mapped_pointer) + (shm_offset - entry.shm_position),
+          m_tracked_page_size);
+    }
+  }
+}
+
+void MemoryManager::UpdateWriteGenerations()
+{
+  if (!m_write_tracking_enabled)
+    return;
+
+  for (u32 i = 0; i < m_shm_size / m_tracked_page_size; ++i)
+  {
+    // The count has to be read before protecting the page. A write that faults in between leaves
+    // the page writable, but also leaves the counts different, so it's handled next time.
+    const u32 faults = m_write_faults[i].load(std::memory_order_acquire);
+    if (faults == m_protected_write_faults[i].load(std::memory_order_relaxed))
+      continue;
+
+    // Protecting a page makes the next write to it fault, which is only worth it for pages that
+    // the video thread wants to know about
+    if (!m_write_generation_requested[i].exchange(false, std::memory_order_relaxed))
+      continue;
+
+    WriteProtectPage(i * m_tracked_page_size);
+    m_protected_write_faults[i].store(faults, std::memory_order_release);
+  }
+}
+
+std::optional<u64> MemoryManager::GetWriteGeneration(const u8* host_pointer, u32 size)
+{
+  std::lock_guard lk(m_write_generation_mutex);
+  if (!m_write_tracking_enabled || size == 0)
+    return std::nullopt;
+
+  const std::optional<TrackedAddress> tracked =
+      GetTrackedAddress(reinterpret_cast<uintptr_t>(host_pointer));
+  if (!tracked)
+    return std::nullopt;
+
+  // Both ends have to be in the same region of memory
+  const std::optional<TrackedAddress> tracked_end =
+      GetTrackedAddress(reinterpret_cast<uintptr_t>(host_pointer + size - 1));
+  if (!tracked_end || tracked_end->shm_offset != tracked->shm_offset + size - 1)
+    return std::nullopt;
+
+  // The counts only ever go up, so their sum changes whenever one of them does
+  u64 generation = static_cast<u64>(m_write_tracking_epoch) << 32;
+  bool written = false;
+  const u32 first_page = tracked->shm_offset / m_tracked_page_size;
+  const u32 last_page = (tracked->shm_offset + size - 1) / m_tracked_page_size;
+  for (u32 i = first_page; i <= last_page; ++i)
+  {
+    m_write_generation_requested[i].store(true, std::memory_order_relaxed);
+    const u32 protected_faults = m_protected_write_faults[i].load(std::memory_order_acquire);
+    written |= m_write_faults[i].load(std::memory_order_acquire) != protected_faults;
+    generation += protected_faults;
+  }
+  if (written)
+    return std::nullopt;
+  return generation;
+}
+
+std::optional<MemoryManager::TrackedAddress>
+MemoryManager::GetTrackedAddress(uintptr_t host_address) const
+{
+  const u8* const ptr = reinterpret_cast<const u8*>(host_address);
+
+  for (const PhysicalMemoryRegion& region : m_physical_regions)
+  {
+    if (!region.active)
+      continue;
+
+    u8* view = *region.out_pointer;
+    if (!(ptr >= view && ptr < view + region.size) && m_is_fastmem_arena_initialized)
+      view = m_physical_base + region.physical_address;
+    if (!(ptr >= view && ptr < view + region.size))
+      continue;
+
+    const u32 shm_offset = region.shm_position + static_cast<u32>(ptr - view);
+    return TrackedAddress{shm_offset,
+                          const_cast<u8*>(ptr) - (shm_offset % m_tracked_page_size)};
+  }
+
+  // The logical views are mirrors of the physical ones, so resolve through the BAT page table
+  if (m_is_fastmem_arena_initialized && ptr >= m_logical_base &&
+      ptr < m_logical_base + 0x1'0000'0000)
+  {
+    const u32 logical_address = static_cast<u32>(ptr - m_logical_base);
+    const u32 bat_index = logical_address >> PowerPC::BAT_INDEX_SHIFT;
+    const auto& shm_offsets =
+        m_logical_shm_offsets[m_active_logical_shm_offsets.load(std::memory_order_acquire)];
+    const u32 page_shm_offset = shm_offsets[bat_index].load(std::memory_order_relaxed);
+    if (page_shm_offset == UNMAPPED_LOGICAL_PAGE)
+      return std::nullopt;
+
+    const u32 shm_offset = page_shm_offset + (logical_address & (PowerPC::BAT_PAGE_SIZE - 1));
+    return TrackedAddress{shm_offset, const_cast<u8*>(ptr) - (shm_offset % m_tracked_page_size)};
+  }
+
+  return std::nullopt;
+}
+
 void MemoryManager::Shutdown()
 {
   ShutdownFastmemArena();
 
+  m_write_faults.reset();
+  m_protected_write_faults.reset();
+  m_dirty_baseline_write_faults.reset();
+  m_write_generation_requested.reset();
+
   m_is_initialized = false;
   for (const PhysicalMemoryRegion& region : m_physical_regions)
   {
@@ -362,6 +754,9 @@ void MemoryManager::ShutdownFastmemArena()
   if (!m_is_fastmem_arena_initialized)
     return;
 
+  // Write tracking relies on the fastmem fault handler
+  DisableWriteTracking();
+
   for (const PhysicalMemoryRegion& region : m_physical_regions)
   {
     if (!region.active)
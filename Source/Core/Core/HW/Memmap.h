@@ -4,7 +4,10 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -53,6 +56,20 @@ struct LogicalMemoryView
 {
   void* mapped_pointer;
   u32 mapped_size;
+  u32 shm_position;
+};
+
+// Controls how MemoryManager::DoState serializes emulated memory when saving.
+enum class MemoryStateMode
+{
+  // All memory is saved.
+  Full,
+  // All memory is saved, and the dirty page tracking is reset afterwards.
+  // Use this for the state that later DirtyPagesOnly states are based on.
+  FullBaseline,
+  // Only the pages written to since the last FullBaseline state are saved. The resulting state
+  // can only be loaded on top of the baseline state. Requires write tracking to be enabled.
+  DirtyPagesOnly,
 };
 
 class MemoryManager
@@ -100,6 +117,38 @@ public:
 
   void UpdateLogicalMemory(const PowerPC::BatTable& dbat_table);
 
+  // Write tracking. While enabled, all views of emulated memory are write-protected and the first
+  // write to each page is caught by the fastmem fault handler, which marks the page as dirty.
+  // This lets savestates be made incremental (see MemoryStateMode). Only available when the
+  // fastmem arena is in use, and not on macOS, where the fault handler only covers the CPU thread.
+  bool EnableWriteTracking();
+  void DisableWriteTracking();
+  bool IsWriteTrackingEnabled() const { return m_write_tracking_enabled; }
+  void ResetDirtyPages();
+  size_t GetDirtyPageCount() const;
+  u32 GetTrackedPageSize() const { return m_tracked_page_size; }
+  // System calls fail instead of faulting when writing to write-protected memory, so this must be
+  // called for physical memory that is about to be passed to such a call (e.g. as a read buffer).
+  void MarkRangeDirty(u32 address, size_t size);
+  // Called by the fault handler. Returns true if the fault was caused by write tracking.
+  bool HandleWriteTrackingFault(uintptr_t fault_address);
+  // Changes every time write tracking gets enabled.
+  u32 GetWriteTrackingEpoch() const { return m_write_tracking_epoch; }
+
+  // Write generations. Each tracked page has a generation which changes when the page is written
+  // to, which lets the video thread tell that memory it has looked at before is unchanged without
+  // reading it again. Pages that were written to since a generation was last asked for are
+  // write-protected again and get a new generation in UpdateWriteGenerations, which must be called
+  // on the CPU thread once per frame. Other written pages are left writable, so that memory the
+  // video thread doesn't look at doesn't fault every frame.
+  void UpdateWriteGenerations();
+  // Returns a value that only stays the same while the given range of emulated memory isn't
+  // written to. Returns nothing if write tracking is disabled, the range isn't in tracked memory,
+  // or the range was written to since the last UpdateWriteGenerations call. Thread-safe.
+  std::optional<u64> GetWriteGeneration(const u8* host_pointer, u32 size);
+
+  void SetStateMode(MemoryStateMode mode) { m_state_mode = mode; }
+
   void Clear();
 
   // Routines to access physically addressed memory, designed for use by
@@ -242,9 +291,52 @@ private:
 
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_physical_page_mappings{};
   std::array<void*, PowerPC::BAT_PAGE_COUNT> m_logical_page_mappings{};
+  // The shared memory offset each logical page is mapped to, for the write tracking fault handler,
+  // which can't take locks. UpdateLogicalMemory fills in the inactive table and then switches
+  // tables, so the handler never sees a table that is halfway rebuilt.
+  static constexpr u32 UNMAPPED_LOGICAL_PAGE = 0xFFFFFFFF;
+  std::array<std::array<std::atomic<u32>, PowerPC::BAT_PAGE_COUNT>, 2> m_logical_shm_offsets{};
+  std::atomic<u32> m_active_logical_shm_offsets = 0;
+
+  // Write tracking state. The arrays are indexed by page within the shared memory segment. They
+  // are allocated the first time write tracking is enabled and only freed on shutdown, since the
+  // fault handler can still be using them on another thread while tracking gets disabled.
+  std::atomic<bool> m_write_tracking_enabled = false;
+  u32 m_tracked_page_size = 0;
+  u32 m_shm_size = 0;
+  u32 m_write_tracking_epoch = 0;
+  // Write faults counted per page, and the count at the time each page was last write-protected
+  // by UpdateWriteGenerations. A page has been written to since then if the two differ. Faults
+  // are counted before the faulting view is made writable, so no write can slip in unnoticed.
+  std::unique_ptr<std::atomic<u32>[]> m_write_faults;
+  std::unique_ptr<std::atomic<u32>[]> m_protected_write_faults;
+  // The fault counts at the last ResetDirtyPages call. Pages whose count differs are dirty.
+  std::unique_ptr<u32[]> m_dirty_baseline_write_faults;
+  // Set for the pages GetWriteGeneration was called for since they were last write-protected
+  std::unique_ptr<std::atomic<bool>[]> m_write_generation_requested;
+  // Keeps GetWriteGeneration from seeing write tracking get disabled halfway through
+  std::mutex m_write_generation_mutex;
+  MemoryStateMode m_state_mode = MemoryStateMode::Full;
+  // The dirty pages found while measuring a DirtyPagesOnly state, reused for the actual write so
+  // that pages dirtied in between can't change the size of the state.
+  std::vector<u32> m_state_dirty_pages;
 
   Core::System& m_system;
 
   void InitMMIO(bool is_wii);
+
+  struct TrackedAddress
+  {
+    u32 shm_offset;
+    u8* page_start;
+  };
+  std::optional<TrackedAddress> GetTrackedAddress(uintptr_t host_address) const;
+  template <typename F>
+  void ForEachMemoryView(F function);
+  u8* GetHostPointerForShmOffset(u32 shm_offset) const;
+  bool IsPageDirty(u32 page) const;
+  void MarkPageWritten(u32 shm_offset);
+  void WriteProtectPage(u32 shm_offset);
+  void DoDirtyPagesState(PointerWrap& p);
 };
 }  // namespace Memory
@@ -166,6 +166,7 @@ enum Hotkey
   HK_LOAD_STATE_FILE,
   HK_INCREMENT_SELECTED_STATE_SLOT,
   HK_DECREMENT_SELECTED_STATE_SLOT,
+  HK_REWIND_STATE,
 
   HK_GBA_LOAD,
   HK_GBA_UNLOAD,
@@ -122,6 +122,7 @@ IPCReply ESDevice::ReadContent(u32 uid, const IOCtlVRequest& request)
 
     INFO_LOG_FMT(IOS_ES, "ReadContent(uid={:#x}, cfd={}, size={}, addr={:08x})", uid, cfd, size,
                  addr);
+    memory.MarkRangeDirty(addr, size);
     return m_core.ReadContent(cfd, memory.GetPointer(addr), size, uid, ticks);
   });
 }
@@ -325,6 +325,7 @@ std::optional<IPCReply> FSDevice::Read(const ReadWriteRequest& request)
   return MakeIPCReply([&](Ticks t) {
     auto& system = GetSystem();
     auto& memory = system.GetMemory();
+    memory.MarkRangeDirty(request.buffer, request.size);
     return m_core.Read(request.fd, memory.GetPointer(request.buffer), request.size, request.buffer,
                        t);
   });
@@ -625,6 +625,7 @@ void WiiSocket::Update(bool read, bool write, bool except)
 
           u32 flags = memory.Read_U32(BufferIn + 0x04);
           // Not a string, Windows requires a char* for recvfrom
+          memory.MarkRangeDirty(BufferOut, BufferOutSize);
           char* data = (char*)memory.GetPointer(BufferOut);
           int data_len = BufferOutSize;
 
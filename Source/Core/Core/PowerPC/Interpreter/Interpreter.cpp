@@ -190,6 +190,16 @@ int Interpreter::SingleStepInner()
   return opinfo->num_cycles;
 }
 
+int Interpreter::SingleStepBlock(u32 max_instructions)
+{
+  m_end_block = false;
+
+  int cycles = 0;
+  for (u32 i = 0; i < max_instructions && !m_end_block; ++i)
+    cycles += SingleStepInner();
+  return cycles;
+}
+
 void Interpreter::SingleStep()
 {
   auto& core_timing = m_system.GetCoreTiming();
@@ -34,6 +34,10 @@ public:
   void SingleStep() override;
   int SingleStepInner();
 
+  // Executes instructions until the end of the current block, but at most max_instructions.
+  // Returns the number of cycles executed.
+  int SingleStepBlock(u32 max_instructions);
+
   void Run() override;
   void ClearCache() override;
   const char* GetName() const override;
@@ -300,6 +300,7 @@ void Jit64::Init()
 void Jit64::ClearCache()
 {
   blocks.Clear();
+  js.coldBlockRunCounts.clear();
   blocks.ClearRangesToFree();
   trampolines.ClearCodeSpace();
   m_far_code.ClearCodeSpace();
@@ -326,6 +327,8 @@ void Jit64::Shutdown()
   auto& memory = m_system.GetMemory();
   memory.ShutdownFastmemArena();
 
+  m_disk_cache.Close();
+
   blocks.Shutdown();
   m_far_code.Shutdown();
   m_const_pool.Shutdown();
@@ -707,6 +710,12 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     m_free_ranges_far.insert(range.first, range.second);
   blocks.ClearRangesToFree();
 
+  if (m_tiered_compilation_enabled && !m_enable_debugging && !IsKnownHotBlock(em_address) &&
+      InterpretColdBlock(em_address))
+  {
+    return;
+  }
+
   std::size_t block_size = m_code_buffer.size();
 
   if (m_enable_debugging)
@@ -748,34 +757,11 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
     return;
   }
 
-  if (SetEmitterStateToFreeCodeRegion())
+  if (JitBlock* b = EmitBlock(em_address, nextPC))
   {
-    u8* near_start = GetWritableCodePtr();
-    u8* far_start = m_far_code.GetWritableCodePtr();
-
-    JitBlock* b = blocks.AllocateBlock(em_address);
-    if (DoJit(em_address, b, nextPC))
-    {
-      // Code generation succeeded.
-
-      // Mark the memory regions that this code block uses as used in the local rangesets.
-      u8* near_end = GetWritableCodePtr();
-      if (near_start != near_end)
-        m_free_ranges_near.erase(near_start, near_end);
-      u8* far_end = m_far_code.GetWritableCodePtr();
-      if (far_start != far_end)
-        m_free_ranges_far.erase(far_start, far_end);
-
-      // Store the used memory regions in the block so we know what to mark as unused when the
-      // block gets invalidated.
-      b->near_begin = near_start;
-      b->near_end = near_end;
-      b->far_begin = far_start;
-      b->far_end = far_end;
-
-      blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
-      return;
-    }
+    if (m_persistent_cache_enabled && !m_enable_debugging)
+      UpdatePersistentCache(*b);
+    return;
   }
 
   if (clear_cache_and_retry_on_failure)
@@ -794,6 +780,107 @@ void Jit64::Jit(u32 em_address, bool clear_cache_and_retry_on_failure)
   std::exit(-1);
 }
 
+bool Jit64::InterpretColdBlock(u32 em_address)
+{
+  // Code which only runs a few times (initialization, relocation of freshly loaded overlays, ...)
+  // is cheaper to interpret than to compile, and not compiling it avoids the stutter of compiling
+  // many blocks at once when a game loads new code. Blocks only get compiled once they're warm.
+  u32& run_count = js.coldBlockRunCounts[em_address];
+  if (++run_count > TIER_UP_THRESHOLD)
+  {
+    js.coldBlockRunCounts.erase(em_address);
+    return false;
+  }
+
+  // The dispatcher checks the downcount when we return, like it does after running a block.
+  auto& interpreter = m_system.GetInterpreter();
+  m_ppc_state.downcount -= interpreter.SingleStepBlock(static_cast<u32>(m_code_buffer.size()));
+  if (m_ppc_state.Exceptions != 0)
+  {
+    m_system.GetPowerPC().CheckExceptions();
+    m_ppc_state.pc = m_ppc_state.npc;
+  }
+
+  return true;
+}
+
+JitBlock* Jit64::EmitBlock(u32 em_address, u32 nextPC)
+{
+  if (!SetEmitterStateToFreeCodeRegion())
+    return nullptr;
+
+  u8* near_start = GetWritableCodePtr();
+  u8* far_start = m_far_code.GetWritableCodePtr();
+
+  JitBlock* b = blocks.AllocateBlock(em_address);
+  if (!DoJit(em_address, b, nextPC))
+    return nullptr;
+
+  // Code generation succeeded.
+
+  // Mark the memory regions that this code block uses as used in the local rangesets.
+  u8* near_end = GetWritableCodePtr();
+  if (near_start != near_end)
+    m_free_ranges_near.erase(near_start, near_end);
+  u8* far_end = m_far_code.GetWritableCodePtr();
+  if (far_start != far_end)
+    m_free_ranges_far.erase(far_start, far_end);
+
+  // Store the used memory regions in the block so we know what to mark as unused when the
+  // block gets invalidated.
+  b->near_begin = near_start;
+  b->near_end = near_end;
+  b->far_begin = far_start;
+  b->far_end = far_end;
+
+  blocks.FinalizeBlock(*b, jo.enableBlocklink, code_block.m_physical_addresses);
+  return b;
+}
+
+bool Jit64::OpenPersistentCache()
+{
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  if (game_id != m_disk_cache.GetGameID())
+    m_disk_cache.Open(game_id);
+  return m_disk_cache.IsOpen();
+}
+
+void Jit64::UpdatePersistentCache(const JitBlock& block)
+{
+  if (OpenPersistentCache())
+    m_disk_cache.RecordBlock(block, m_system.GetMemory());
+}
+
+bool Jit64::IsKnownHotBlock(u32 em_address)
+{
+  if (!m_persistent_cache_enabled || !OpenPersistentCache() || IsCodeSpaceLow())
+    return false;
+
+  const TranslateResult translated = m_mmu.JitCache_TranslateAddress(em_address);
+  if (!translated.valid)
+    return false;
+
+  const u32 msr_bits = m_ppc_state.msr.Hex & JitBaseBlockCache::JIT_CACHE_MSR_MASK;
+  const JitDiskCache::Entry* entry = m_disk_cache.Find(em_address, translated.address, msr_bits);
+  if (!entry || !JitDiskCache::Matches(*entry, m_system.GetMemory()))
+    return false;
+
+  m_disk_cache.CountPrewarmedBlock();
+  return true;
+}
+
+bool Jit64::IsCodeSpaceLow() const
+{
+  const auto free_near = m_free_ranges_near.by_size_begin();
+  const auto free_far = m_free_ranges_far.by_size_begin();
+  if (free_near == m_free_ranges_near.by_size_end() || free_far == m_free_ranges_far.by_size_end())
+    return true;
+
+  const size_t farcode_size = jo.memcheck ? FARCODE_SIZE_MMU : FARCODE_SIZE;
+  return static_cast<size_t>(free_near.to() - free_near.from()) < CODE_SIZE / 8 ||
+         static_cast<size_t>(free_far.to() - free_far.from()) < farcode_size / 8;
+}
+
 bool Jit64::SetEmitterStateToFreeCodeRegion()
 {
   // Find the largest free memory blocks and set code emitters to point at them.
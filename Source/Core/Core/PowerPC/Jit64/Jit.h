@@ -33,6 +33,7 @@
 #include "Core/PowerPC/Jit64Common/TrampolineCache.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
 #include "Core/PowerPC/JitCommon/JitCache.h"
+#include "Core/PowerPC/JitCommon/JitDiskCache.h"
 
 namespace PPCAnalyst
 {
@@ -258,6 +259,23 @@ private:
 
   bool HandleFunctionHooking(u32 address);
 
+  // Interprets the block at em_address instead of compiling it if it hasn't run often enough yet.
+  // Returns false if the block should be compiled.
+  bool InterpretColdBlock(u32 em_address);
+
+  // Emits the block analyzed into code_block. Returns nullptr if there's not enough code space.
+  JitBlock* EmitBlock(u32 em_address, u32 nextPC);
+
+  // Opens the persistent cache of the running game. Returns false if there is none.
+  bool OpenPersistentCache();
+  void UpdatePersistentCache(const JitBlock& block);
+  // Whether the block at em_address was compiled in an earlier run and its guest code hasn't
+  // changed since, in which case it doesn't have to warm up again before getting compiled.
+  bool IsKnownHotBlock(u32 em_address);
+  // Blocks which are known from earlier runs may not run again in this session, so they stop
+  // getting compiled early once code space is low. Otherwise they could cause a cache flush.
+  bool IsCodeSpaceLow() const;
+
   void ResetFreeMemoryRanges();
 
   static void ImHere(Jit64& jit);
@@ -276,6 +294,12 @@ private:
   const bool m_im_here_debug = false;
   const bool m_im_here_log = false;
   std::map<u32, int> m_been_here;
+
+  JitDiskCache m_disk_cache;
+
+  // Number of times a block has to be reached before it gets compiled when tiered compilation is
+  // enabled.
+  static constexpr u32 TIER_UP_THRESHOLD = 8;
 };
 
 void LogGeneratedX86(size_t size, const PPCAnalyst::CodeBuffer& code_buffer, const u8* normalEntry,
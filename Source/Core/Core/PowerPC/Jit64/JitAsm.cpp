@@ -209,9 +209,14 @@ void Jit64AsmRoutineManager::Generate()
   ABI_CallFunction(JitTrampoline);
   ABI_PopRegistersAndAdjustStack({}, 0);
 
+  // Jit interprets cold blocks instead of compiling them when tiered compilation is enabled,
+  // which may have used up the rest of the timeslice.
+  CMP(32, PPCSTATE(downcount), Imm8(0));
+  FixupBranch interpreted_bail = J_CC(CC_LE, true);
   JMP(dispatcher_no_check, true);
 
   SetJumpTarget(bail);
+  SetJumpTarget(interpreted_bail);
   do_timing = GetCodePtr();
 
   // make sure npc contains the next pc (needed for exception checking in CoreTiming::Advance)
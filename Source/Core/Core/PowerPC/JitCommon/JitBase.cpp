@@ -90,6 +90,10 @@ void JitBase::RefreshConfig()
   bJITBranchOff = Config::Get(Config::MAIN_DEBUG_JIT_BRANCH_OFF);
   bJITRegisterCacheOff = Config::Get(Config::MAIN_DEBUG_JIT_REGISTER_CACHE_OFF);
   m_enable_debugging = Config::Get(Config::MAIN_ENABLE_DEBUGGING);
+  m_tiered_compilation_enabled = Config::Get(Config::MAIN_JIT_TIERED_COMPILATION);
+  // The persistent cache only tells tiered compilation which blocks don't need to warm up again
+  m_persistent_cache_enabled =
+      m_tiered_compilation_enabled && Config::Get(Config::MAIN_JIT_PERSISTENT_CACHE);
   m_enable_float_exceptions = Config::Get(Config::MAIN_FLOAT_EXCEPTIONS);
   m_enable_div_by_zero_exceptions = Config::Get(Config::MAIN_DIVIDE_BY_ZERO_EXCEPTIONS);
   m_low_dcbz_hack = Config::Get(Config::MAIN_LOW_DCBZ_HACK);
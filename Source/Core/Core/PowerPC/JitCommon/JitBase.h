@@ -5,6 +5,7 @@
 
 #include <cstddef>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "Common/BitSet.h"
@@ -123,6 +124,10 @@ protected:
     std::unordered_set<u32> fifoWriteAddresses;
     std::unordered_set<u32> pairedQuantizeAddresses;
     std::unordered_set<u32> noSpeculativeConstantsAddresses;
+
+    // Number of times each block which hasn't been compiled yet has been interpreted, by start
+    // address. Only used when tiered compilation is enabled.
+    std::unordered_map<u32, u32> coldBlockRunCounts;
   };
 
   PPCAnalyst::CodeBlock code_block;
@@ -144,6 +149,8 @@ protected:
   bool bJITBranchOff = false;
   bool bJITRegisterCacheOff = false;
   bool m_enable_debugging = false;
+  bool m_persistent_cache_enabled = false;
+  bool m_tiered_compilation_enabled = false;
   bool m_enable_float_exceptions = false;
   bool m_enable_div_by_zero_exceptions = false;
   bool m_low_dcbz_hack = false;
@@ -42,7 +42,8 @@ void JitBaseBlockCache::Init()
 {
   Common::JitRegister::Init(Config::Get(Config::MAIN_PERF_MAP_DIR));
 
-  m_block_map_arena.GrabSHMSegment(FAST_BLOCK_MAP_SIZE, "dolphin-emu-jitblock");
+  m_fast_block_map =
+      reinterpret_cast<JitBlock**>(m_fast_block_map_region.Create(FAST_BLOCK_MAP_SIZE));
 
   Clear();
 }
@@ -51,12 +52,8 @@ void JitBaseBlockCache::Shutdown()
 {
   Common::JitRegister::Shutdown();
 
-  if (m_fast_block_map)
-  {
-    m_block_map_arena.ReleaseView(m_fast_block_map, FAST_BLOCK_MAP_SIZE);
-  }
-
-  m_block_map_arena.ReleaseSHMSegment();
+  m_fast_block_map_region.Release();
+  m_fast_block_map = nullptr;
 }
 
 // This clears the JIT cache. It's called from JitCache.cpp when the JIT cache
@@ -81,16 +78,7 @@ void JitBaseBlockCache::Clear()
 
   if (m_fast_block_map)
   {
-    m_block_map_arena.ReleaseView(m_fast_block_map, FAST_BLOCK_MAP_SIZE);
-    m_block_map_arena.ReleaseSHMSegment();
-    m_block_map_arena.GrabSHMSegment(FAST_BLOCK_MAP_SIZE, "dolphin-emu-jitblock");
-  }
-
-  m_fast_block_map =
-      reinterpret_cast<JitBlock**>(m_block_map_arena.CreateView(0, FAST_BLOCK_MAP_SIZE));
-
-  if (m_fast_block_map)
-  {
+    m_fast_block_map_region.Clear();
     m_fast_block_map_ptr = m_fast_block_map;
   }
   else
@@ -254,6 +242,20 @@ void JitBaseBlockCache::InvalidateICache(u32 initial_address, u32 initial_length
 void JitBaseBlockCache::InvalidateICacheInternal(u32 physical_address, u32 address, u32 length,
                                                  bool forced)
 {
+  // Blocks which are still being interpreted aren't in the block cache, so this has to happen
+  // before the valid_block check below.
+  auto& cold_block_run_counts = m_jit.js.coldBlockRunCounts;
+  if (length / 4 > cold_block_run_counts.size())
+  {
+    std::erase_if(cold_block_run_counts,
+                  [&](const auto& entry) { return entry.first - address < length; });
+  }
+  else
+  {
+    for (u32 i = address; i < address + length; i += 4)
+      cold_block_run_counts.erase(i);
+  }
+
   // Optimization for the case of invalidating a single cache line, which is used by the dcb*
   // instructions. If the valid_block bit for that cacheline is not set, we can safely skip
   // the remaining invalidation logic.
@@ -348,7 +350,7 @@ void JitBaseBlockCache::ErasePhysicalRange(u32 address, u32 length)
 
 u32* JitBaseBlockCache::GetBlockBitSet() const
 {
-  return valid_block.m_valid_block.get();
+  return valid_block.m_valid_block;
 }
 
 void JitBaseBlockCache::WriteDestroyBlock(const JitBlock& block)
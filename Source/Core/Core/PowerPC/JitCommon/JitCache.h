@@ -15,7 +15,9 @@
 #include <unordered_set>
 #include <vector>
 
+#include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/MemArena.h"
 #include "Core/HW/Memmap.h"
 
 class JitBase;
@@ -103,26 +105,30 @@ public:
   enum
   {
     // ValidBlockBitSet covers the whole 32-bit address-space in 32-byte
-    // chunks.
-    // FIXME: Maybe we can get away with less? There isn't any actual
-    // RAM in most of this space.
+    // chunks, so that the JIT can index it with any address without a range check.
+    // Since bits are only ever set for addresses which hold code, which is only
+    // found in MEM1, MEM2 and the locked L2 cache, only the parts of the bitset
+    // covering those are ever backed by memory.
     VALID_BLOCK_MASK_SIZE = (1ULL << 32) / 32,
     // The number of elements in the allocated array. Each u32 contains 32 bits.
     VALID_BLOCK_ALLOC_ELEMENTS = VALID_BLOCK_MASK_SIZE / 32
   };
   // Directly accessed by Jit64.
-  std::unique_ptr<u32[]> m_valid_block;
+  u32* m_valid_block = nullptr;
 
   ValidBlockBitSet()
   {
-    m_valid_block.reset(new u32[VALID_BLOCK_ALLOC_ELEMENTS]);
-    ClearAll();
+    m_valid_block = static_cast<u32*>(m_region.Create(sizeof(u32) * VALID_BLOCK_ALLOC_ELEMENTS));
+    ASSERT_MSG(DYNA_REC, m_valid_block, "Failed to allocate the valid block bitset");
   }
 
   void Set(u32 bit) { m_valid_block[bit / 32] |= 1u << (bit % 32); }
   void Clear(u32 bit) { m_valid_block[bit / 32] &= ~(1u << (bit % 32)); }
-  void ClearAll() { memset(m_valid_block.get(), 0, sizeof(u32) * VALID_BLOCK_ALLOC_ELEMENTS); }
+  void ClearAll() { m_region.Clear(); }
   bool Test(u32 bit) const { return (m_valid_block[bit / 32] & (1u << (bit % 32))) != 0; }
+
+private:
+  Common::LazyMemoryRegion m_region;
 };
 
 class JitBaseBlockCache
@@ -210,12 +216,13 @@ private:
 
   // This array is indexed with the shifted PC and likely holds the correct block id.
   // This is used as a fast cache of block_map used in the assembly dispatcher.
-  // It is implemented via a shm segment using m_block_map_arena.
+  // It is implemented via a lazily backed memory region, so only the parts of it covering
+  // addresses which code has been executed from cost memory.
   JitBlock** m_fast_block_map = 0;
-  Common::MemArena m_block_map_arena;
+  Common::LazyMemoryRegion m_fast_block_map_region;
 
-  // An alternative for the above fast_block_map but without a shm segment
-  // in case the shm memory region couldn't be allocated.
+  // An alternative for the above fast_block_map but without a lazily backed memory region
+  // in case it couldn't be allocated.
   std::array<JitBlock*, FAST_BLOCK_MAP_FALLBACK_ELEMENTS>
       m_fast_block_map_fallback{};  // start_addr & mask -> number
 
@@ -0,0 +1,148 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/PowerPC/JitCommon/JitDiskCache.h"
+
+#include <cstring>
+
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/JitCommon/JitCache.h"
+
+class JitDiskCache::Reader final : public Common::LinearDiskCacheReader<JitDiskCacheKey, u32>
+{
+public:
+  void Read(const JitDiskCacheKey& key, const u32* value, u32 value_size) override
+  {
+    if (value_size != key.num_instructions)
+      return;
+
+    // Blocks which got recompiled with different code are appended again, the last one wins
+    const BlockID id{key.effective_address, key.physical_address, key.msr_bits};
+    entries[id] = Entry{key, std::vector<u32>(value, value + value_size)};
+  }
+
+  std::map<BlockID, Entry> entries;
+};
+
+void JitDiskCache::Open(const std::string& game_id)
+{
+  Close();
+
+  m_game_id = game_id;
+  if (game_id.empty())
+    return;
+
+  const std::string filename = File::GetUserPath(D_CACHE_IDX) + game_id + ".jitcache";
+  Reader reader;
+  m_disk_cache.OpenAndRead(filename, reader);
+
+  for (const auto& [id, entry] : reader.entries)
+    m_known_blocks.emplace(id, entry.key.code_hash);
+  m_entries = std::move(reader.entries);
+
+  m_is_open = true;
+  INFO_LOG_FMT(DYNA_REC, "Loaded {} cached JIT blocks from {}", m_known_blocks.size(), filename);
+}
+
+void JitDiskCache::Close()
+{
+  if (m_is_open)
+  {
+    NOTICE_LOG_FMT(DYNA_REC,
+                   "JIT cache for {}: {} of {} cached blocks compiled without warming up, "
+                   "{} blocks added",
+                   m_game_id, m_prewarmed_blocks, m_entries.size(), m_appended_blocks);
+    m_disk_cache.Sync();
+    m_disk_cache.Close();
+  }
+
+  m_known_blocks.clear();
+  m_entries.clear();
+  m_game_id.clear();
+  m_is_open = false;
+  m_prewarmed_blocks = 0;
+  m_appended_blocks = 0;
+}
+
+void JitDiskCache::RecordBlock(const JitBlock& block, Memory::MemoryManager& memory)
+{
+  if (!m_is_open)
+    return;
+
+  std::vector<u32> physical_addresses(block.physical_addresses.begin(),
+                                      block.physical_addresses.end());
+  const std::optional<u64> code_hash = HashCode(physical_addresses, memory);
+  if (!code_hash)
+    return;
+
+  const BlockID id{block.effectiveAddress, block.physicalAddress, block.msrBits};
+  const auto [it, inserted] = m_known_blocks.emplace(id, *code_hash);
+  if (!inserted)
+  {
+    if (it->second == *code_hash)
+      return;
+    it->second = *code_hash;
+  }
+
+  JitDiskCacheKey key;
+  std::memset(&key, 0, sizeof(key));
+  key.effective_address = block.effectiveAddress;
+  key.physical_address = block.physicalAddress;
+  key.msr_bits = block.msrBits;
+  key.num_instructions = static_cast<u32>(physical_addresses.size());
+  key.code_hash = *code_hash;
+  m_disk_cache.Append(key, physical_addresses.data(), key.num_instructions);
+  ++m_appended_blocks;
+}
+
+const JitDiskCache::Entry* JitDiskCache::Find(u32 effective_address, u32 physical_address,
+                                              u32 msr_bits) const
+{
+  const auto it = m_entries.find(BlockID{effective_address, physical_address, msr_bits});
+  return it != m_entries.end() ? &it->second : nullptr;
+}
+
+bool JitDiskCache::Matches(const Entry& entry, Memory::MemoryManager& memory)
+{
+  return HashCode(entry.physical_addresses, memory) == entry.key.code_hash;
+}
+
+std::optional<u64> JitDiskCache::HashCode(const std::vector<u32>& physical_addresses,
+                                          Memory::MemoryManager& memory)
+{
+  if (physical_addresses.empty())
+    return std::nullopt;
+
+  // Only blocks in MEM1 and MEM2 are cached. Code in the locked L2 cache is generated at runtime,
+  // and looking up other addresses through MemoryManager::GetPointer would raise panic alerts.
+  std::vector<u32> instructions;
+  instructions.reserve(physical_addresses.size());
+  for (const u32 address : physical_addresses)
+  {
+    const u32 masked_address = address & 0x3FFFFFFF;
+    const u8* pointer;
+    if (masked_address + 4 <= memory.GetRamSizeReal())
+    {
+      pointer = memory.GetRAM() + masked_address;
+    }
+    else if (memory.GetEXRAM() && (masked_address >> 28) == 0x1 &&
+             (masked_address & 0x0FFFFFFF) + 4 <= memory.GetExRamSizeReal())
+    {
+      pointer = memory.GetEXRAM() + (masked_address & memory.GetExRamMask());
+    }
+    else
+    {
+      return std::nullopt;
+    }
+
+    u32 instruction;
+    std::memcpy(&instruction, pointer, sizeof(instruction));
+    instructions.push_back(instruction);
+  }
+
+  return Common::GetStableHash64(reinterpret_cast<const u8*>(instructions.data()),
+                                 static_cast<u32>(instructions.size() * sizeof(u32)));
+}
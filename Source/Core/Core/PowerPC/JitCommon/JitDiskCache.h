@@ -0,0 +1,95 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Persistent record of the blocks a game made the JIT compile. Only used along with tiered
+// compilation, since all it does is pre-warm blocks which were hot in earlier runs.
+//
+// Emitted host code can't be reused across runs, since it embeds absolute pointers (JitBlock
+// profiling data, the const pool, trampolines, asm routines) and the fastmem backpatching state
+// lives outside of it. Instead, this cache stores the guest side of every block: its addresses,
+// the MSR bits it was compiled under, the physical addresses of the instructions it covers and a
+// hash of those instructions. A block is only looked up when the dispatcher reaches it. If its
+// guest code is unchanged, it was hot in an earlier run, so the JIT compiles it right away instead
+// of interpreting it until it warms up again (see Jit64::InterpretColdBlock).
+//
+// Blocks are always compiled from the current guest memory, so a stale or colliding entry can only
+// cost compilation time, never correctness.
+
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+
+struct JitBlock;
+
+namespace Memory
+{
+class MemoryManager;
+}
+
+struct JitDiskCacheKey
+{
+  u32 effective_address;
+  u32 physical_address;
+  u32 msr_bits;
+  u32 num_instructions;
+  u64 code_hash;
+};
+
+class JitDiskCache
+{
+public:
+  struct Entry
+  {
+    JitDiskCacheKey key;
+    std::vector<u32> physical_addresses;
+  };
+
+  // Loads the cache of the given game, creating it if it doesn't exist yet.
+  void Open(const std::string& game_id);
+  void Close();
+  bool IsOpen() const { return m_is_open; }
+  const std::string& GetGameID() const { return m_game_id; }
+
+  // Remembers a block which has just been compiled.
+  void RecordBlock(const JitBlock& block, Memory::MemoryManager& memory);
+
+  // Returns the block which was recorded in an earlier run with these addresses and MSR bits, if
+  // there is one. Its guest code may have changed since, which Matches checks.
+  const Entry* Find(u32 effective_address, u32 physical_address, u32 msr_bits) const;
+
+  // Checks whether the guest code of an entry is still the same as when it was recorded.
+  static bool Matches(const Entry& entry, Memory::MemoryManager& memory);
+
+  // Counts a block which got compiled right away thanks to an entry. Logged when the cache is
+  // closed, to tell how much interpretation the cache saved.
+  void CountPrewarmedBlock() { ++m_prewarmed_blocks; }
+
+private:
+  class Reader;
+
+  using BlockID = std::tuple<u32, u32, u32>;  // effective address, physical address, MSR bits
+
+  static std::optional<u64> HashCode(const std::vector<u32>& physical_addresses,
+                                     Memory::MemoryManager& memory);
+
+  Common::LinearDiskCache<JitDiskCacheKey, u32> m_disk_cache;
+
+  // Hashes of all blocks which are in the file, to avoid appending duplicates
+  std::map<BlockID, u64> m_known_blocks;
+
+  // Entries loaded from the file
+  std::map<BlockID, Entry> m_entries;
+
+  std::string m_game_id;
+  bool m_is_open = false;
+
+  u32 m_prewarmed_blocks = 0;
+  u32 m_appended_blocks = 0;
+};
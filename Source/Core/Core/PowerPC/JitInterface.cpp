@@ -23,6 +23,7 @@
 #include "Common/MsgHandler.h"
 
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/CPUCoreBase.h"
 #include "Core/PowerPC/CachedInterpreter/CachedInterpreter.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
@@ -195,6 +196,10 @@ JitInterface::GetHostCode(u32 address) const
 
 bool JitInterface::HandleFault(uintptr_t access_address, SContext* ctx)
 {
+  // Writes to pages that are write-protected for dirty page tracking are not the JIT's business
+  if (m_system.GetMemory().HandleWriteTrackingFault(access_address))
+    return true;
+
   // Prevent nullptr dereference on a crash with no JIT present
   if (!m_jit)
   {
@@ -9,6 +9,7 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <utility>
@@ -40,6 +41,8 @@
 #include "Core/Movie.h"
 #include "Core/NetPlayClient.h"
 #include "Core/PowerPC/PowerPC.h"
+#include "Core/StateCompression.h"
+#include "Core/StateRewind.h"
 #include "Core/System.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
@@ -58,13 +61,9 @@ static const u32 IN_LEN = 128 * 1024u;
 
 static const u32 OUT_LEN = IN_LEN + (IN_LEN / 16) + 64 + 3;
 
+// Only used for loading states that were saved with the legacy LZO format.
 static unsigned char __LZO_MMODEL out[OUT_LEN];
 
-#define HEAP_ALLOC(var, size)                                                                      \
-  lzo_align_t __LZO_MMODEL var[((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t)]
-
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
-
 static AfterLoadCallbackFunc s_on_after_load_callback;
 
 // Temporary undo state buffer
@@ -96,7 +95,7 @@ static size_t s_state_writes_in_queue;
 static std::condition_variable s_state_write_queue_is_empty;
 
 // Don't forget to increase this after doing changes on the savestate system
-constexpr u32 STATE_VERSION = 162;  // Last changed in PR 11767
+constexpr u32 STATE_VERSION = 163;  // Last changed for incremental memory states
 
 // Maps savestate versions to Dolphin versions.
 // Versions after 42 don't need to be added to this list,
@@ -384,37 +383,15 @@ static void CompressAndDumpState(CompressAndDumpState_args& save_args)
   header.size = s_use_compression ? (u32)buffer_size : 0;
   header.time = GetSystemTimeAsDouble();
 
+  header.compression_type = StateCompressionType::ChunkedZstd;
+
   f.WriteArray(&header, 1);
 
   if (header.size != 0)  // non-zero header size means the state is compressed
   {
-    lzo_uint i = 0;
-    while (true)
-    {
-      lzo_uint32 cur_len = 0;
-      lzo_uint out_len = 0;
-
-      if ((i + IN_LEN) >= buffer_size)
-      {
-        cur_len = (lzo_uint32)(buffer_size - i);
-      }
-      else
-      {
-        cur_len = IN_LEN;
-      }
-
-      if (lzo1x_1_compress(buffer_data + i, cur_len, out, &out_len, wrkmem) != LZO_E_OK)
-        PanicAlertFmtT("Internal LZO Error - compression failed");
-
-      // The size of the data to write is 'out_len'
-      f.WriteArray((lzo_uint32*)&out_len, 1);
-      f.WriteBytes(out, out_len);
-
-      if (cur_len != IN_LEN)
-        break;
-
-      i += cur_len;
-    }
+    const std::vector<u8> compressed =
+        CompressChunked({buffer_data, buffer_size}, SLOT_COMPRESSION_LEVEL);
+    f.WriteBytes(compressed.data(), compressed.size());
   }
   else  // uncompressed
   {
@@ -594,7 +571,28 @@ static void LoadFileStateData(const std::string& filename, std::vector<u8>& ret_
 
   std::vector<u8> buffer;
 
-  if (header.size != 0)  // non-zero size means the state is compressed
+  if (header.size != 0 && header.compression_type == StateCompressionType::ChunkedZstd)
+  {
+    Core::DisplayMessage("Decompressing State...", 500);
+
+    std::vector<u8> compressed(static_cast<size_t>(f.GetSize() - sizeof(StateHeader)));
+    if (!f.ReadBytes(compressed.data(), compressed.size()))
+    {
+      PanicAlertFmt("Error reading bytes: {0}", compressed.size());
+      return;
+    }
+
+    std::optional<std::vector<u8>> decompressed = DecompressChunked(compressed, header.size);
+    if (!decompressed)
+    {
+      PanicAlertFmtT("Internal Zstandard Error - decompression failed\n"
+                     "The savestate may be corrupted");
+      return;
+    }
+
+    buffer = std::move(*decompressed);
+  }
+  else if (header.size != 0)  // legacy LZO compressed state
   {
     Core::DisplayMessage("Decompressing State...", 500);
 
@@ -736,11 +734,14 @@ void Init()
     if (args.state_write_done_event)
       args.state_write_done_event->Set();
   });
+
+  InitRewind();
 }
 
 void Shutdown()
 {
   s_save_thread.Shutdown();
+  ShutdownRewind();
 
   // swapping with an empty vector, rather than clear()ing
   // this gives a better guarantee to free the allocated memory right NOW (as opposed to, actually,
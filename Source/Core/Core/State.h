@@ -17,10 +17,20 @@ namespace State
 // number of states
 static const u32 NUM_STATES = 10;
 
+// Compression used for the data following the StateHeader.
+// Only relevant if StateHeader::size is non-zero, otherwise the state is uncompressed.
+enum class StateCompressionType : u16
+{
+  // Used by all states created before the chunked format was introduced
+  LZO = 0,
+  // See StateCompression.h
+  ChunkedZstd = 1,
+};
+
 struct StateHeader
 {
   char gameID[6];
-  u16 reserved1;
+  StateCompressionType compression_type;
   u32 size;
   u32 reserved2;
   double time;
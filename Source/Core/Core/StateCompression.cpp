@@ -0,0 +1,232 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateCompression.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <mutex>
+
+#include <zstd.h>
+
+#include "Common/Assert.h"
+#include "Common/CPUDetect.h"
+#include "Common/Logging/Log.h"
+#include "Common/ThreadPool.h"
+
+namespace State
+{
+namespace
+{
+// Savestates are compressed by the save thread and rewind snapshots by the rewind thread, so
+// the pool can be asked for by two threads at once.
+class StateCompressionPool
+{
+public:
+  StateCompressionPool()
+  {
+    m_pool.Start(static_cast<u32>(std::clamp(cpu_info.num_cores - 1, 0, 7)),
+                 "State Compression");
+  }
+
+  // Runs function(i) for every i in [0, count). Returns false if any invocation returned false.
+  bool ParallelFor(size_t count, const std::function<bool(size_t)>& function)
+  {
+    std::atomic<bool> success = true;
+    const auto run = [&](u32 i) {
+      if (success.load(std::memory_order_relaxed) && !function(i))
+        success.store(false, std::memory_order_relaxed);
+    };
+
+    // ThreadPool::ParallelFor can only be used by one thread at a time
+    std::unique_lock lk(m_mutex, std::try_to_lock);
+    if (lk.owns_lock())
+    {
+      m_pool.ParallelFor(static_cast<u32>(count), run);
+    }
+    else
+    {
+      for (u32 i = 0; i < count; ++i)
+        run(i);
+    }
+
+    return success.load(std::memory_order_relaxed);
+  }
+
+private:
+  Common::ThreadPool m_pool;
+  std::mutex m_mutex;
+};
+
+bool ParallelForEachChunk(size_t count, const std::function<bool(size_t)>& function)
+{
+  static StateCompressionPool pool;
+  return pool.ParallelFor(count, function);
+}
+}  // Anonymous namespace
+
+std::vector<u8> CompressChunked(std::span<const u8> data, int compression_level, u32 chunk_size)
+{
+  ASSERT(chunk_size != 0);
+
+  const size_t num_chunks = (data.size() + chunk_size - 1) / chunk_size;
+
+  std::vector<std::vector<u8>> compressed_chunks(num_chunks);
+  ParallelForEachChunk(num_chunks, [&](size_t i) {
+    const size_t offset = i * chunk_size;
+    const size_t size = std::min<size_t>(chunk_size, data.size() - offset);
+
+    std::vector<u8>& out = compressed_chunks[i];
+    out.resize(ZSTD_compressBound(size));
+    const size_t result =
+        ZSTD_compress(out.data(), out.size(), data.data() + offset, size, compression_level);
+
+    if (ZSTD_isError(result) || result >= size)
+    {
+      // Store incompressible (or failed) chunks as-is
+      out.assign(data.begin() + offset, data.begin() + offset + size);
+    }
+    else
+    {
+      out.resize(result);
+    }
+    return true;
+  });
+
+  const size_t index_size = num_chunks * sizeof(ChunkedStateIndexEntry);
+  size_t total_size = sizeof(ChunkedStateHeader) + index_size;
+  for (const std::vector<u8>& chunk : compressed_chunks)
+    total_size += chunk.size();
+
+  std::vector<u8> result(total_size);
+
+  ChunkedStateHeader header;
+  header.magic = CHUNKED_STATE_MAGIC;
+  header.version = CHUNKED_STATE_VERSION;
+  header.uncompressed_size = data.size();
+  header.chunk_size = chunk_size;
+  header.num_chunks = static_cast<u32>(num_chunks);
+  std::memcpy(result.data(), &header, sizeof(header));
+
+  u8* index_ptr = result.data() + sizeof(ChunkedStateHeader);
+  u8* data_ptr = index_ptr + index_size;
+  u64 data_offset = 0;
+  for (size_t i = 0; i < num_chunks; ++i)
+  {
+    const std::vector<u8>& chunk = compressed_chunks[i];
+
+    ChunkedStateIndexEntry entry;
+    entry.offset = data_offset;
+    entry.compressed_size = static_cast<u32>(chunk.size());
+    entry.uncompressed_size =
+        static_cast<u32>(std::min<size_t>(chunk_size, data.size() - i * chunk_size));
+    std::memcpy(index_ptr + i * sizeof(entry), &entry, sizeof(entry));
+
+    std::memcpy(data_ptr + data_offset, chunk.data(), chunk.size());
+    data_offset += chunk.size();
+  }
+
+  return result;
+}
+
+static std::optional<ChunkedStateHeader> ReadChunkedHeader(std::span<const u8> data)
+{
+  if (data.size() < sizeof(ChunkedStateHeader))
+    return std::nullopt;
+
+  ChunkedStateHeader header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if (header.magic != CHUNKED_STATE_MAGIC || header.version != CHUNKED_STATE_VERSION ||
+      header.chunk_size == 0)
+  {
+    return std::nullopt;
+  }
+
+  // Rounded up without adding chunk_size - 1 first, which could overflow
+  const u64 expected_chunks = header.uncompressed_size / header.chunk_size +
+                              (header.uncompressed_size % header.chunk_size != 0 ? 1 : 0);
+  if (header.num_chunks != expected_chunks)
+    return std::nullopt;
+
+  return header;
+}
+
+std::optional<u64> GetChunkedUncompressedSize(std::span<const u8> data)
+{
+  const std::optional<ChunkedStateHeader> header = ReadChunkedHeader(data);
+  if (!header)
+    return std::nullopt;
+  return header->uncompressed_size;
+}
+
+std::optional<std::vector<u8>> DecompressChunked(std::span<const u8> data, u64 expected_size)
+{
+  const std::optional<ChunkedStateHeader> header = ReadChunkedHeader(data);
+  if (!header)
+  {
+    ERROR_LOG_FMT(CORE, "Invalid chunked savestate header");
+    return std::nullopt;
+  }
+
+  // The size in the header is only used after checking it, so that a corrupt header can't make
+  // the output buffer arbitrarily large
+  if (header->uncompressed_size != expected_size)
+  {
+    ERROR_LOG_FMT(CORE, "Chunked savestate has size {}, expected {}", header->uncompressed_size,
+                  expected_size);
+    return std::nullopt;
+  }
+
+  const size_t index_size = size_t(header->num_chunks) * sizeof(ChunkedStateIndexEntry);
+  if (data.size() - sizeof(ChunkedStateHeader) < index_size)
+    return std::nullopt;
+
+  std::vector<ChunkedStateIndexEntry> index(header->num_chunks);
+  std::memcpy(index.data(), data.data() + sizeof(ChunkedStateHeader), index_size);
+
+  const std::span<const u8> chunk_data = data.subspan(sizeof(ChunkedStateHeader) + index_size);
+
+  // Validate the whole index up front so that the workers can't write out of bounds
+  for (size_t i = 0; i < index.size(); ++i)
+  {
+    const ChunkedStateIndexEntry& entry = index[i];
+    const u64 expected_size =
+        std::min<u64>(header->chunk_size, header->uncompressed_size - i * header->chunk_size);
+    if (entry.uncompressed_size != expected_size || entry.offset > chunk_data.size() ||
+        entry.compressed_size > chunk_data.size() - entry.offset)
+    {
+      ERROR_LOG_FMT(CORE, "Invalid index entry {} in chunked savestate", i);
+      return std::nullopt;
+    }
+  }
+
+  std::vector<u8> result(header->uncompressed_size);
+  const bool success = ParallelForEachChunk(index.size(), [&](size_t i) {
+    const ChunkedStateIndexEntry& entry = index[i];
+    u8* out = result.data() + i * header->chunk_size;
+    const u8* in = chunk_data.data() + entry.offset;
+
+    if (entry.compressed_size == entry.uncompressed_size)
+    {
+      std::memcpy(out, in, entry.uncompressed_size);
+      return true;
+    }
+
+    const size_t decompressed_size =
+        ZSTD_decompress(out, entry.uncompressed_size, in, entry.compressed_size);
+    if (ZSTD_isError(decompressed_size) || decompressed_size != entry.uncompressed_size)
+    {
+      ERROR_LOG_FMT(CORE, "Failed to decompress chunk {} of chunked savestate", i);
+      return false;
+    }
+    return true;
+  });
+
+  if (!success)
+    return std::nullopt;
+
+  return result;
+}
+}  // namespace State
@@ -0,0 +1,59 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Chunked, multithreaded compression for savestate buffers.
+//
+// The buffer produced by PointerWrap is split into fixed-size chunks which are compressed
+// independently with Zstandard. An index of all chunks is stored in front of the compressed data,
+// which lets the decompressor locate every chunk without parsing the stream and decompress them
+// in parallel.
+
+#pragma once
+
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+// Compression levels used for the different kinds of states. Slots favor ratio since they are
+// written on a background thread and persist on disk, while in-memory snapshots favor speed.
+constexpr int SLOT_COMPRESSION_LEVEL = 3;
+constexpr int FAST_COMPRESSION_LEVEL = -4;
+
+constexpr u32 CHUNKED_STATE_MAGIC = 0x5A435344;  // "DSCZ"
+constexpr u32 CHUNKED_STATE_VERSION = 1;
+constexpr u32 DEFAULT_STATE_CHUNK_SIZE = 1024 * 1024;
+
+struct ChunkedStateHeader
+{
+  u32 magic;
+  u32 version;
+  u64 uncompressed_size;
+  u32 chunk_size;
+  u32 num_chunks;
+};
+static_assert(sizeof(ChunkedStateHeader) == 24);
+
+// A chunk whose compressed_size equals its uncompressed_size is stored without compression.
+struct ChunkedStateIndexEntry
+{
+  u64 offset;  // Relative to the end of the index
+  u32 compressed_size;
+  u32 uncompressed_size;
+};
+static_assert(sizeof(ChunkedStateIndexEntry) == 16);
+
+// Returns the compressed representation of data, including header and chunk index.
+std::vector<u8> CompressChunked(std::span<const u8> data, int compression_level,
+                                u32 chunk_size = DEFAULT_STATE_CHUNK_SIZE);
+
+// Decompresses a buffer produced by CompressChunked. Returns std::nullopt if the data is corrupt
+// or doesn't decompress to expected_size bytes.
+std::optional<std::vector<u8>> DecompressChunked(std::span<const u8> data, u64 expected_size);
+
+// Returns the uncompressed size stored in the header, or std::nullopt if the header is invalid.
+std::optional<u64> GetChunkedUncompressedSize(std::span<const u8> data);
+}  // namespace State
@@ -0,0 +1,386 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/StateRewind.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/Timer.h"
+#include "Common/WorkQueueThread.h"
+
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/Movie.h"
+#include "Core/NetPlayClient.h"
+#include "Core/State.h"
+#include "Core/StateCompression.h"
+#include "Core/System.h"
+
+#include "VideoCommon/OnScreenDisplay.h"
+
+namespace State
+{
+// Number of snapshots between two keyframes (including the keyframe itself)
+constexpr u32 KEYFRAME_INTERVAL = 16;
+
+// If the worker falls this many snapshots behind, new snapshots are skipped instead of queued
+constexpr size_t MAX_PENDING_SNAPSHOTS = 2;
+
+struct PendingSnapshot
+{
+  std::vector<u8> buffer;
+  u64 frame;
+  u64 capture_time_us;
+  bool keyframe;
+  // Only contains the memory pages written to since the keyframe (see Memory::MemoryStateMode),
+  // so it has to be loaded on top of the keyframe instead of being XORed with it.
+  bool incremental;
+};
+
+struct RewindEntry
+{
+  u64 frame;
+  u64 keyframe_id;
+  bool keyframe;
+  bool incremental;
+  size_t uncompressed_size;
+  std::vector<u8> data;
+};
+
+// Protects everything below except for the worker-only state
+static std::mutex s_rewind_mutex;
+static std::deque<RewindEntry> s_entries;
+static size_t s_memory_usage = 0;
+static size_t s_pending_snapshots = 0;
+static u64 s_snapshots_dropped = 0;
+static bool s_force_keyframe = true;
+static RewindSnapshotInfo s_last_snapshot;
+// Recycled serialization buffers, so that the CPU thread doesn't have to allocate every snapshot
+static std::vector<std::vector<u8>> s_free_buffers;
+
+// Only accessed on the worker thread, or while the worker thread is idle. The uncompressed copy
+// of the last keyframe counts towards s_memory_usage like the entries do.
+static std::vector<u8> s_last_keyframe;
+static u64 s_last_keyframe_id = 0;
+
+// Only accessed on the CPU thread, or by ClearRewindBuffer once emulation has stopped
+static u64 s_frame_counter = 0;
+static u64 s_frames_since_snapshot = 0;
+static u32 s_snapshots_since_keyframe = 0;
+static bool s_write_tracking_was_enabled = false;
+static u32 s_write_tracking_epoch = 0;
+
+static Common::WorkQueueThread<PendingSnapshot> s_rewind_thread;
+
+// XORs the overlapping part of data with reference. The XOR is its own inverse,
+// so this is used for both encoding and decoding.
+static void XorWithReference(std::vector<u8>& data, const std::vector<u8>& reference)
+{
+  const size_t size = std::min(data.size(), reference.size());
+  for (size_t i = 0; i < size; ++i)
+    data[i] ^= reference[i];
+}
+
+static size_t GetMemoryBudget()
+{
+  return size_t(Config::Get(Config::MAIN_REWIND_MEMORY_BUDGET_MB)) * 1024 * 1024;
+}
+
+// Must be called on the worker thread with s_rewind_mutex held
+static void EvictOverBudget()
+{
+  const size_t budget = GetMemoryBudget();
+  while (s_memory_usage > budget && !s_entries.empty())
+  {
+    // Deltas are useless without their keyframe, so evict whole keyframe groups
+    const u64 keyframe_id = s_entries.front().keyframe_id;
+    while (!s_entries.empty() && s_entries.front().keyframe_id == keyframe_id)
+    {
+      s_memory_usage -= s_entries.front().data.size();
+      s_entries.pop_front();
+      ++s_snapshots_dropped;
+    }
+
+    // Nothing refers to the last keyframe anymore, so its copy can go too
+    if (keyframe_id == s_last_keyframe_id)
+    {
+      s_memory_usage -= s_last_keyframe.size();
+      std::vector<u8>().swap(s_last_keyframe);
+      s_force_keyframe = true;
+    }
+  }
+}
+
+static void EncodeSnapshot(PendingSnapshot snapshot)
+{
+  const u64 start_us = Common::Timer::NowUs();
+  const bool keyframe = snapshot.keyframe;
+
+  RewindEntry entry;
+  entry.frame = snapshot.frame;
+  entry.keyframe = keyframe;
+  entry.incremental = snapshot.incremental;
+  entry.uncompressed_size = snapshot.buffer.size();
+  const size_t previous_keyframe_size = s_last_keyframe.size();
+
+  if (keyframe)
+  {
+    entry.data = CompressChunked(snapshot.buffer, FAST_COMPRESSION_LEVEL);
+    std::swap(s_last_keyframe, snapshot.buffer);
+    ++s_last_keyframe_id;
+  }
+  else
+  {
+    if (!snapshot.incremental)
+      XorWithReference(snapshot.buffer, s_last_keyframe);
+    entry.data = CompressChunked(snapshot.buffer, FAST_COMPRESSION_LEVEL);
+  }
+  entry.keyframe_id = s_last_keyframe_id;
+
+  RewindSnapshotInfo info;
+  info.frame = entry.frame;
+  info.keyframe = keyframe;
+  info.incremental = entry.incremental;
+  info.uncompressed_size = entry.uncompressed_size;
+  info.compressed_size = entry.data.size();
+  info.capture_time_us = snapshot.capture_time_us;
+  info.encode_time_us = Common::Timer::NowUs() - start_us;
+
+  DEBUG_LOG_FMT(CORE,
+                "Rewind snapshot at frame {} ({}): {} -> {} bytes, capture {} us, encode {} us",
+                info.frame,
+                keyframe ? "keyframe" : (info.incremental ? "incremental delta" : "delta"),
+                info.uncompressed_size, info.compressed_size, info.capture_time_us,
+                info.encode_time_us);
+
+  std::lock_guard lk(s_rewind_mutex);
+  s_memory_usage += entry.data.size() + s_last_keyframe.size() - previous_keyframe_size;
+  s_entries.push_back(std::move(entry));
+  s_last_snapshot = info;
+  --s_pending_snapshots;
+  EvictOverBudget();
+
+  // Hand the buffer back to the CPU thread for the next snapshot
+  snapshot.buffer.clear();
+  s_free_buffers.push_back(std::move(snapshot.buffer));
+}
+
+// Drops all snapshots. Must not be called while the CPU thread is running.
+static void ClearRewindBuffer()
+{
+  s_rewind_thread.WaitForCompletion();
+
+  std::lock_guard lk(s_rewind_mutex);
+  s_entries.clear();
+  s_memory_usage = 0;
+  s_pending_snapshots = 0;
+  s_snapshots_dropped = 0;
+  s_force_keyframe = true;
+  s_last_snapshot = {};
+  std::vector<u8>().swap(s_last_keyframe);
+  s_snapshots_since_keyframe = 0;
+  s_frames_since_snapshot = 0;
+  s_write_tracking_was_enabled = false;
+}
+
+void InitRewind()
+{
+  s_rewind_thread.Reset("Rewind Worker", EncodeSnapshot);
+}
+
+void ShutdownRewind()
+{
+  s_rewind_thread.Shutdown(true);
+  ClearRewindBuffer();
+
+  std::lock_guard lk(s_rewind_mutex);
+  std::vector<std::vector<u8>>().swap(s_free_buffers);
+}
+
+// Returns whether snapshots can be made incremental. Must be called on the CPU thread.
+// Write tracking itself is turned on and off by Core::FrameUpdateOnCPUThread.
+static bool UpdateWriteTracking()
+{
+  const auto& memory = Core::System::GetInstance().GetMemory();
+  const bool enabled = memory.IsWriteTrackingEnabled();
+  const u32 epoch = memory.GetWriteTrackingEpoch();
+
+  if (enabled == s_write_tracking_was_enabled && epoch == s_write_tracking_epoch)
+    return enabled;
+
+  s_write_tracking_was_enabled = enabled;
+  s_write_tracking_epoch = epoch;
+
+  // Either way, the next snapshot needs a new baseline
+  std::lock_guard lk(s_rewind_mutex);
+  s_force_keyframe = true;
+  return enabled;
+}
+
+void RewindFrameUpdate()
+{
+  ++s_frame_counter;
+
+  // Rewinding is disabled during movies, so don't spend time and memory on snapshots then
+  if (!Config::Get(Config::MAIN_REWIND_ENABLED) || NetPlay::IsNetPlayRunning() ||
+      Movie::IsMovieActive())
+  {
+    return;
+  }
+
+  const u32 frame_interval = std::max<u32>(1, Config::Get(Config::MAIN_REWIND_FRAME_INTERVAL));
+  if (++s_frames_since_snapshot < frame_interval)
+    return;
+
+  const bool incremental = UpdateWriteTracking();
+
+  PendingSnapshot snapshot;
+  {
+    std::lock_guard lk(s_rewind_mutex);
+    if (s_pending_snapshots >= MAX_PENDING_SNAPSHOTS)
+      return;
+    ++s_pending_snapshots;
+
+    if (!s_free_buffers.empty())
+    {
+      snapshot.buffer = std::move(s_free_buffers.back());
+      s_free_buffers.pop_back();
+    }
+
+    snapshot.keyframe = s_force_keyframe || s_snapshots_since_keyframe >= KEYFRAME_INTERVAL;
+    s_force_keyframe = false;
+  }
+  s_frames_since_snapshot = 0;
+  s_snapshots_since_keyframe = snapshot.keyframe ? 1 : s_snapshots_since_keyframe + 1;
+  snapshot.incremental = incremental && !snapshot.keyframe;
+
+  auto& memory = Core::System::GetInstance().GetMemory();
+  if (incremental)
+  {
+    memory.SetStateMode(snapshot.keyframe ? Memory::MemoryStateMode::FullBaseline :
+                                            Memory::MemoryStateMode::DirtyPagesOnly);
+  }
+
+  const u64 start_us = Common::Timer::NowUs();
+  SaveToBuffer(snapshot.buffer);
+  snapshot.capture_time_us = Common::Timer::NowUs() - start_us;
+  snapshot.frame = s_frame_counter;
+
+  memory.SetStateMode(Memory::MemoryStateMode::Full);
+
+  s_rewind_thread.Push(std::move(snapshot));
+}
+
+struct DecodedEntry
+{
+  // Incremental entries have to be loaded on top of their keyframe
+  std::optional<std::vector<u8>> keyframe;
+  std::vector<u8> state;
+};
+
+// Must be called with s_rewind_mutex held and the worker thread idle
+static std::optional<std::vector<u8>> DecodeKeyframe(u64 keyframe_id)
+{
+  if (keyframe_id == s_last_keyframe_id && !s_last_keyframe.empty())
+    return s_last_keyframe;
+
+  const auto keyframe_it =
+      std::find_if(s_entries.begin(), s_entries.end(), [keyframe_id](const RewindEntry& e) {
+        return e.keyframe && e.keyframe_id == keyframe_id;
+      });
+  if (keyframe_it == s_entries.end())
+    return std::nullopt;
+
+  return DecompressChunked(keyframe_it->data, keyframe_it->uncompressed_size);
+}
+
+// Must be called with s_rewind_mutex held and the worker thread idle
+static std::optional<DecodedEntry> DecodeEntry(const RewindEntry& entry)
+{
+  std::optional<std::vector<u8>> buffer = DecompressChunked(entry.data, entry.uncompressed_size);
+  if (!buffer)
+    return std::nullopt;
+
+  if (entry.keyframe)
+    return DecodedEntry{std::nullopt, std::move(*buffer)};
+
+  std::optional<std::vector<u8>> keyframe = DecodeKeyframe(entry.keyframe_id);
+  if (!keyframe)
+    return std::nullopt;
+
+  if (entry.incremental)
+    return DecodedEntry{std::move(keyframe), std::move(*buffer)};
+
+  XorWithReference(*buffer, *keyframe);
+  return DecodedEntry{std::nullopt, std::move(*buffer)};
+}
+
+bool Rewind()
+{
+  if (!Core::IsRunning())
+    return false;
+
+  if (Movie::IsMovieActive())
+  {
+    OSD::AddMessage("Rewinding is disabled while a movie is active");
+    return false;
+  }
+
+  bool success = false;
+  Core::RunOnCPUThread(
+      [&success] {
+        s_rewind_thread.WaitForCompletion();
+
+        std::optional<DecodedEntry> decoded;
+        {
+          std::lock_guard lk(s_rewind_mutex);
+          while (!s_entries.empty() && !decoded)
+          {
+            decoded = DecodeEntry(s_entries.back());
+            s_memory_usage -= s_entries.back().data.size();
+            s_entries.pop_back();
+          }
+
+          // Subsequent snapshots need a keyframe that is still around and, when write tracking
+          // is used, a dirty page baseline that matches the state we're about to load
+          s_force_keyframe = true;
+        }
+
+        if (!decoded)
+        {
+          OSD::AddMessage("There is nothing to rewind to");
+          return;
+        }
+
+        if (decoded->keyframe)
+          LoadFromBuffer(*decoded->keyframe);
+        LoadFromBuffer(decoded->state);
+        s_frames_since_snapshot = 0;
+        success = true;
+      },
+      true);
+
+  return success;
+}
+
+RewindStatistics GetRewindStatistics()
+{
+  std::lock_guard lk(s_rewind_mutex);
+
+  RewindStatistics stats;
+  stats.num_snapshots = s_entries.size();
+  stats.memory_usage = s_memory_usage;
+  stats.memory_budget = GetMemoryBudget();
+  stats.snapshots_dropped = s_snapshots_dropped;
+  stats.last_snapshot = s_last_snapshot;
+  return stats;
+}
+}  // namespace State
@@ -0,0 +1,57 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// In-memory rewind buffer.
+//
+// Every few frames a snapshot of the emulated state is taken on the CPU thread. Snapshots are
+// encoded on a background thread: every KEYFRAME_INTERVAL-th snapshot is stored as a compressed
+// keyframe, the others are XORed against the last keyframe before compression, which makes the
+// (mostly unchanged) emulated RAM compress to almost nothing. When memory write tracking is
+// available, non-keyframe snapshots instead only contain the RAM pages written to since the
+// keyframe. The oldest snapshots are dropped once the configured memory budget is exceeded.
+
+#pragma once
+
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+namespace State
+{
+struct RewindSnapshotInfo
+{
+  u64 frame = 0;
+  bool keyframe = false;
+  // Only contains the memory pages written to since the keyframe
+  bool incremental = false;
+  size_t uncompressed_size = 0;
+  size_t compressed_size = 0;
+  // Time spent on the CPU thread serializing the state
+  u64 capture_time_us = 0;
+  // Time spent on the worker thread delta encoding and compressing the state
+  u64 encode_time_us = 0;
+};
+
+struct RewindStatistics
+{
+  size_t num_snapshots = 0;
+  size_t memory_usage = 0;
+  size_t memory_budget = 0;
+  u64 snapshots_dropped = 0;
+  RewindSnapshotInfo last_snapshot;
+};
+
+// Called when emulation starts and stops. Stopping drops all snapshots, so that they are never
+// loaded into a different game.
+void InitRewind();
+void ShutdownRewind();
+
+// Called once per emulated frame on the CPU thread. Takes a snapshot if one is due.
+void RewindFrameUpdate();
+
+// Loads the most recent snapshot and removes it from the buffer.
+// Returns false if there was nothing to rewind to.
+bool Rewind();
+
+RewindStatistics GetRewindStatistics();
+}  // namespace State
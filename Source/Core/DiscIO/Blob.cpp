@@ -214,7 +214,8 @@ u32 SectorReader::ReadChunk(u8* buffer, u64 chunk_num)
   return 0;
 }
 
-std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
+std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename, bool memory_mapped_reads,
+                                             u64 chunk_cache_size)
 {
   File::IOFile file(filename, "rb");
   u32 magic;
@@ -232,17 +233,17 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
   switch (magic)
   {
   case CISO_MAGIC:
-    return CISOFileReader::Create(std::move(file));
+    return CISOFileReader::Create(std::move(file), memory_mapped_reads);
   case GCZ_MAGIC:
     return CompressedBlobReader::Create(std::move(file), filename);
   case TGC_MAGIC:
     return TGCFileReader::Create(std::move(file));
   case WBFS_MAGIC:
-    return WbfsFileReader::Create(std::move(file), filename);
+    return WbfsFileReader::Create(std::move(file), filename, memory_mapped_reads);
   case WIA_MAGIC:
-    return WIAFileReader::Create(std::move(file), filename);
+    return WIAFileReader::Create(std::move(file), filename, chunk_cache_size);
   case RVZ_MAGIC:
-    return RVZFileReader::Create(std::move(file), filename);
+    return RVZFileReader::Create(std::move(file), filename, chunk_cache_size);
   case NFS_MAGIC:
     return NFSFileReader::Create(std::move(file), filename);
   default:
@@ -251,7 +252,7 @@ std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename)
     if (auto split_blob = SplitPlainFileReader::Create(filename))
       return std::move(split_blob);
 
-    return PlainFileReader::Create(std::move(file));
+    return PlainFileReader::Create(std::move(file), memory_mapped_reads);
   }
 }
 
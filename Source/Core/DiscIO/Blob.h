@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/Swap.h"
 
 namespace DiscIO
@@ -75,6 +76,10 @@ public:
   virtual std::string GetCompressionMethod() const = 0;
   virtual std::optional<int> GetCompressionLevel() const = 0;
 
+  // Returns a value which identifies the contents of this file, if the format makes that cheap.
+  // Used for sharing decompressed data between processes (see SharedChunkCache).
+  virtual std::optional<Common::SHA1::Digest> GetContentID() const { return std::nullopt; }
+
   // NOT thread-safe - can't call this from multiple threads.
   virtual bool Read(u64 offset, u64 size, u8* out_ptr) = 0;
   template <typename T>
@@ -188,11 +193,39 @@ private:
   std::array<Cache, CACHE_LINES> m_cache;
 };
 
+// WIA and RVZ files keep this many bytes of recently used decompressed chunks in memory by default.
+constexpr u64 DEFAULT_CHUNK_CACHE_SIZE = 16 * 1024 * 1024;
+
 // Factory function - examines the path to choose the right type of BlobReader, and returns one.
-std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename);
+//
+// memory_mapped_reads makes uncompressed disc images get read through a memory mapping. This makes
+// reads cheaper, but an I/O error while reading a mapped file crashes Dolphin instead of making the
+// read fail, so it's only meant for the disc that's being emulated, and only if the user wants it.
+//
+// chunk_cache_size is how many bytes of decompressed chunks WIA and RVZ files keep in memory (but
+// at least one chunk), so that reads alternating between a few areas of the disc don't decompress
+// the same chunks repeatedly.
+std::unique_ptr<BlobReader> CreateBlobReader(const std::string& filename,
+                                             bool memory_mapped_reads = false,
+                                             u64 chunk_cache_size = DEFAULT_CHUNK_CACHE_SIZE);
 
 using CompressCB = std::function<bool(const std::string& text, float percent)>;
 
+// Where the time was spent during a conversion. The process and compress stages run on several
+// threads at once, so their times are the sum of the time spent on each thread.
+struct ConversionStatistics
+{
+  // Not counting data which was already converted before resuming from a checkpoint
+  u64 bytes_read = 0;
+
+  u64 read_us = 0;
+  // Decryption, hash checking and (for RVZ) packing of junk data
+  u64 process_us = 0;
+  u64 compress_us = 0;
+  u64 write_us = 0;
+  u64 total_us = 0;
+};
+
 bool ConvertToGCZ(BlobReader* infile, const std::string& infile_path,
                   const std::string& outfile_path, u32 sub_type, int sector_size,
                   CompressCB callback);
@@ -201,6 +234,8 @@ bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback);
+                       int chunk_size, bool zstd_dictionary, CompressCB callback,
+                       const std::string& checkpoint_path = {},
+                       ConversionStatistics* statistics = nullptr);
 
 }  // namespace DiscIO
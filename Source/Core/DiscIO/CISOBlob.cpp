@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -13,7 +14,7 @@
 
 namespace DiscIO
 {
-CISOFileReader::CISOFileReader(File::IOFile file) : m_file(std::move(file))
+CISOFileReader::CISOFileReader(File::IOFile file, bool memory_mapped) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
 
@@ -26,15 +27,19 @@ CISOFileReader::CISOFileReader(File::IOFile file) : m_file(std::move(file))
   MapType count = 0;
   for (u32 idx = 0; idx < CISO_MAP_SIZE; ++idx)
     m_ciso_map[idx] = (1 == header.map[idx]) ? count++ : UNUSED_BLOCK_ID;
+
+  // If mapping is disabled or fails, we simply keep using regular reads
+  if (memory_mapped)
+    m_mapping.Map(m_file);
 }
 
-std::unique_ptr<CISOFileReader> CISOFileReader::Create(File::IOFile file)
+std::unique_ptr<CISOFileReader> CISOFileReader::Create(File::IOFile file, bool memory_mapped)
 {
   CISOHeader header;
   if (file.Seek(0, File::SeekOrigin::Begin) && file.ReadArray(&header, 1) &&
       header.magic == CISO_MAGIC)
   {
-    return std::unique_ptr<CISOFileReader>(new CISOFileReader(std::move(file)));
+    return std::unique_ptr<CISOFileReader>(new CISOFileReader(std::move(file), memory_mapped));
   }
 
   return nullptr;
@@ -66,7 +71,14 @@ bool CISOFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
       // calculate the base address
       u64 const file_off = CISO_HEADER_SIZE + m_ciso_map[block] * (u64)m_block_size + data_offset;
 
-      if (!(m_file.Seek(file_off, File::SeekOrigin::Begin) &&
+      if (m_mapping.IsMapped())
+      {
+        if (file_off + bytes_to_read > m_mapping.GetSize())
+          return false;
+
+        std::memcpy(out_ptr, m_mapping.GetData() + file_off, bytes_to_read);
+      }
+      else if (!(m_file.Seek(file_off, File::SeekOrigin::Begin) &&
             m_file.ReadArray(out_ptr, bytes_to_read)))
       {
         m_file.ClearError();
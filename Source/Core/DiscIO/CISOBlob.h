@@ -9,6 +9,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
@@ -33,7 +34,7 @@ struct CISOHeader
 class CISOFileReader : public BlobReader
 {
 public:
-  static std::unique_ptr<CISOFileReader> Create(File::IOFile file);
+  static std::unique_ptr<CISOFileReader> Create(File::IOFile file, bool memory_mapped = false);
 
   BlobType GetBlobType() const override { return BlobType::CISO; }
 
@@ -49,12 +50,13 @@ public:
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
 
 private:
-  CISOFileReader(File::IOFile file);
+  CISOFileReader(File::IOFile file, bool memory_mapped);
 
   typedef u16 MapType;
   static const MapType UNUSED_BLOCK_ID = UINT16_MAX;
 
   File::IOFile m_file;
+  File::MappedFile m_mapping;
   u64 m_size;
   u32 m_block_size;
   MapType m_ciso_map[CISO_MAP_SIZE];
@@ -20,14 +20,17 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/FileUtil.h"
 #include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/DecompressionPool.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/MultithreadedCompressor.h"
+#include "DiscIO/SharedChunkCache.h"
 #include "DiscIO/Volume.h"
 
 namespace DiscIO
@@ -49,6 +52,14 @@ CompressedBlobReader::CompressedBlobReader(File::IOFile file, const std::string&
   m_hashes.resize(m_header.num_blocks);
   m_file.ReadArray(m_hashes.data(), m_header.num_blocks);
 
+  // The hashes cover the compressed data of every block, so this identifies the whole file
+  std::unique_ptr<Common::SHA1::Context> context = Common::SHA1::CreateContext();
+  context->Update(reinterpret_cast<const u8*>(&m_header), sizeof(m_header));
+  context->Update(reinterpret_cast<const u8*>(m_block_pointers.data()),
+                  m_block_pointers.size() * sizeof(u64));
+  context->Update(reinterpret_cast<const u8*>(m_hashes.data()), m_hashes.size() * sizeof(u32));
+  m_content_id = context->Finish();
+
   m_data_offset = (sizeof(CompressedBlobHeader)) +
                   (sizeof(u64)) * m_header.num_blocks     // skip block pointers
                   + (sizeof(u32)) * m_header.num_blocks;  // skip hashes
@@ -87,24 +98,70 @@ u64 CompressedBlobReader::GetBlockCompressedSize(u64 block_num) const
   return 0;
 }
 
-bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+bool CompressedBlobReader::Read(u64 offset, u64 size, u8* out_ptr)
 {
-  bool uncompressed = false;
-  u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
-  u64 offset = m_block_pointers[block_num] + m_data_offset;
+  UpdateReadPattern(offset, size);
+  return SectorReader::Read(offset, size, out_ptr);
+}
 
-  if (offset & (1ULL << 63))
+void CompressedBlobReader::UpdateReadPattern(u64 offset, u64 size)
+{
+  if (GetDecompressionThreadCount() == 0 || m_header.block_size == 0 || size == 0)
+    return;
+
+  // A single read of a lot of data is as good as a sequence of reads
+  if (offset == m_last_read_end || size >= PARALLEL_READ_SIZE)
   {
-    if (comp_block_size != m_header.block_size)
-      ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
-    uncompressed = true;
-    offset &= ~(1ULL << 63);
+    m_sequential_reads = std::min(m_sequential_reads + 1, SEQUENTIAL_READS_TO_WIDEN);
+    m_random_reads = 0;
   }
+  else
+  {
+    m_random_reads = std::min(m_random_reads + 1, RANDOM_READS_TO_NARROW);
+    m_sequential_reads = 0;
+  }
+  m_last_read_end = offset + size;
+
+  const bool widened = GetChunkSize() > 1;
+  if (!widened && (m_sequential_reads == SEQUENTIAL_READS_TO_WIDEN || size >= PARALLEL_READ_SIZE))
+    SetChunkSize(std::max<u32>(1, PARALLEL_READ_SIZE / m_header.block_size));
+  else if (widened && m_random_reads == RANDOM_READS_TO_NARROW)
+    SetChunkSize(1);
+}
+
+u64 CompressedBlobReader::GetBlockOffset(u64 block_num) const
+{
+  return (m_block_pointers[block_num] & ~(1ULL << 63)) + m_data_offset;
+}
+
+bool CompressedBlobReader::IsBlockCompressed(u64 block_num) const
+{
+  return !(m_block_pointers[block_num] & (1ULL << 63));
+}
+
+SharedChunkCache::Key CompressedBlobReader::GetSharedCacheKey(u64 block_num) const
+{
+  return SharedChunkCache::Key{m_content_id, SharedChunkCache::DataType::GCZBlock, block_num,
+                               m_header.block_size};
+}
+
+bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
+{
+  SharedChunkCache* shared_cache = SharedChunkCache::GetInstance();
+  if (shared_cache && shared_cache->Get(GetSharedCacheKey(block_num), out_ptr, m_header.block_size))
+    return true;
+
+  return ReadBlockFromFile(block_num, out_ptr);
+}
+
+bool CompressedBlobReader::ReadBlockFromFile(u64 block_num, u8* out_ptr)
+{
+  u32 comp_block_size = (u32)GetBlockCompressedSize(block_num);
 
   // clear unused part of zlib buffer. maybe this can be deleted when it works fully.
   memset(&m_zlib_buffer[comp_block_size], 0, m_zlib_buffer.size() - comp_block_size);
 
-  m_file.Seek(offset, File::SeekOrigin::Begin);
+  m_file.Seek(GetBlockOffset(block_num), File::SeekOrigin::Begin);
   if (!m_file.ReadBytes(m_zlib_buffer.data(), comp_block_size))
   {
     ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
@@ -113,8 +170,72 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
     return false;
   }
 
+  return DecompressBlock(block_num, m_zlib_buffer.data(), comp_block_size, out_ptr);
+}
+
+bool CompressedBlobReader::ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr)
+{
+  if (GetDecompressionThreadCount() == 0 || num_blocks < 2)
+    return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+
+  // Skip past the blocks that other processes have already decompressed. Reads usually continue
+  // where an earlier read left off, so once one block is missing, the rest probably are too.
+  if (SharedChunkCache* shared_cache = SharedChunkCache::GetInstance())
+  {
+    while (num_blocks > 0 &&
+           shared_cache->Get(GetSharedCacheKey(block_num), out_ptr, m_header.block_size))
+    {
+      ++block_num;
+      --num_blocks;
+      out_ptr += m_header.block_size;
+    }
+
+    if (num_blocks == 0)
+      return true;
+    if (num_blocks == 1)
+      return ReadBlockFromFile(block_num, out_ptr);
+  }
+
+  // The compressed blocks are normally stored back to back, so that they can be read with a single
+  // call. If they aren't, fall back to reading them one at a time.
+  const u64 first_offset = GetBlockOffset(block_num);
+  std::vector<u64> offsets_in_buffer(num_blocks);
+  std::vector<u32> compressed_sizes(num_blocks);
+  u64 total_size = 0;
+  for (u64 i = 0; i < num_blocks; ++i)
+  {
+    if (GetBlockOffset(block_num + i) != first_offset + total_size)
+      return SectorReader::ReadMultipleAlignedBlocks(block_num, num_blocks, out_ptr);
+
+    offsets_in_buffer[i] = total_size;
+    compressed_sizes[i] = static_cast<u32>(GetBlockCompressedSize(block_num + i));
+    total_size += compressed_sizes[i];
+  }
+
+  m_multi_block_buffer.resize(total_size);
+  if (!m_file.Seek(first_offset, File::SeekOrigin::Begin) ||
+      !m_file.ReadBytes(m_multi_block_buffer.data(), total_size))
+  {
+    ERROR_LOG_FMT(DISCIO, "The disc image \"{}\" is truncated, some of the data is missing.",
+                  m_file_name);
+    m_file.ClearError();
+    return false;
+  }
+
+  std::vector<u8> failed(num_blocks);
+  ParallelDecompress(static_cast<u32>(num_blocks), [&](u32 i) {
+    failed[i] = !DecompressBlock(block_num + i, m_multi_block_buffer.data() + offsets_in_buffer[i],
+                                 compressed_sizes[i], out_ptr + i * m_header.block_size);
+  });
+
+  return std::find(failed.begin(), failed.end(), true) == failed.end();
+}
+
+bool CompressedBlobReader::DecompressBlock(u64 block_num, const u8* compressed_data,
+                                           u32 compressed_size, u8* out_ptr) const
+{
   // First, check hash.
-  const u32 block_hash = Common::HashAdler32(m_zlib_buffer.data(), comp_block_size);
+  const u32 block_hash = Common::HashAdler32(compressed_data, compressed_size);
   if (block_hash != m_hashes[block_num])
   {
     ERROR_LOG_FMT(DISCIO,
@@ -123,15 +244,18 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
                   m_file_name, block_num, block_hash, m_hashes[block_num]);
   }
 
-  if (uncompressed)
+  if (!IsBlockCompressed(block_num))
   {
-    std::copy(m_zlib_buffer.begin(), m_zlib_buffer.begin() + comp_block_size, out_ptr);
+    if (compressed_size != m_header.block_size)
+      ERROR_LOG_FMT(DISCIO, "Uncompressed block with wrong size");
+
+    std::copy(compressed_data, compressed_data + compressed_size, out_ptr);
   }
   else
   {
     z_stream z = {};
-    z.next_in = m_zlib_buffer.data();
-    z.avail_in = comp_block_size;
+    z.next_in = const_cast<u8*>(compressed_data);
+    z.avail_in = compressed_size;
     if (z.avail_in > m_header.block_size)
     {
       ERROR_LOG_FMT(DISCIO, "Compressed block size is larger than uncompressed block size");
@@ -139,7 +263,9 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
     z.next_out = out_ptr;
     z.avail_out = m_header.block_size;
     inflateInit(&z);
-    int status = inflate(&z, Z_FULL_FLUSH);
+    // Since the whole block gets decompressed at once, Z_FINISH lets zlib skip maintaining
+    // a sliding window, which saves copying all of the output
+    int status = inflate(&z, Z_FINISH);
     u32 uncomp_size = m_header.block_size - z.avail_out;
     if (status != Z_STREAM_END)
     {
@@ -154,6 +280,10 @@ bool CompressedBlobReader::GetBlock(u64 block_num, u8* out_ptr)
       return false;
     }
   }
+
+  if (SharedChunkCache* shared_cache = SharedChunkCache::GetInstance())
+    shared_cache->Insert(GetSharedCacheKey(block_num), out_ptr, m_header.block_size);
+
   return true;
 }
 
@@ -17,8 +17,10 @@
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
 #include "Common/IOFile.h"
 #include "DiscIO/Blob.h"
+#include "DiscIO/SharedChunkCache.h"
 
 namespace DiscIO
 {
@@ -60,20 +62,56 @@ public:
   std::string GetCompressionMethod() const override { return "Deflate"; }
   std::optional<int> GetCompressionLevel() const override { return std::nullopt; }
 
+  std::optional<Common::SHA1::Digest> GetContentID() const override { return m_content_id; }
+
   u64 GetBlockCompressedSize(u64 block_num) const;
   bool GetBlock(u64 block_num, u8* out_ptr) override;
 
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+protected:
+  bool ReadMultipleAlignedBlocks(u64 block_num, u64 num_blocks, u8* out_ptr) override;
+
 private:
   CompressedBlobReader(File::IOFile file, const std::string& filename);
 
+  // Once reads look sequential, SectorReader is made to read several blocks at a time, so that
+  // ReadMultipleAlignedBlocks can decompress them in parallel. Random reads only read one block.
+  void UpdateReadPattern(u64 offset, u64 size);
+
+  u64 GetBlockOffset(u64 block_num) const;
+  bool IsBlockCompressed(u64 block_num) const;
+  SharedChunkCache::Key GetSharedCacheKey(u64 block_num) const;
+  // Like GetBlock, but without looking in SharedChunkCache first
+  bool ReadBlockFromFile(u64 block_num, u8* out_ptr);
+  // Checks the hash of and decompresses a block whose compressed data has already been read.
+  // Doesn't modify any state, so it can be called for several blocks on different threads.
+  bool DecompressBlock(u64 block_num, const u8* compressed_data, u32 compressed_size,
+                       u8* out_ptr) const;
+
   CompressedBlobHeader m_header;
   std::vector<u64> m_block_pointers;
   std::vector<u32> m_hashes;
+  Common::SHA1::Digest m_content_id;
   int m_data_offset;
   File::IOFile m_file;
   u64 m_file_size;
   std::vector<u8> m_zlib_buffer;
+  std::vector<u8> m_multi_block_buffer;
   std::string m_file_name;
+
+  u64 m_last_read_end = 0;
+  u32 m_sequential_reads = 0;
+  u32 m_random_reads = 0;
+
+  // When decompressing in parallel, this much data is read at a time, so that there are
+  // several blocks to spread over the threads
+  static constexpr u32 PARALLEL_READ_SIZE = 0x40000;
+  // How many reads in a row have to continue where the previous one ended before reading
+  // PARALLEL_READ_SIZE at a time, and how many reads elsewhere in a row switch back. Changing the
+  // read size empties SectorReader's cache, so it shouldn't happen for every other read.
+  static constexpr u32 SEQUENTIAL_READS_TO_WIDEN = 2;
+  static constexpr u32 RANDOM_READS_TO_NARROW = 4;
 };
 
 }  // namespace DiscIO
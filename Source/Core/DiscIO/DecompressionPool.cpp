@@ -0,0 +1,61 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/DecompressionPool.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include "Common/CPUDetect.h"
+#include "Common/ThreadPool.h"
+
+namespace DiscIO
+{
+namespace
+{
+class DecompressionPool
+{
+public:
+  DecompressionPool()
+  {
+    m_pool.Start(static_cast<u32>(std::clamp(cpu_info.num_cores - 1, 0, 3)), "Disc Decompression");
+  }
+
+  u32 GetNumWorkers() const { return m_pool.GetNumWorkers(); }
+
+  void ParallelFor(u32 count, const std::function<void(u32)>& func)
+  {
+    // ThreadPool::ParallelFor can only be used by one thread at a time
+    std::unique_lock lk(m_mutex, std::try_to_lock);
+    if (!lk.owns_lock())
+    {
+      for (u32 i = 0; i < count; ++i)
+        func(i);
+      return;
+    }
+
+    m_pool.ParallelFor(count, func);
+  }
+
+private:
+  Common::ThreadPool m_pool;
+  std::mutex m_mutex;
+};
+
+DecompressionPool& GetPool()
+{
+  static DecompressionPool pool;
+  return pool;
+}
+}  // Anonymous namespace
+
+u32 GetDecompressionThreadCount()
+{
+  return GetPool().GetNumWorkers();
+}
+
+void ParallelDecompress(u32 count, const std::function<void(u32)>& func)
+{
+  GetPool().ParallelFor(count, func);
+}
+}  // namespace DiscIO
@@ -0,0 +1,23 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+
+#include "Common/CommonTypes.h"
+
+namespace DiscIO
+{
+// Worker threads for decompressing several blocks of a compressed disc image at once. They are
+// shared by every BlobReader in the process, so that opening more readers (e.g. for prefetching
+// or the game list) doesn't start more threads.
+
+// The number of worker threads. Zero if decompressing in parallel isn't worth it on this host.
+u32 GetDecompressionThreadCount();
+
+// Calls func for every index in [0, count) and returns once all calls have finished. If another
+// reader is using the workers at the moment, all calls are made on the calling thread instead of
+// waiting for them.
+void ParallelDecompress(u32 count, const std::function<void(u32)>& func);
+}  // namespace DiscIO
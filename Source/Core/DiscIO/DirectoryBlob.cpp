@@ -6,20 +6,29 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <filesystem>
+#include <list>
+#include <limits>
 #include <locale>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/ChunkFile.h"
 #include "Common/CommonPaths.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
 #include "Common/StringUtil.h"
@@ -54,10 +63,65 @@ constexpr u32 INVALID_REGION = 0xFF;
 
 constexpr u32 PARTITION_DATA_OFFSET = 0x20000;
 
+// Bump this when the format of the FST index files changes
+constexpr u32 FST_INDEX_REVISION = 3;
+
 constexpr u8 ENTRY_SIZE = 0x0c;
 constexpr u8 FILE_ENTRY = 0;
 constexpr u8 DIRECTORY_ENTRY = 1;
 
+// Opening a host file can be slow (in particular on Android), and games tend to read the same files
+// many times in small pieces, so the most recently read files are kept open.
+class ContentFileHandles final
+{
+public:
+  bool Read(const ContentFile& content, u64 size, u64 offset, u64 length, u8* buffer)
+  {
+    std::lock_guard lk(m_mutex);
+
+    const std::string& path = content.m_filename;
+    auto it = std::find_if(m_files.begin(), m_files.end(),
+                           [&path](const auto& entry) { return entry.first == path; });
+    if (it != m_files.end())
+    {
+      m_files.splice(m_files.begin(), m_files, it);
+    }
+    else
+    {
+      File::IOFile file(path, "rb");
+      if (!file)
+        return false;
+
+      if (content.m_index_path && file.GetSize() != content.m_offset + size)
+      {
+        WARN_LOG_FMT(DISCIO, "{} has changed size since it was indexed, removing {}", path,
+                     *content.m_index_path);
+        File::Delete(*content.m_index_path, File::IfAbsentBehavior::NoConsoleWarning);
+      }
+
+      if (m_files.size() >= MAX_OPEN_FILES)
+        m_files.pop_back();
+      m_files.emplace_front(path, std::move(file));
+    }
+
+    File::IOFile& file = m_files.front().second;
+    if (!file.Seek(offset, File::SeekOrigin::Begin) || !file.ReadBytes(buffer, length))
+    {
+      // IOFile stays in an error state after a failure, so don't keep this handle around
+      m_files.pop_front();
+      return false;
+    }
+
+    return true;
+  }
+
+private:
+  static constexpr size_t MAX_OPEN_FILES = 16;
+
+  std::mutex m_mutex;
+  std::list<std::pair<std::string, File::IOFile>> m_files;
+};
+
 DiscContent::DiscContent(u64 offset, u64 size, ContentSource source)
     : m_offset(offset), m_size(size), m_content_source(std::move(source))
 {
@@ -82,7 +146,8 @@ u64 DiscContent::GetSize() const
   return m_size;
 }
 
-bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
+bool DiscContent::Read(u64* offset, u64* length, u8** buffer,
+                       ContentFileHandles* file_handles) const
 {
   if (m_size == 0)
     return true;
@@ -97,9 +162,8 @@ bool DiscContent::Read(u64* offset, u64* length, u8** buffer) const
     if (std::holds_alternative<ContentFile>(m_content_source))
     {
       const auto& content = std::get<ContentFile>(m_content_source);
-      File::IOFile file(content.m_filename, "rb");
-      if (!file.Seek(content.m_offset + offset_in_content, File::SeekOrigin::Begin) ||
-          !file.ReadBytes(*buffer, bytes_to_read))
+      if (!file_handles->Read(content, m_size, content.m_offset + offset_in_content,
+                              bytes_to_read, *buffer))
       {
         return false;
       }
@@ -174,7 +238,8 @@ u64 DiscContentContainer::CheckSizeAndAdd(u64 offset, u64 max_size, const std::s
   return size;
 }
 
-bool DiscContentContainer::Read(u64 offset, u64 length, u8* buffer) const
+bool DiscContentContainer::Read(u64 offset, u64 length, u8* buffer,
+                                ContentFileHandles* file_handles) const
 {
   // Determine which DiscContent the offset refers to
   std::set<DiscContent>::const_iterator it = m_contents.upper_bound(DiscContent(offset));
@@ -187,7 +252,7 @@ bool DiscContentContainer::Read(u64 offset, u64 length, u8* buffer) const
     if (length == 0)
       return true;
 
-    if (!it->Read(&offset, &length, &buffer))
+    if (!it->Read(&offset, &length, &buffer, file_handles))
       return false;
 
     ++it;
@@ -373,9 +438,11 @@ std::unique_ptr<DirectoryBlobReader> DirectoryBlobReader::Create(
       new DirectoryBlobReader(std::move(volume), sys_callback, fst_callback));
 }
 
+DirectoryBlobReader::~DirectoryBlobReader() = default;
+
 DirectoryBlobReader::DirectoryBlobReader(const std::string& game_partition_root,
                                          const std::string& true_root)
-    : m_encryption_cache(this)
+    : m_content_file_handles(std::make_unique<ContentFileHandles>()), m_encryption_cache(this)
 {
   DirectoryBlobPartition game_partition(game_partition_root, {});
   m_is_wii = game_partition.IsWii();
@@ -422,7 +489,8 @@ DirectoryBlobReader::DirectoryBlobReader(
     const std::function<void(std::vector<FSTBuilderNode>* fst_nodes)>& sys_callback,
     const std::function<void(std::vector<FSTBuilderNode>* fst_nodes, FSTBuilderNode* dol_node)>&
         fst_callback)
-    : m_encryption_cache(this), m_wrapped_volume(std::move(volume))
+    : m_content_file_handles(std::make_unique<ContentFileHandles>()), m_encryption_cache(this),
+      m_wrapped_volume(std::move(volume))
 {
   DirectoryBlobPartition game_partition(m_wrapped_volume.get(),
                                         m_wrapped_volume->GetGamePartition(), std::nullopt,
@@ -481,7 +549,7 @@ bool DirectoryBlobReader::Read(u64 offset, u64 length, u8* buffer)
     return false;
 
   return (m_is_wii ? m_nonpartition_contents : m_gamecube_pseudopartition.GetContents())
-      .Read(offset, length, buffer);
+      .Read(offset, length, buffer, m_content_file_handles.get());
 }
 
 const DirectoryBlobPartition* DirectoryBlobReader::GetPartition(u64 offset, u64 size,
@@ -510,7 +578,7 @@ bool DirectoryBlobReader::ReadWiiDecrypted(u64 offset, u64 size, u8* buffer,
   if (!partition)
     return false;
 
-  return partition->GetContents().Read(offset, size, buffer);
+  return partition->GetContents().Read(offset, size, buffer, m_content_file_handles.get());
 }
 
 bool DirectoryBlobReader::EncryptPartitionData(u64 offset, u64 size, u8* buffer,
@@ -522,7 +590,7 @@ bool DirectoryBlobReader::EncryptPartitionData(u64 offset, u64 size, u8* buffer,
     return false;
 
   if (!m_encrypted)
-    return it->second.GetContents().Read(offset, size, buffer);
+    return it->second.GetContents().Read(offset, size, buffer, m_content_file_handles.get());
 
   return m_encryption_cache.EncryptGroups(offset, size, buffer, partition_data_offset,
                                           partition_data_decrypted_size, it->second.GetKey());
@@ -784,7 +852,7 @@ void DirectoryBlobReader::SetPartitionHeader(DirectoryBlobPartition* partition,
 
   std::vector<u8> ticket_buffer(ticket_size);
   m_nonpartition_contents.Read(partition_address + WII_PARTITION_TICKET_ADDRESS, ticket_size,
-                               ticket_buffer.data());
+                               ticket_buffer.data(), m_content_file_handles.get());
   IOS::ES::TicketReader ticket(std::move(ticket_buffer));
   if (ticket.IsValid())
     partition->SetKey(ticket.GetTitleKey());
@@ -858,7 +926,8 @@ static std::vector<u8> ExtractNodeToVector(std::vector<FSTBuilderNode>* nodes, v
   for (auto& content : it->GetFileContent())
     tmp.Add(content.m_offset, content.m_size, std::move(content.m_source));
   data.resize(it->m_size);
-  tmp.Read(0, it->m_size, data.data());
+  ContentFileHandles file_handles;
+  tmp.Read(0, it->m_size, data.data(), &file_handles);
   return data;
 }
 
@@ -1053,7 +1122,9 @@ u64 DirectoryBlobPartition::SetDOL(FSTBuilderNode dol_node, u64 dol_address)
   return Common::AlignUp(dol_address + dol_node.m_size + 0x20, 0x20ull);
 }
 
-static std::vector<FSTBuilderNode> ConvertFSTEntriesToBuilderNodes(const File::FSTEntry& parent)
+static std::vector<FSTBuilderNode>
+ConvertFSTEntriesToBuilderNodes(const File::FSTEntry& parent,
+                                const std::shared_ptr<const std::string>& index_path)
 {
   std::vector<FSTBuilderNode> nodes;
   nodes.reserve(parent.children.size());
@@ -1062,12 +1133,12 @@ static std::vector<FSTBuilderNode> ConvertFSTEntriesToBuilderNodes(const File::F
     std::variant<std::vector<BuilderContentSource>, std::vector<FSTBuilderNode>> content;
     if (entry.isDirectory)
     {
-      content = ConvertFSTEntriesToBuilderNodes(entry);
+      content = ConvertFSTEntriesToBuilderNodes(entry, index_path);
     }
     else
     {
-      content =
-          std::vector<BuilderContentSource>{{0, entry.size, ContentFile{entry.physicalName, 0}}};
+      content = std::vector<BuilderContentSource>{
+          {0, entry.size, ContentFile{entry.physicalName, 0, index_path}}};
     }
 
     nodes.emplace_back(FSTBuilderNode{entry.virtualName, entry.size, std::move(content)});
@@ -1075,9 +1146,171 @@ static std::vector<FSTBuilderNode> ConvertFSTEntriesToBuilderNodes(const File::F
   return nodes;
 }
 
+static std::optional<s64> GetLastWriteTime(const std::string& path)
+{
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(StringToPath(path), error);
+  if (error)
+    return std::nullopt;
+  return time.time_since_epoch().count();
+}
+
+struct IndexedDirectoryState
+{
+  std::string path;
+  s64 write_time;
+};
+
+// Records the modification time of every directory in the tree. Adding, removing or renaming an
+// entry updates the modification time of the directory it is in, so this can be used to tell
+// whether the layout of a scanned tree is still up to date without scanning it again. Files aren't
+// checked here, as that would cost a stat per file; a file that has changed size is instead caught
+// when it's first opened (see ContentFileHandles).
+static bool GetDirectoryStates(const File::FSTEntry& entry,
+                               std::vector<IndexedDirectoryState>* states)
+{
+  if (!entry.isDirectory)
+    return true;
+
+  const std::optional<s64> time = GetLastWriteTime(entry.physicalName);
+  if (!time)
+    return false;
+  states->push_back({entry.physicalName, *time});
+
+  for (const File::FSTEntry& child : entry.children)
+  {
+    if (!GetDirectoryStates(child, states))
+      return false;
+  }
+
+  return true;
+}
+
+static bool IsDirectoryStateUpToDate(const IndexedDirectoryState& state)
+{
+  return GetLastWriteTime(state.path) == state.write_time;
+}
+
+// Every serialized element takes at least this many bytes (a length-prefixed string and a u64),
+// so an index can't hold more elements in total than its size divided by this. Element counts read
+// from an index are charged against that budget before anything is allocated for them, so that a
+// corrupt index can't make us allocate much more memory than the size of the index file.
+constexpr size_t MIN_INDEX_ELEMENT_SIZE = sizeof(u32) + sizeof(u64);
+
+template <typename T, typename Functor>
+static void DoIndexElements(PointerWrap& p, std::vector<T>& elements, size_t* element_budget,
+                            Functor function)
+{
+  u32 count = static_cast<u32>(elements.size());
+  p.Do(count);
+  if (p.IsReadMode())
+  {
+    if (count > *element_budget)
+    {
+      p.SetMeasureMode();
+      return;
+    }
+    *element_budget -= count;
+  }
+
+  elements.resize(count);
+  for (T& element : elements)
+    function(p, element, element_budget);
+}
+
+static void DoIndexedDirectoryState(PointerWrap& p, IndexedDirectoryState& state, size_t*)
+{
+  p.Do(state.path);
+  p.Do(state.write_time);
+}
+
+static void DoFSTEntry(PointerWrap& p, File::FSTEntry& entry, size_t* element_budget)
+{
+  p.Do(entry.isDirectory);
+  p.Do(entry.size);
+  p.Do(entry.physicalName);
+  p.Do(entry.virtualName);
+  DoIndexElements(p, entry.children, element_budget, DoFSTEntry);
+}
+
+static void DoFSTIndex(PointerWrap& p, size_t element_budget, std::string& root_path,
+                       std::vector<IndexedDirectoryState>& directory_states,
+                       File::FSTEntry& root_entry)
+{
+  u32 revision = FST_INDEX_REVISION;
+  p.Do(revision);
+  if (p.IsReadMode() && revision != FST_INDEX_REVISION)
+  {
+    p.SetMeasureMode();
+    return;
+  }
+
+  p.Do(root_path);
+  DoIndexElements(p, directory_states, &element_budget, DoIndexedDirectoryState);
+  DoFSTEntry(p, root_entry, &element_budget);
+}
+
+// Scanning the files folder of a large extracted game or mod can take seconds, so the result is
+// cached in an index file which is reused for as long as no directory in the tree has been
+// modified.
+static File::FSTEntry ScanDirectoryTreeWithIndex(const std::string& root_path,
+                                                 const std::string& index_path)
+{
+  std::string index_data;
+  if (File::ReadFileToString(index_path, index_data))
+  {
+    std::string index_root_path;
+    std::vector<IndexedDirectoryState> directory_states;
+    File::FSTEntry root_entry;
+
+    u8* ptr = reinterpret_cast<u8*>(index_data.data());
+    PointerWrap p(&ptr, index_data.size(), PointerWrap::Mode::Read);
+    DoFSTIndex(p, index_data.size() / MIN_INDEX_ELEMENT_SIZE, index_root_path, directory_states,
+               root_entry);
+
+    const bool up_to_date = p.IsReadMode() && index_root_path == root_path &&
+                            std::all_of(directory_states.begin(), directory_states.end(),
+                                        IsDirectoryStateUpToDate);
+    if (up_to_date)
+      return root_entry;
+  }
+
+  File::FSTEntry root_entry = File::ScanDirectoryTree(root_path, true);
+
+  std::vector<IndexedDirectoryState> directory_states;
+  if (!GetDirectoryStates(root_entry, &directory_states))
+    return root_entry;
+
+  std::string index_root_path = root_path;
+  // Element counts are only checked when reading
+  constexpr size_t element_budget = std::numeric_limits<size_t>::max();
+
+  u8* ptr = nullptr;
+  PointerWrap p_measure(&ptr, 0, PointerWrap::Mode::Measure);
+  DoFSTIndex(p_measure, element_budget, index_root_path, directory_states, root_entry);
+
+  std::vector<u8> buffer(reinterpret_cast<size_t>(ptr));
+  ptr = buffer.data();
+  PointerWrap p(&ptr, buffer.size(), PointerWrap::Mode::Write);
+  DoFSTIndex(p, element_budget, index_root_path, directory_states, root_entry);
+
+  File::CreateFullPath(index_path);
+  File::IOFile index_file(index_path, "wb");
+  if (!index_file.WriteBytes(buffer.data(), buffer.size()))
+    WARN_LOG_FMT(DISCIO, "Failed to write FST index {}", index_path);
+
+  return root_entry;
+}
+
 void DirectoryBlobPartition::BuildFSTFromFolder(const std::string& fst_root_path, u64 fst_address)
 {
-  auto nodes = ConvertFSTEntriesToBuilderNodes(File::ScanDirectoryTree(fst_root_path, true));
+  auto index_path = std::make_shared<const std::string>(
+      fmt::format("{}DirectoryBlob{}{:016x}.idx", File::GetUserPath(D_CACHE_IDX), DIR_SEP,
+                  Common::GetStableHash64(reinterpret_cast<const u8*>(fst_root_path.data()),
+                                          static_cast<u32>(fst_root_path.size()))));
+
+  auto nodes = ConvertFSTEntriesToBuilderNodes(
+      ScanDirectoryTreeWithIndex(fst_root_path, *index_path), index_path);
   BuildFST(std::move(nodes), fst_address);
 }
 
@@ -30,6 +30,7 @@ namespace DiscIO
 {
 enum class PartitionType : u32;
 
+class ContentFileHandles;
 class DirectoryBlobReader;
 class VolumeDisc;
 
@@ -44,6 +45,10 @@ struct ContentFile
 
   // Offset from the start of the file where the first byte of this content chunk is.
   u64 m_offset = 0;
+
+  // FST index that the size of this file was taken from, if any. File sizes aren't checked when an
+  // index is loaded, so the index gets removed if the file turns out to have changed size.
+  std::shared_ptr<const std::string> m_index_path;
 };
 
 // Content chunk that loads data from a DirectoryBlobReader.
@@ -147,7 +152,7 @@ public:
   u64 GetOffset() const;
   u64 GetEndOffset() const;
   u64 GetSize() const;
-  bool Read(u64* offset, u64* length, u8** buffer) const;
+  bool Read(u64* offset, u64* length, u8** buffer, ContentFileHandles* file_handles) const;
 
   bool operator==(const DiscContent& other) const { return GetEndOffset() == other.GetEndOffset(); }
   bool operator!=(const DiscContent& other) const { return !(*this == other); }
@@ -179,7 +184,7 @@ public:
   u64 CheckSizeAndAdd(u64 offset, const std::string& path);
   u64 CheckSizeAndAdd(u64 offset, u64 max_size, const std::string& path);
 
-  bool Read(u64 offset, u64 length, u8* buffer) const;
+  bool Read(u64 offset, u64 length, u8* buffer, ContentFileHandles* file_handles) const;
 
 private:
   std::set<DiscContent> m_contents;
@@ -271,6 +276,8 @@ public:
       const std::function<void(std::vector<FSTBuilderNode>* fst_nodes, FSTBuilderNode* dol_node)>&
           fst_callback);
 
+  ~DirectoryBlobReader() override;
+
   // We do not allow copying, because it might mess up the pointers inside DiscContents
   DirectoryBlobReader(const DirectoryBlobReader&) = delete;
   DirectoryBlobReader& operator=(const DirectoryBlobReader&) = delete;
@@ -326,6 +333,9 @@ private:
   void SetPartitions(std::vector<PartitionWithType>&& partitions);
   void SetPartitionHeader(DirectoryBlobPartition* partition, u64 partition_address);
 
+  // Host files which were read recently, kept open for further reads
+  std::unique_ptr<ContentFileHandles> m_content_file_handles;
+
   // For GameCube:
   DirectoryBlobPartition m_gamecube_pseudopartition;
 
@@ -55,12 +55,13 @@ bool ExportData(const Volume& volume, const Partition& partition, u64 offset, u6
   if (!f)
     return false;
 
+  // Reading in moderately sized pieces into a reused buffer keeps the reads sequential
+  // (which lets memory-mapped blobs prefetch ahead) without a large allocation per file
+  std::vector<u8> buffer(static_cast<size_t>(std::min<u64>(size, 0x00800000)));
+
   while (size)
   {
-    // Limit read size to 128 MB
-    const size_t read_size = static_cast<size_t>(std::min<u64>(size, 0x08000000));
-
-    std::vector<u8> buffer(read_size);
+    const size_t read_size = static_cast<size_t>(std::min<u64>(size, buffer.size()));
 
     if (!volume.Read(offset, read_size, buffer.data(), partition))
       return false;
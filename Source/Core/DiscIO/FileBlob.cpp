@@ -4,6 +4,7 @@
 #include "DiscIO/FileBlob.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <utility>
@@ -15,21 +16,38 @@
 
 namespace DiscIO
 {
-PlainFileReader::PlainFileReader(File::IOFile file) : m_file(std::move(file))
+// How far ahead of a sequential read the OS is asked to read the file
+static constexpr u64 PREFETCH_SIZE = 8 * 1024 * 1024;
+
+PlainFileReader::PlainFileReader(File::IOFile file, bool memory_mapped) : m_file(std::move(file))
 {
   m_size = m_file.GetSize();
+
+  // If mapping is disabled or fails, we simply keep using regular reads
+  if (memory_mapped)
+    m_mapping.Map(m_file);
 }
 
-std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file)
+std::unique_ptr<PlainFileReader> PlainFileReader::Create(File::IOFile file, bool memory_mapped)
 {
   if (file)
-    return std::unique_ptr<PlainFileReader>(new PlainFileReader(std::move(file)));
+    return std::unique_ptr<PlainFileReader>(new PlainFileReader(std::move(file), memory_mapped));
 
   return nullptr;
 }
 
 bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 {
+  if (m_mapping.IsMapped())
+  {
+    if (offset > m_mapping.GetSize() || nbytes > m_mapping.GetSize() - offset)
+      return false;
+
+    PrefetchAfter(offset, nbytes);
+    std::memcpy(out_ptr, m_mapping.GetData() + offset, nbytes);
+    return true;
+  }
+
   if (m_file.Seek(offset, File::SeekOrigin::Begin) && m_file.ReadBytes(out_ptr, nbytes))
   {
     return true;
@@ -41,6 +59,30 @@ bool PlainFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   }
 }
 
+void PlainFileReader::PrefetchAfter(u64 offset, u64 nbytes)
+{
+  const u64 end = offset + nbytes;
+  const bool sequential = offset == m_last_read_end;
+  m_last_read_end = end;
+
+  if (!sequential)
+  {
+    m_prefetched_until = 0;
+    return;
+  }
+
+  // Only issue a new hint once half of the previously prefetched window has been consumed,
+  // so that small sequential reads don't each cost a system call
+  if (end + PREFETCH_SIZE / 2 <= m_prefetched_until)
+    return;
+
+  const u64 prefetch_start = std::max(end, m_prefetched_until);
+  const u64 prefetch_end = std::min(end + PREFETCH_SIZE, m_mapping.GetSize());
+  if (prefetch_start < prefetch_end)
+    m_mapping.Prefetch(prefetch_start, prefetch_end - prefetch_start);
+  m_prefetched_until = prefetch_end;
+}
+
 bool ConvertToPlain(BlobReader* infile, const std::string& infile_path,
                     const std::string& outfile_path, CompressCB callback)
 {
@@ -9,6 +9,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
@@ -16,7 +17,7 @@ namespace DiscIO
 class PlainFileReader : public BlobReader
 {
 public:
-  static std::unique_ptr<PlainFileReader> Create(File::IOFile file);
+  static std::unique_ptr<PlainFileReader> Create(File::IOFile file, bool memory_mapped = false);
 
   BlobType GetBlobType() const override { return BlobType::PLAIN; }
 
@@ -32,10 +33,17 @@ public:
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
 
 private:
-  PlainFileReader(File::IOFile file);
+  PlainFileReader(File::IOFile file, bool memory_mapped);
+
+  void PrefetchAfter(u64 offset, u64 nbytes);
 
   File::IOFile m_file;
+  File::MappedFile m_mapping;
   u64 m_size;
+
+  // Used for detecting sequential reads so that the data after them can be prefetched
+  u64 m_last_read_end = 0;
+  u64 m_prefetched_until = 0;
 };
 
 }  // namespace DiscIO
@@ -0,0 +1,350 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/PrefetchBlob.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/Logging/Log.h"
+#include "Common/Thread.h"
+#include "DiscIO/Blob.h"
+#include "DiscIO/VolumeWii.h"
+
+namespace DiscIO
+{
+constexpr size_t NUM_WORKERS = 2;
+constexpr u64 MIN_CHUNK_SIZE = 0x20000;
+constexpr u64 CACHE_SIZE = 32 * 1024 * 1024;
+constexpr u64 PREFETCH_SIZE = 8 * 1024 * 1024;
+
+PrefetchBlobReader::PrefetchBlobReader(std::unique_ptr<BlobReader> reader,
+                                       std::vector<std::unique_ptr<BlobReader>> worker_readers)
+    : m_reader(std::move(reader)), m_worker_readers(std::move(worker_readers))
+{
+  // Chunks consist of whole blocks so that no block has to be decompressed twice
+  m_chunk_size = Common::AlignUp(MIN_CHUNK_SIZE, m_reader->GetBlockSize());
+  m_decrypted_chunk_size =
+      std::max<u64>(m_chunk_size / VolumeWii::BLOCK_TOTAL_SIZE, 1) * VolumeWii::BLOCK_DATA_SIZE;
+
+  m_max_chunks = static_cast<size_t>(std::max<u64>(CACHE_SIZE / m_chunk_size, 8));
+  m_prefetch_distance = std::clamp<u64>(PREFETCH_SIZE / m_chunk_size, 2, m_max_chunks / 2);
+
+  for (const std::unique_ptr<BlobReader>& worker_reader : m_worker_readers)
+    m_workers.emplace_back(&PrefetchBlobReader::WorkerThread, this, worker_reader.get());
+}
+
+PrefetchBlobReader::~PrefetchBlobReader()
+{
+  {
+    std::lock_guard lk(m_mutex);
+    m_exit = true;
+  }
+  m_work_available.notify_all();
+
+  for (std::thread& worker : m_workers)
+    worker.join();
+
+  INFO_LOG_FMT(DISCIO,
+               "Disc prefetching: {} hits, {} late hits, {} misses, {} of {} prefetched chunks "
+               "were never read",
+               m_statistics.hits, m_statistics.late_hits, m_statistics.misses,
+               m_statistics.wasted_chunks, m_statistics.prefetched_chunks);
+}
+
+std::unique_ptr<BlobReader> PrefetchBlobReader::Wrap(std::unique_ptr<BlobReader> reader,
+                                                     const std::string& path)
+{
+  // Formats without blocks or with cheap random access are already as fast as they can be
+  if (!reader || reader->GetBlockSize() == 0 || reader->HasFastRandomAccessInBlock())
+    return reader;
+
+  std::vector<std::unique_ptr<BlobReader>> worker_readers;
+  for (size_t i = 0; i < NUM_WORKERS; i++)
+  {
+    std::unique_ptr<BlobReader> worker_reader = CreateBlobReader(path);
+    if (!worker_reader || worker_reader->GetBlobType() != reader->GetBlobType() ||
+        worker_reader->GetDataSize() != reader->GetDataSize())
+    {
+      break;
+    }
+    worker_readers.push_back(std::move(worker_reader));
+  }
+
+  if (worker_readers.empty())
+    return reader;
+
+  return std::unique_ptr<BlobReader>(
+      new PrefetchBlobReader(std::move(reader), std::move(worker_readers)));
+}
+
+bool PrefetchBlobReader::Read(u64 offset, u64 size, u8* out_ptr)
+{
+  if (offset + size > GetDataSize())
+    return m_reader->Read(offset, size, out_ptr);
+
+  return ReadCached(offset, size, out_ptr, NO_PARTITION);
+}
+
+bool PrefetchBlobReader::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
+                                          u64 partition_data_offset)
+{
+  return ReadCached(offset, size, out_ptr, partition_data_offset);
+}
+
+PrefetchStatistics PrefetchBlobReader::GetStatistics() const
+{
+  std::lock_guard lk(m_mutex);
+  return m_statistics;
+}
+
+u64 PrefetchBlobReader::GetChunkSize(u64 partition_data_offset) const
+{
+  return partition_data_offset == NO_PARTITION ? m_chunk_size : m_decrypted_chunk_size;
+}
+
+bool PrefetchBlobReader::CanCacheChunk(const ChunkKey& key) const
+{
+  const auto [partition_data_offset, index] = key;
+  const u64 chunk_size = GetChunkSize(partition_data_offset);
+
+  if (partition_data_offset == NO_PARTITION)
+    return index * chunk_size < GetDataSize();
+
+  return m_reader->SupportsReadWiiDecrypted(index * chunk_size, chunk_size, partition_data_offset);
+}
+
+bool PrefetchBlobReader::ReadChunk(BlobReader& reader, const ChunkKey& key, u64 chunk_size,
+                                   std::vector<u8>* out)
+{
+  const auto [partition_data_offset, index] = key;
+  const u64 offset = index * chunk_size;
+
+  if (partition_data_offset == NO_PARTITION)
+  {
+    out->resize(std::min(chunk_size, reader.GetDataSize() - offset));
+    return reader.Read(offset, out->size(), out->data());
+  }
+
+  out->resize(chunk_size);
+  return reader.ReadWiiDecrypted(offset, chunk_size, out->data(), partition_data_offset);
+}
+
+bool PrefetchBlobReader::ReadCached(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset)
+{
+  std::unique_lock lk(m_mutex);
+
+  UpdateStream(offset, size, partition_data_offset);
+
+  const u64 chunk_size = GetChunkSize(partition_data_offset);
+  while (size > 0)
+  {
+    const ChunkKey key{partition_data_offset, offset / chunk_size};
+    const u64 offset_in_chunk = offset % chunk_size;
+    const u64 bytes_to_read = std::min(chunk_size - offset_in_chunk, size);
+
+    const Chunk* chunk = CanCacheChunk(key) ? GetChunk(key, lk) : nullptr;
+    if (chunk && offset_in_chunk + bytes_to_read <= chunk->data.size())
+    {
+      std::copy_n(chunk->data.begin() + offset_in_chunk, bytes_to_read, out_ptr);
+    }
+    else
+    {
+      lk.unlock();
+      const bool success = ReadUncached(offset, bytes_to_read, out_ptr, partition_data_offset);
+      lk.lock();
+      if (!success)
+        return false;
+    }
+
+    offset += bytes_to_read;
+    size -= bytes_to_read;
+    out_ptr += bytes_to_read;
+  }
+
+  return true;
+}
+
+bool PrefetchBlobReader::ReadUncached(u64 offset, u64 size, u8* out_ptr,
+                                      u64 partition_data_offset)
+{
+  if (partition_data_offset == NO_PARTITION)
+    return m_reader->Read(offset, size, out_ptr);
+
+  return m_reader->ReadWiiDecrypted(offset, size, out_ptr, partition_data_offset);
+}
+
+const PrefetchBlobReader::Chunk* PrefetchBlobReader::GetChunk(const ChunkKey& key,
+                                                              std::unique_lock<std::mutex>& lk)
+{
+  // Only this thread erases chunks, so the iterator stays valid while the mutex is unlocked
+  auto it = m_chunks.find(key);
+  bool load = false;
+
+  if (it == m_chunks.end())
+  {
+    if (!MakeRoomForChunk())
+      return nullptr;
+
+    it = m_chunks.emplace(key, Chunk{}).first;
+    load = true;
+  }
+  else if (it->second.state == ChunkState::Queued)
+  {
+    // No worker has gotten to this chunk yet, so don't wait for one
+    m_queue.erase(std::find(m_queue.begin(), m_queue.end(), key));
+    load = true;
+  }
+
+  Chunk& chunk = it->second;
+  if (load)
+  {
+    m_statistics.misses++;
+    chunk.state = ChunkState::Loading;
+
+    lk.unlock();
+    std::vector<u8> data;
+    const bool success = ReadChunk(*m_reader, key, GetChunkSize(key.first), &data);
+    lk.lock();
+
+    chunk.data = std::move(data);
+    chunk.state = success ? ChunkState::Ready : ChunkState::Failed;
+  }
+  else if (chunk.state == ChunkState::Loading)
+  {
+    m_statistics.late_hits++;
+    m_chunk_loaded.wait(lk, [&] { return chunk.state != ChunkState::Loading; });
+  }
+  else
+  {
+    m_statistics.hits++;
+  }
+
+  if (chunk.state == ChunkState::Failed)
+  {
+    m_chunks.erase(it);
+    return nullptr;
+  }
+
+  chunk.used = true;
+  chunk.last_use = ++m_use_counter;
+  return &chunk;
+}
+
+void PrefetchBlobReader::UpdateStream(u64 offset, u64 size, u64 partition_data_offset)
+{
+  const u64 chunk_size = GetChunkSize(partition_data_offset);
+  Stream& stream = m_streams[partition_data_offset];
+
+  // Games tend to skip over small gaps (e.g. padding between files) while loading sequentially
+  const bool sequential =
+      offset >= stream.next_offset && offset - stream.next_offset <= chunk_size;
+  stream.next_offset = offset + size;
+
+  if (!sequential)
+  {
+    CancelQueuedPrefetches();
+    stream.next_prefetch_index = 0;
+    return;
+  }
+
+  // The chunk containing the end of this read gets loaded by the read itself
+  const u64 end_index = (offset + size + chunk_size - 1) / chunk_size;
+  const u64 first_index = std::max(stream.next_prefetch_index, end_index);
+  const u64 last_index = end_index + m_prefetch_distance;
+
+  for (u64 index = first_index; index < last_index; index++)
+  {
+    const ChunkKey key{partition_data_offset, index};
+    if (!CanCacheChunk(key) || !QueuePrefetch(key))
+      break;
+    stream.next_prefetch_index = index + 1;
+  }
+}
+
+bool PrefetchBlobReader::QueuePrefetch(const ChunkKey& key)
+{
+  if (m_chunks.contains(key))
+    return true;
+
+  if (!MakeRoomForChunk())
+    return false;
+
+  Chunk& chunk = m_chunks[key];
+  chunk.prefetched = true;
+  // Prefetched chunks count as used now, so that they don't get evicted before they're read
+  chunk.last_use = ++m_use_counter;
+
+  m_queue.push_back(key);
+  m_work_available.notify_one();
+  return true;
+}
+
+bool PrefetchBlobReader::MakeRoomForChunk()
+{
+  if (m_chunks.size() < m_max_chunks)
+    return true;
+
+  auto oldest = m_chunks.end();
+  for (auto it = m_chunks.begin(); it != m_chunks.end(); ++it)
+  {
+    if (it->second.state != ChunkState::Ready && it->second.state != ChunkState::Failed)
+      continue;
+    if (oldest == m_chunks.end() || it->second.last_use < oldest->second.last_use)
+      oldest = it;
+  }
+
+  if (oldest == m_chunks.end())
+    return false;
+
+  if (oldest->second.prefetched && !oldest->second.used)
+    m_statistics.wasted_chunks++;
+  m_chunks.erase(oldest);
+  return true;
+}
+
+void PrefetchBlobReader::CancelQueuedPrefetches()
+{
+  for (const ChunkKey& key : m_queue)
+    m_chunks.erase(key);
+  m_queue.clear();
+}
+
+void PrefetchBlobReader::WorkerThread(BlobReader* reader)
+{
+  Common::SetCurrentThreadName("Disc Prefetch");
+
+  std::unique_lock lk(m_mutex);
+  while (true)
+  {
+    m_work_available.wait(lk, [this] { return m_exit || !m_queue.empty(); });
+    if (m_exit)
+      return;
+
+    const ChunkKey key = m_queue.front();
+    m_queue.pop_front();
+
+    // Loading chunks are never erased, so the reference stays valid while the mutex is unlocked
+    Chunk& chunk = m_chunks[key];
+    chunk.state = ChunkState::Loading;
+
+    lk.unlock();
+    std::vector<u8> data;
+    const bool success = ReadChunk(*reader, key, GetChunkSize(key.first), &data);
+    lk.lock();
+
+    chunk.data = std::move(data);
+    chunk.state = success ? ChunkState::Ready : ChunkState::Failed;
+    if (success)
+      m_statistics.prefetched_chunks++;
+    m_chunk_loaded.notify_all();
+  }
+}
+
+}  // namespace DiscIO
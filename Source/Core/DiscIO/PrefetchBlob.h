@@ -0,0 +1,152 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "DiscIO/Blob.h"
+
+namespace DiscIO
+{
+struct PrefetchStatistics
+{
+  // Reads of chunks which had been decompressed ahead of time
+  u64 hits = 0;
+  // Reads of chunks which were still being decompressed by a worker
+  u64 late_hits = 0;
+  // Reads of chunks which had to be decompressed on the reading thread
+  u64 misses = 0;
+  // Chunks decompressed by the workers, and how many of those were evicted without being read
+  u64 prefetched_chunks = 0;
+  u64 wasted_chunks = 0;
+};
+
+// This class wraps a BlobReader for a format which has to decompress (or decrypt) a whole block
+// to read any part of it. It keeps recently read chunks of the disc in a bounded LRU cache, and
+// once the reads look sequential, the chunks following the last read are decompressed on worker
+// threads so that they are ready by the time they get requested. Every worker opens its own
+// BlobReader for the same file, since BlobReaders can't be shared between threads. Those readers
+// use the same decompression workers as all other readers (see DecompressionPool.h).
+class PrefetchBlobReader final : public BlobReader
+{
+public:
+  // Returns the passed reader as is if prefetching wouldn't help for its format.
+  static std::unique_ptr<BlobReader> Wrap(std::unique_ptr<BlobReader> reader,
+                                          const std::string& path);
+
+  ~PrefetchBlobReader() override;
+
+  BlobType GetBlobType() const override { return m_reader->GetBlobType(); }
+
+  u64 GetRawSize() const override { return m_reader->GetRawSize(); }
+  u64 GetDataSize() const override { return m_reader->GetDataSize(); }
+  DataSizeType GetDataSizeType() const override { return m_reader->GetDataSizeType(); }
+
+  u64 GetBlockSize() const override { return m_reader->GetBlockSize(); }
+  bool HasFastRandomAccessInBlock() const override
+  {
+    return m_reader->HasFastRandomAccessInBlock();
+  }
+  std::string GetCompressionMethod() const override { return m_reader->GetCompressionMethod(); }
+  std::optional<int> GetCompressionLevel() const override
+  {
+    return m_reader->GetCompressionLevel();
+  }
+  std::optional<Common::SHA1::Digest> GetContentID() const override
+  {
+    return m_reader->GetContentID();
+  }
+
+  bool Read(u64 offset, u64 size, u8* out_ptr) override;
+
+  bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override
+  {
+    return m_reader->SupportsReadWiiDecrypted(offset, size, partition_data_offset);
+  }
+  bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
+
+  PrefetchStatistics GetStatistics() const;
+
+private:
+  // Raw reads use NO_PARTITION as the partition data offset
+  static constexpr u64 NO_PARTITION = ~u64(0);
+
+  // Partition data offset, chunk index
+  using ChunkKey = std::pair<u64, u64>;
+
+  enum class ChunkState
+  {
+    Queued,
+    Loading,
+    Ready,
+    Failed,
+  };
+
+  struct Chunk
+  {
+    ChunkState state = ChunkState::Queued;
+    bool prefetched = false;
+    bool used = false;
+    u64 last_use = 0;
+    std::vector<u8> data;
+  };
+
+  struct Stream
+  {
+    u64 next_offset = 0;
+    u64 next_prefetch_index = 0;
+  };
+
+  PrefetchBlobReader(std::unique_ptr<BlobReader> reader,
+                     std::vector<std::unique_ptr<BlobReader>> worker_readers);
+
+  u64 GetChunkSize(u64 partition_data_offset) const;
+  bool CanCacheChunk(const ChunkKey& key) const;
+  static bool ReadChunk(BlobReader& reader, const ChunkKey& key, u64 chunk_size,
+                        std::vector<u8>* out);
+
+  bool ReadCached(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset);
+  bool ReadUncached(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset);
+
+  // Returns the chunk with the given key, loading it on this thread if needed. m_mutex must be
+  // held. Returns nullptr if the chunk couldn't be read.
+  const Chunk* GetChunk(const ChunkKey& key, std::unique_lock<std::mutex>& lk);
+  void UpdateStream(u64 offset, u64 size, u64 partition_data_offset);
+  bool QueuePrefetch(const ChunkKey& key);
+  bool MakeRoomForChunk();
+  void CancelQueuedPrefetches();
+
+  void WorkerThread(BlobReader* reader);
+
+  std::unique_ptr<BlobReader> m_reader;
+  std::vector<std::unique_ptr<BlobReader>> m_worker_readers;
+  std::vector<std::thread> m_workers;
+
+  u64 m_chunk_size;
+  u64 m_decrypted_chunk_size;
+  size_t m_max_chunks;
+  u64 m_prefetch_distance;
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_work_available;
+  std::condition_variable m_chunk_loaded;
+  std::map<ChunkKey, Chunk> m_chunks;
+  std::deque<ChunkKey> m_queue;
+  std::map<u64, Stream> m_streams;
+  u64 m_use_counter = 0;
+  PrefetchStatistics m_statistics;
+  bool m_exit = false;
+};
+
+}  // namespace DiscIO
@@ -0,0 +1,679 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DiscIO/SharedChunkCache.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif !defined(ANDROID)
+#include <cerrno>
+#include <csignal>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __APPLE__
+#include <libproc.h>
+#endif
+
+#include "Common/CommonFuncs.h"
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+#include "Common/Logging/Log.h"
+#include "Common/ScopeGuard.h"
+
+namespace DiscIO
+{
+namespace
+{
+constexpr u32 SEGMENT_MAGIC = 0x43534444;  // "DDSC"
+constexpr u32 SEGMENT_VERSION = 3;
+
+#ifdef _WIN32
+constexpr wchar_t SEGMENT_NAME[] = L"Local\\dolphin-emu-chunk-cache";
+#else
+constexpr char SEGMENT_NAME[] = "/dolphin-emu-chunk-cache";
+#endif
+
+// How long to wait for another process to finish setting up a segment it has just created
+constexpr int INITIALIZATION_TIMEOUT_MS = 1000;
+
+// The maximum amount of data each slot of a size class can hold. Data goes into the smallest class
+// its size hint fits in. The classes leave some room above the common WIA/RVZ chunk sizes, since
+// the hash exceptions of a chunk are stored along with its data.
+constexpr std::array<u32, 4> SLOT_CLASS_SIZES = {0x8000, 0x24000, 0x90000, 0x240000};
+constexpr size_t NUMBER_OF_CLASSES = SLOT_CLASS_SIZES.size();
+
+constexpr size_t SEGMENT_HEADER_SIZE = 0x1000;
+constexpr size_t SLOT_HEADER_SIZE = 0x80;
+
+using SerializedKey = std::array<u8, sizeof(Common::SHA1::Digest) + sizeof(u32) + 2 * sizeof(u64)>;
+
+SerializedKey SerializeKey(const SharedChunkCache::Key& key)
+{
+  SerializedKey result;
+  u8* ptr = result.data();
+  std::memcpy(ptr, key.blob_id.data(), key.blob_id.size());
+  ptr += key.blob_id.size();
+  std::memcpy(ptr, &key.type, sizeof(key.type));
+  ptr += sizeof(key.type);
+  std::memcpy(ptr, &key.position, sizeof(key.position));
+  ptr += sizeof(key.position);
+  std::memcpy(ptr, &key.parameter, sizeof(key.parameter));
+  return result;
+}
+
+u64 HashKey(const SerializedKey& key)
+{
+  // FNV-1a followed by the SplitMix64 finalizer, so that both halves of the result are usable
+  u64 hash = 0xcbf29ce484222325;
+  for (const u8 byte : key)
+    hash = (hash ^ byte) * 0x100000001b3;
+
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111eb;
+  return hash ^ (hash >> 31);
+}
+
+std::optional<size_t> GetSizeClass(size_t size_hint)
+{
+  for (size_t i = 0; i < NUMBER_OF_CLASSES; ++i)
+  {
+    if (size_hint <= SLOT_CLASS_SIZES[i])
+      return i;
+  }
+
+  return std::nullopt;
+}
+
+// Everything in the segment is accessed by several processes at once, so all fields which can
+// change after the segment has been set up are atomics (or protected by a slot's sequence counter)
+struct SegmentHeader
+{
+  // Written last by the process that creates the segment
+  std::atomic<u32> magic;
+  u32 version;
+  u64 size;
+  std::array<u64, NUMBER_OF_CLASSES> class_offsets;
+  std::array<u64, NUMBER_OF_CLASSES> class_slot_counts;
+
+  std::atomic<u64> clock;
+
+  // The number of processes which have the segment mapped. The last one to unmap it removes its
+  // name, so that the memory is freed once no process uses it anymore. (Processes which crash
+  // never decrement this, in which case the segment stays around until the host reboots.)
+  std::atomic<u32> users;
+
+  std::atomic<u64> hits;
+  std::atomic<u64> misses;
+  std::atomic<u64> insertions;
+  std::atomic<u64> evictions;
+};
+
+struct SlotHeader
+{
+  // Odd while a process is writing to the slot, 0 if the slot has never been written to.
+  // Readers check that it is unchanged after copying the data out of the slot.
+  std::atomic<u32> sequence;
+  u32 data_size;
+  std::atomic<u64> last_use;
+  SerializedKey key;
+  // The process writing to the slot, recorded right after it has claimed the slot. The upper half
+  // of each holds the sequence the process is writing with, so that a process which hasn't gotten
+  // around to recording itself yet can't be mistaken for the previous writer.
+  std::atomic<u64> writer_pid;
+  std::atomic<u64> writer_start_time;
+};
+
+enum class ProcessState
+{
+  Running,
+  Exited,
+  Unknown,
+};
+
+// Start times are only ever compared with each other, so their unit differs between platforms.
+// They tell a process apart from an earlier one which had the same ID.
+ProcessState QueryProcess(u32 pid, u64* start_time)
+{
+  *start_time = 0;
+
+#if defined(_WIN32)
+  const HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+  if (!process)
+    return GetLastError() == ERROR_INVALID_PARAMETER ? ProcessState::Exited : ProcessState::Unknown;
+  Common::ScopeGuard close_guard([process] { CloseHandle(process); });
+
+  DWORD exit_code;
+  if (GetExitCodeProcess(process, &exit_code) && exit_code != STILL_ACTIVE)
+    return ProcessState::Exited;
+
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetProcessTimes(process, &creation_time, &exit_time, &kernel_time, &user_time))
+    return ProcessState::Unknown;
+
+  *start_time = (u64(creation_time.dwHighDateTime) << 32) | creation_time.dwLowDateTime;
+  return ProcessState::Running;
+#elif defined(__APPLE__)
+  proc_bsdinfo info;
+  if (proc_pidinfo(static_cast<int>(pid), PROC_PIDTBSDINFO, 0, &info, sizeof(info)) !=
+      sizeof(info))
+  {
+    return errno == ESRCH ? ProcessState::Exited : ProcessState::Unknown;
+  }
+  if (info.pbi_status == SZOMB)
+    return ProcessState::Exited;
+
+  *start_time = info.pbi_start_tvsec * 1000000 + info.pbi_start_tvusec;
+  return ProcessState::Running;
+#elif defined(__linux__)
+  const std::string path = "/proc/" + std::to_string(pid) + "/stat";
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+    return errno == ENOENT ? ProcessState::Exited : ProcessState::Unknown;
+
+  std::array<char, 1024> buffer;
+  const ssize_t size = read(fd, buffer.data(), buffer.size() - 1);
+  close(fd);
+  if (size <= 0)
+    return ProcessState::Unknown;
+  buffer[size] = '\0';
+
+  // The process name in parentheses can contain spaces and parentheses itself. After it come the
+  // state and, 19 fields later, the start time.
+  const char* fields = std::strrchr(buffer.data(), ')');
+  char state;
+  unsigned long long start_ticks;
+  if (!fields || std::sscanf(fields + 1, " %c %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s %*s "
+                                         "%*s %*s %*s %*s %*s %llu",
+                             &state, &start_ticks) != 2)
+  {
+    return ProcessState::Unknown;
+  }
+  if (state == 'Z' || state == 'X')
+    return ProcessState::Exited;
+
+  *start_time = start_ticks;
+  return ProcessState::Running;
+#elif !defined(ANDROID)
+  // There's no portable way to get the start time, so a running process can't be told apart from
+  // an earlier one with the same ID
+  if (kill(static_cast<pid_t>(pid), 0) == -1 && errno == ESRCH)
+    return ProcessState::Exited;
+  return ProcessState::Unknown;
+#else
+  return ProcessState::Unknown;
+#endif
+}
+
+u32 FoldStartTime(u64 start_time)
+{
+  return static_cast<u32>(start_time ^ (start_time >> 32));
+}
+
+struct ProcessIdentity
+{
+  u32 pid;
+  u32 start_time;
+};
+
+const ProcessIdentity& GetOwnIdentity()
+{
+  static const ProcessIdentity identity = [] {
+#ifdef _WIN32
+    const u32 pid = GetCurrentProcessId();
+#else
+    const u32 pid = static_cast<u32>(getpid());
+#endif
+    u64 start_time;
+    QueryProcess(pid, &start_time);
+    return ProcessIdentity{pid, FoldStartTime(start_time)};
+  }();
+  return identity;
+}
+
+// Only returns true if the process which started writing with the given sequence is known to have
+// exited without finishing. A writer which is merely slow must never have the slot taken from it,
+// since it would keep writing to the slot after the slot has been handed to readers again.
+bool HasWriterExited(const SlotHeader& slot, u32 sequence)
+{
+  const u64 writer_pid = slot.writer_pid.load(std::memory_order_relaxed);
+  const u64 writer_start_time = slot.writer_start_time.load(std::memory_order_relaxed);
+  if (writer_pid >> 32 != sequence || writer_start_time >> 32 != sequence)
+    return false;
+
+  u64 start_time;
+  switch (QueryProcess(static_cast<u32>(writer_pid), &start_time))
+  {
+  case ProcessState::Exited:
+    return true;
+  case ProcessState::Running:
+    // A different process which has been given the same ID since
+    return FoldStartTime(start_time) != static_cast<u32>(writer_start_time);
+  default:
+    return false;
+  }
+}
+
+static_assert(std::atomic<u32>::is_always_lock_free && std::atomic<u64>::is_always_lock_free,
+              "Atomics in shared memory must not depend on process-local locks");
+static_assert(sizeof(SegmentHeader) <= SEGMENT_HEADER_SIZE);
+static_assert(sizeof(SlotHeader) <= SLOT_HEADER_SIZE);
+
+std::mutex s_configure_mutex;
+std::unique_ptr<SharedChunkCache> s_cache;
+std::atomic<SharedChunkCache*> s_active_cache = nullptr;
+}  // Anonymous namespace
+
+SharedChunkCache::~SharedChunkCache()
+{
+  Unmap();
+}
+
+void SharedChunkCache::Configure(u64 size)
+{
+  std::lock_guard lk(s_configure_mutex);
+
+  if (size == 0)
+  {
+    if (SharedChunkCache* cache = s_active_cache.exchange(nullptr))
+      cache->LogStatistics();
+    return;
+  }
+
+  if (!s_cache)
+  {
+    std::unique_ptr<SharedChunkCache> cache(new SharedChunkCache);
+    if (!cache->Map(size))
+      return;
+
+    s_cache = std::move(cache);
+  }
+
+  s_active_cache.store(s_cache.get());
+}
+
+SharedChunkCache* SharedChunkCache::GetInstance()
+{
+  return s_active_cache.load(std::memory_order_acquire);
+}
+
+bool SharedChunkCache::Map(u64 size)
+{
+#if defined(ANDROID)
+  ERROR_LOG_FMT(DISCIO, "The shared disc cache is not supported on this platform");
+  return false;
+#else
+  size = std::max<u64>(size, SEGMENT_HEADER_SIZE);
+  bool created;
+
+#if defined(_WIN32)
+  const HANDLE handle = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                           static_cast<DWORD>(size >> 32),
+                                           static_cast<DWORD>(size), SEGMENT_NAME);
+  if (!handle)
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to create the shared disc cache: {}",
+                  Common::GetLastErrorString());
+    return false;
+  }
+  created = GetLastError() != ERROR_ALREADY_EXISTS;
+
+  // The mapping object stays alive for as long as a view of it exists
+  void* base = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+  CloseHandle(handle);
+  if (!base)
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to map the shared disc cache: {}", Common::GetLastErrorString());
+    return false;
+  }
+
+  if (!created)
+  {
+    MEMORY_BASIC_INFORMATION info{};
+    VirtualQuery(base, &info, sizeof(info));
+    size = info.RegionSize;
+  }
+#else
+  created = true;
+  int fd = shm_open(SEGMENT_NAME, O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd == -1 && errno == EEXIST)
+  {
+    created = false;
+    fd = shm_open(SEGMENT_NAME, O_RDWR, 0600);
+  }
+  if (fd == -1)
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to open the shared disc cache: {}", Common::LastStrerrorString());
+    return false;
+  }
+  Common::ScopeGuard close_guard([fd] { close(fd); });
+
+  if (created)
+  {
+    if (ftruncate(fd, size) != 0)
+    {
+      ERROR_LOG_FMT(DISCIO, "Failed to allocate the shared disc cache: {}",
+                    Common::LastStrerrorString());
+      shm_unlink(SEGMENT_NAME);
+      return false;
+    }
+  }
+  else
+  {
+    // The process that created the segment might not have gotten around to setting its size yet
+    struct stat st = {};
+    for (int i = 0; i < INITIALIZATION_TIMEOUT_MS; ++i)
+    {
+      if (fstat(fd, &st) != 0 || st.st_size != 0)
+        break;
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    if (st.st_size == 0)
+    {
+      ERROR_LOG_FMT(DISCIO,
+                    "The shared disc cache was never set up by the process that created it");
+      shm_unlink(SEGMENT_NAME);
+      return false;
+    }
+    size = static_cast<u64>(st.st_size);
+  }
+
+  void* base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (base == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(DISCIO, "Failed to map the shared disc cache: {}", Common::LastStrerrorString());
+    if (created)
+      shm_unlink(SEGMENT_NAME);
+    return false;
+  }
+#endif
+
+  m_base = static_cast<u8*>(base);
+  m_size = static_cast<size_t>(size);
+  SegmentHeader* header = reinterpret_cast<SegmentHeader*>(m_base);
+
+  if (created)
+  {
+    // The memory is zeroed by the OS, so all slots start out empty
+    header->version = SEGMENT_VERSION;
+    header->size = size;
+    u64 offset = SEGMENT_HEADER_SIZE;
+    const u64 bytes_per_class = (size - SEGMENT_HEADER_SIZE) / NUMBER_OF_CLASSES;
+    for (size_t i = 0; i < NUMBER_OF_CLASSES; ++i)
+    {
+      const u64 slot_size = SLOT_HEADER_SIZE + SLOT_CLASS_SIZES[i];
+      header->class_offsets[i] = offset;
+      header->class_slot_counts[i] = bytes_per_class / slot_size;
+      offset += header->class_slot_counts[i] * slot_size;
+    }
+    header->users.store(1, std::memory_order_relaxed);
+    m_is_user = true;
+    header->magic.store(SEGMENT_MAGIC, std::memory_order_release);
+
+    NOTICE_LOG_FMT(DISCIO, "Created a shared disc cache of {} MiB", size >> 20);
+    return true;
+  }
+
+  for (int i = 0; i < INITIALIZATION_TIMEOUT_MS; ++i)
+  {
+    if (header->magic.load(std::memory_order_acquire) == SEGMENT_MAGIC)
+      break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  bool valid = header->magic.load(std::memory_order_acquire) == SEGMENT_MAGIC &&
+               header->version == SEGMENT_VERSION && header->size <= m_size;
+  for (size_t i = 0; valid && i < NUMBER_OF_CLASSES; ++i)
+  {
+    const u64 slot_size = SLOT_HEADER_SIZE + SLOT_CLASS_SIZES[i];
+    valid = header->class_offsets[i] >= SEGMENT_HEADER_SIZE &&
+            header->class_slot_counts[i] <= m_size / slot_size &&
+            header->class_offsets[i] + header->class_slot_counts[i] * slot_size <= header->size;
+  }
+
+  if (!valid)
+  {
+    ERROR_LOG_FMT(DISCIO, "The existing shared disc cache is unusable. It was either created by "
+                          "an incompatible version of Dolphin or never finished being set up.");
+#ifndef _WIN32
+    // Let the next process which tries to use the cache create a fresh segment
+    shm_unlink(SEGMENT_NAME);
+#endif
+    Unmap();
+    return false;
+  }
+
+  header->users.fetch_add(1, std::memory_order_relaxed);
+  m_is_user = true;
+  NOTICE_LOG_FMT(DISCIO, "Using the existing shared disc cache of {} MiB", header->size >> 20);
+  return true;
+#endif
+}
+
+void SharedChunkCache::Unmap()
+{
+  if (!m_base)
+    return;
+
+#if defined(_WIN32)
+  // Windows frees the segment once no process has it mapped anymore
+  UnmapViewOfFile(m_base);
+#elif !defined(ANDROID)
+  // A POSIX segment stays around until its name is removed, even if no process has it mapped. If
+  // another process opens the segment right before this, it simply ends up with a private copy.
+  SegmentHeader* header = reinterpret_cast<SegmentHeader*>(m_base);
+  if (m_is_user && header->users.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    shm_unlink(SEGMENT_NAME);
+  munmap(m_base, m_size);
+#endif
+
+  m_base = nullptr;
+  m_size = 0;
+  m_is_user = false;
+}
+
+template <typename CopyFunction>
+bool SharedChunkCache::Lookup(const Key& key, size_t size_hint, CopyFunction copy)
+{
+  SegmentHeader* header = reinterpret_cast<SegmentHeader*>(m_base);
+
+  const std::optional<size_t> size_class = GetSizeClass(size_hint);
+  const u64 slot_count = size_class ? header->class_slot_counts[*size_class] : 0;
+  if (slot_count == 0)
+    return false;
+
+  const u64 slot_size = SLOT_HEADER_SIZE + SLOT_CLASS_SIZES[*size_class];
+  const SerializedKey serialized_key = SerializeKey(key);
+  const u64 hash = HashKey(serialized_key);
+
+  for (const u64 index : {hash % slot_count, (hash >> 32) % slot_count})
+  {
+    u8* slot_base = m_base + header->class_offsets[*size_class] + index * slot_size;
+    SlotHeader* slot = reinterpret_cast<SlotHeader*>(slot_base);
+
+    const u32 sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence == 0 || (sequence & 1) != 0)
+      continue;
+
+    const u32 data_size = slot->data_size;
+    if (data_size > SLOT_CLASS_SIZES[*size_class] || slot->key != serialized_key)
+      continue;
+
+    if (!copy(slot_base + SLOT_HEADER_SIZE, data_size))
+      continue;
+
+    // If another process has started writing to the slot in the meantime, what we copied might be
+    // a mix of the old and new data
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->sequence.load(std::memory_order_relaxed) != sequence)
+      continue;
+
+    slot->last_use.store(header->clock.fetch_add(1, std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    header->hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  m_misses.fetch_add(1, std::memory_order_relaxed);
+  header->misses.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+bool SharedChunkCache::Get(const Key& key, u8* buffer, size_t size)
+{
+  return Lookup(key, size, [buffer, size](const u8* data, u32 data_size) {
+    if (data_size != size)
+      return false;
+
+    std::memcpy(buffer, data, size);
+    return true;
+  });
+}
+
+bool SharedChunkCache::Get(const Key& key, size_t size_hint, std::vector<u8>* out)
+{
+  return Lookup(key, size_hint, [out](const u8* data, u32 data_size) {
+    out->assign(data, data + data_size);
+    return true;
+  });
+}
+
+void SharedChunkCache::Insert(const Key& key, size_t size_hint, const u8* data, size_t size)
+{
+  SegmentHeader* header = reinterpret_cast<SegmentHeader*>(m_base);
+
+  const std::optional<size_t> size_class = GetSizeClass(size_hint);
+  const u64 slot_count = size_class ? header->class_slot_counts[*size_class] : 0;
+  if (slot_count == 0 || size > SLOT_CLASS_SIZES[*size_class])
+    return;
+
+  const u64 slot_size = SLOT_HEADER_SIZE + SLOT_CLASS_SIZES[*size_class];
+  const SerializedKey serialized_key = SerializeKey(key);
+  const u64 hash = HashKey(serialized_key);
+
+  std::array<u8*, 2> candidates;
+  candidates[0] = m_base + header->class_offsets[*size_class] + (hash % slot_count) * slot_size;
+  candidates[1] =
+      m_base + header->class_offsets[*size_class] + ((hash >> 32) % slot_count) * slot_size;
+
+  // Prefer an empty slot, otherwise replace the least recently used one. If another process has
+  // inserted the same data already, there's nothing to do.
+  SlotHeader* victim = nullptr;
+  u64 victim_last_use = 0;
+  for (u8* slot_base : candidates)
+  {
+    SlotHeader* slot = reinterpret_cast<SlotHeader*>(slot_base);
+    const u32 sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence != 0 && (sequence & 1) == 0 && slot->key == serialized_key)
+      return;
+
+    // Empty slots have never been used, so their last use is 0
+    const u64 last_use = slot->last_use.load(std::memory_order_relaxed);
+    if (!victim || last_use < victim_last_use)
+    {
+      victim = slot;
+      victim_last_use = last_use;
+    }
+  }
+
+  u32 sequence = victim->sequence.load(std::memory_order_relaxed);
+  u32 writing_sequence = sequence + 1;
+  if ((sequence & 1) != 0)
+  {
+    // Another process is writing to the slot right now. Not worth waiting for, unless that process
+    // has exited in the middle of writing, in which case nobody else would ever finish the slot.
+    // Taking the slot over keeps the sequence odd, so readers keep skipping it.
+    if (!HasWriterExited(*victim, sequence))
+      return;
+    writing_sequence = sequence + 2;
+  }
+  if (!victim->sequence.compare_exchange_strong(sequence, writing_sequence,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_relaxed))
+  {
+    return;
+  }
+  const ProcessIdentity& identity = GetOwnIdentity();
+  const u64 tag = u64(writing_sequence) << 32;
+  victim->writer_pid.store(tag | identity.pid, std::memory_order_relaxed);
+  victim->writer_start_time.store(tag | identity.start_time, std::memory_order_relaxed);
+  // Make sure readers can't see the data we're about to write without also seeing the odd sequence
+  std::atomic_thread_fence(std::memory_order_release);
+
+  const bool evicting = sequence != 0;
+  victim->key = serialized_key;
+  victim->data_size = static_cast<u32>(size);
+  std::memcpy(reinterpret_cast<u8*>(victim) + SLOT_HEADER_SIZE, data, size);
+  victim->last_use.store(header->clock.fetch_add(1, std::memory_order_relaxed) + 1,
+                         std::memory_order_relaxed);
+  victim->sequence.store(writing_sequence + 1, std::memory_order_release);
+
+  m_insertions.fetch_add(1, std::memory_order_relaxed);
+  header->insertions.fetch_add(1, std::memory_order_relaxed);
+  if (evicting)
+  {
+    m_evictions.fetch_add(1, std::memory_order_relaxed);
+    header->evictions.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+SharedChunkCache::Statistics SharedChunkCache::GetStatistics() const
+{
+  Statistics statistics;
+  statistics.hits = m_hits.load(std::memory_order_relaxed);
+  statistics.misses = m_misses.load(std::memory_order_relaxed);
+  statistics.insertions = m_insertions.load(std::memory_order_relaxed);
+  statistics.evictions = m_evictions.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+SharedChunkCache::Statistics SharedChunkCache::GetGlobalStatistics() const
+{
+  const SegmentHeader* header = reinterpret_cast<const SegmentHeader*>(m_base);
+
+  Statistics statistics;
+  statistics.hits = header->hits.load(std::memory_order_relaxed);
+  statistics.misses = header->misses.load(std::memory_order_relaxed);
+  statistics.insertions = header->insertions.load(std::memory_order_relaxed);
+  statistics.evictions = header->evictions.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+void SharedChunkCache::LogStatistics() const
+{
+  const auto log = [](std::string_view description, const Statistics& statistics) {
+    const u64 lookups = statistics.hits + statistics.misses;
+    const double hit_rate =
+        lookups == 0 ? 0.0 : 100.0 * static_cast<double>(statistics.hits) / lookups;
+    NOTICE_LOG_FMT(DISCIO,
+                   "Shared disc cache ({}): {} hits, {} misses ({:.1f}% hit rate), "
+                   "{} insertions, {} evictions",
+                   description, statistics.hits, statistics.misses, hit_rate,
+                   statistics.insertions, statistics.evictions);
+  };
+
+  log("this process", GetStatistics());
+  log("all processes", GetGlobalStatistics());
+}
+
+}  // namespace DiscIO
@@ -0,0 +1,108 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Crypto/SHA1.h"
+
+namespace DiscIO
+{
+// A cache of decompressed and decrypted disc data that is shared between all Dolphin processes on
+// the host which have it enabled, so that several instances running the same disc image (e.g. for
+// netplay testing or TAS work) don't each have to decompress and decrypt the same data.
+//
+// The cache lives in a named shared memory segment that is split into a few size classes of
+// fixed-size slots. Each piece of data can be stored in one of two slots of its size class, picked
+// by hashing its key, and the least recently used of the two gets replaced on insertion. Slots are
+// protected by sequence counters, so neither lookups nor insertions ever wait for other processes.
+// A slot left half-written by a process that exited while writing to it is taken over by the next
+// insertion which finds it that way.
+class SharedChunkCache
+{
+public:
+  enum class DataType : u32
+  {
+    WIARVZChunk = 1,
+    GCZBlock = 2,
+    WiiDecryptedBlock = 3,
+  };
+
+  struct Key
+  {
+    // Identifies the contents of the disc image, see BlobReader::GetContentID
+    Common::SHA1::Digest blob_id;
+    DataType type;
+    // Where the data is, in a way that is specific to each DataType
+    u64 position;
+    // Anything else the data depends on
+    u64 parameter;
+  };
+
+  struct Statistics
+  {
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 insertions = 0;
+    u64 evictions = 0;
+  };
+
+  ~SharedChunkCache();
+
+  SharedChunkCache(const SharedChunkCache&) = delete;
+  SharedChunkCache(SharedChunkCache&&) = delete;
+  SharedChunkCache& operator=(const SharedChunkCache&) = delete;
+  SharedChunkCache& operator=(SharedChunkCache&&) = delete;
+
+  // Starts using the shared memory segment, creating it with the given size if no other process
+  // has created it yet (otherwise, the size the other process picked is used). A size of 0 stops
+  // using the cache. Once mapped, the segment stays mapped until the process exits, so that
+  // readers on other threads never see it go away. The segment is removed from the system when
+  // the last process using it exits normally.
+  static void Configure(u64 size);
+
+  // Returns nullptr if the cache isn't in use.
+  static SharedChunkCache* GetInstance();
+
+  // Copies data into buffer if the cache has exactly size bytes stored for the key.
+  // buffer may have been overwritten even if false is returned.
+  bool Get(const Key& key, u8* buffer, size_t size);
+  // For data whose size isn't known in advance. size_hint decides which size class is used, so
+  // the same size_hint must be passed when inserting.
+  bool Get(const Key& key, size_t size_hint, std::vector<u8>* out);
+
+  void Insert(const Key& key, const u8* data, size_t size) { Insert(key, size, data, size); }
+  void Insert(const Key& key, size_t size_hint, const u8* data, size_t size);
+
+  // Only counts the lookups and insertions made by this process
+  Statistics GetStatistics() const;
+  // Counts the lookups and insertions made by all processes using the segment
+  Statistics GetGlobalStatistics() const;
+
+private:
+  SharedChunkCache() = default;
+
+  bool Map(u64 size);
+  void Unmap();
+
+  template <typename CopyFunction>
+  bool Lookup(const Key& key, size_t size_hint, CopyFunction copy);
+
+  void LogStatistics() const;
+
+  u8* m_base = nullptr;
+  size_t m_size = 0;
+  // Whether this process is counted in the segment's number of users
+  bool m_is_user = false;
+
+  std::atomic<u64> m_hits = 0;
+  std::atomic<u64> m_misses = 0;
+  std::atomic<u64> m_insertions = 0;
+  std::atomic<u64> m_evictions = 0;
+};
+
+}  // namespace DiscIO
@@ -4,6 +4,7 @@
 #include "DiscIO/VolumeVerifier.h"
 
 #include <algorithm>
+#include <functional>
 #include <future>
 #include <limits>
 #include <memory>
@@ -32,6 +33,7 @@
 #include "Common/ScopeGuard.h"
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
+#include "Common/Thread.h"
 #include "Common/Version.h"
 #include "Core/IOS/Device.h"
 #include "Core/IOS/ES/ES.h"
@@ -359,13 +361,20 @@ RedumpVerifier::Result RedumpVerifier::Finish(const Hashes<std::vector<u8>>& has
 
 constexpr u64 DEFAULT_READ_SIZE = 0x20000;  // Arbitrary value
 
+// How many chunks the read thread may at least be ahead of Process. With more threads, it may be
+// ahead by two chunks per thread, so that one batch can be read while the previous one is checked.
+constexpr size_t READ_AHEAD_CHUNKS = 4;
+
 VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
-                               Hashes<bool> hashes_to_calculate)
+                               Hashes<bool> hashes_to_calculate,
+                               u32 num_worker_threads)
     : m_volume(volume), m_redump_verification(redump_verification),
       m_hashes_to_calculate(hashes_to_calculate),
       m_calculating_any_hash(hashes_to_calculate.crc32 || hashes_to_calculate.md5 ||
                              hashes_to_calculate.sha1),
-      m_max_progress(volume.GetDataSize()), m_data_size_type(volume.GetDataSizeType())
+      m_max_read_chunks(std::max<size_t>(READ_AHEAD_CHUNKS, (num_worker_threads + 1) * 2)),
+      m_num_worker_threads(num_worker_threads), m_max_progress(volume.GetDataSize()),
+      m_data_size_type(volume.GetDataSizeType())
 {
   if (!m_calculating_any_hash)
     m_redump_verification = false;
@@ -373,7 +382,7 @@ VolumeVerifier::VolumeVerifier(const Volume& volume, bool redump_verification,
 
 VolumeVerifier::~VolumeVerifier()
 {
-  WaitForAsyncOperations();
+  StopReadAhead();
 }
 
 Hashes<bool> VolumeVerifier::GetDefaultHashesToCalculate()
@@ -394,6 +403,11 @@ Hashes<bool> VolumeVerifier::GetDefaultHashesToCalculate()
   return hashes_to_calculate;
 }
 
+u32 VolumeVerifier::GetDefaultWorkerThreadCount()
+{
+  return static_cast<u32>(std::max(cpu_info.num_cores - 1, 0));
+}
+
 void VolumeVerifier::Start()
 {
   ASSERT(!m_started);
@@ -415,6 +429,8 @@ void VolumeVerifier::Start()
   CheckMisc();
 
   SetUpHashing();
+
+  m_read_thread = std::thread(&VolumeVerifier::ReadAheadThread, this);
 }
 
 std::vector<Partition> VolumeVerifier::CheckPartitions()
@@ -1065,6 +1081,17 @@ void VolumeVerifier::SetUpHashing()
   std::sort(m_groups.begin(), m_groups.end(),
             [](const GroupToVerify& a, const GroupToVerify& b) { return a.offset < b.offset; });
 
+  if (m_calculating_any_hash || !m_content_offsets.empty() || !m_groups.empty())
+    m_thread_pool.Start(m_num_worker_threads, "Verification Worker");
+
+  if (!m_groups.empty())
+  {
+    // Groups are checked on several threads at once. Make this thread load the partition data
+    // which CheckBlockIntegrity loads on first use (such as the decryption key) beforehand.
+    for (const auto& [partition, block_errors] : m_block_errors)
+      m_volume.CheckBlockIntegrity(0, partition);
+  }
+
   if (m_hashes_to_calculate.crc32)
     m_crc32_context = Common::StartCRC32();
 
@@ -1080,41 +1107,143 @@ void VolumeVerifier::SetUpHashing()
   }
 }
 
-void VolumeVerifier::WaitForAsyncOperations() const
+VolumeVerifier::ChunkToProcess VolumeVerifier::GetNextChunk(u64 progress, u16* content_index,
+                                                            size_t* group_index) const
 {
-  if (m_crc32_future.valid())
-    m_crc32_future.wait();
-  if (m_md5_future.valid())
-    m_md5_future.wait();
-  if (m_sha1_future.valid())
-    m_sha1_future.wait();
-  if (m_content_future.valid())
-    m_content_future.wait();
-  if (m_group_future.valid())
-    m_group_future.wait();
+  ChunkToProcess chunk;
+  chunk.bytes_to_read = DEFAULT_READ_SIZE;
+  if (*content_index < m_content_offsets.size() && m_content_offsets[*content_index] == progress)
+  {
+    IOS::ES::Content content{};
+    m_volume.GetTMD(PARTITION_NONE).GetContent(*content_index, &content);
+    chunk.bytes_to_read = Common::AlignUp(content.size, 0x40);
+    chunk.content = content;
+
+    const u16 next_content_index = *content_index + 1;
+    if (next_content_index < m_content_offsets.size() &&
+        m_content_offsets[next_content_index] < progress + chunk.bytes_to_read)
+    {
+      chunk.excess_bytes = progress + chunk.bytes_to_read - m_content_offsets[next_content_index];
+    }
+  }
+  else if (*content_index < m_content_offsets.size() &&
+           m_content_offsets[*content_index] > progress)
+  {
+    chunk.bytes_to_read =
+        std::min(chunk.bytes_to_read, m_content_offsets[*content_index] - progress);
+  }
+  else if (*group_index < m_groups.size() && m_groups[*group_index].offset == progress)
+  {
+    const size_t blocks =
+        m_groups[*group_index].block_index_end - m_groups[*group_index].block_index_start;
+    chunk.bytes_to_read = VolumeWii::BLOCK_TOTAL_SIZE * blocks;
+    chunk.group_index = *group_index;
+
+    if (*group_index + 1 < m_groups.size() &&
+        m_groups[*group_index + 1].offset < progress + chunk.bytes_to_read)
+    {
+      chunk.excess_bytes = progress + chunk.bytes_to_read - m_groups[*group_index + 1].offset;
+    }
+  }
+  else if (*group_index < m_groups.size() && m_groups[*group_index].offset > progress)
+  {
+    chunk.bytes_to_read = std::min(chunk.bytes_to_read, m_groups[*group_index].offset - progress);
+  }
+
+  if (progress + chunk.bytes_to_read > m_max_progress)
+  {
+    const u64 bytes_over_max = progress + chunk.bytes_to_read - m_max_progress;
+
+    if (m_data_size_type == DataSizeType::LowerBound)
+    {
+      // Disc images in NFS format can have the last referenced block be past m_max_progress.
+      // For NFS, reading beyond m_max_progress doesn't return an error, so let's read beyond it.
+      chunk.excess_bytes = std::max(chunk.excess_bytes, bytes_over_max);
+    }
+    else
+    {
+      // Don't read beyond the end of the disc.
+      chunk.bytes_to_read -= bytes_over_max;
+      chunk.excess_bytes -= std::min(chunk.excess_bytes, bytes_over_max);
+      chunk.content.reset();
+      chunk.group_index.reset();
+    }
+  }
+
+  if (chunk.content)
+    ++*content_index;
+  if (chunk.group_index)
+    ++*group_index;
+
+  return chunk;
 }
 
-bool VolumeVerifier::ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read)
+void VolumeVerifier::ReadAheadThread()
 {
-  std::vector<u8> data(bytes_to_read);
+  Common::SetCurrentThreadName("Verification Read");
 
-  const u64 bytes_to_copy = std::min(m_excess_bytes, bytes_to_read);
-  if (bytes_to_copy > 0)
-    std::memcpy(data.data(), m_data.data() + m_data.size() - m_excess_bytes, bytes_to_copy);
-  bytes_to_read -= bytes_to_copy;
+  u64 progress = 0;
+  u16 content_index = 0;
+  size_t group_index = 0;
+  bool read_for_hashes = m_calculating_any_hash;
+  std::shared_ptr<const std::vector<u8>> previous_data;
+  u64 previous_excess_bytes = 0;
 
-  if (bytes_to_read > 0)
+  while (progress < m_max_progress)
   {
-    if (!m_volume.Read(m_progress + bytes_to_copy, bytes_to_read, data.data() + bytes_to_copy,
-                       PARTITION_NONE))
+    ChunkToProcess chunk = GetNextChunk(progress, &content_index, &group_index);
+
+    if (read_for_hashes || chunk.content || chunk.group_index)
+    {
+      auto data = std::make_shared<std::vector<u8>>(chunk.bytes_to_read);
+
+      u64 bytes_to_copy = std::min(previous_excess_bytes, chunk.bytes_to_read);
+      if (!previous_data || previous_data->size() < bytes_to_copy)
+        bytes_to_copy = 0;
+      if (bytes_to_copy > 0)
+      {
+        std::memcpy(data->data(), previous_data->data() + previous_data->size() - bytes_to_copy,
+                    bytes_to_copy);
+      }
+
+      if (chunk.bytes_to_read > bytes_to_copy &&
+          !m_volume.Read(progress + bytes_to_copy, chunk.bytes_to_read - bytes_to_copy,
+                         data->data() + bytes_to_copy, PARTITION_NONE))
+      {
+        chunk.read_failed = true;
+        read_for_hashes = false;
+      }
+
+      chunk.data = data;
+      previous_data = std::move(data);
+    }
+
+    progress += chunk.bytes_to_read - chunk.excess_bytes;
+    previous_excess_bytes = chunk.excess_bytes;
+
     {
-      return false;
+      std::unique_lock lk(m_read_mutex);
+      m_chunk_taken.wait(
+          lk, [this] { return m_stop_reading || m_read_chunks.size() < m_max_read_chunks; });
+      if (m_stop_reading)
+        return;
+
+      m_read_chunks.push_back(std::move(chunk));
     }
+    m_chunk_read.notify_one();
   }
+}
 
-  WaitForAsyncOperations();
-  m_data = std::move(data);
-  return true;
+void VolumeVerifier::StopReadAhead()
+{
+  {
+    std::lock_guard lk(m_read_mutex);
+    m_stop_reading = true;
+  }
+  m_chunk_taken.notify_one();
+
+  if (m_read_thread.joinable())
+    m_read_thread.join();
 }
 
 void VolumeVerifier::Process()
@@ -1125,156 +1254,152 @@ void VolumeVerifier::Process()
   if (m_progress >= m_max_progress)
     return;
 
-  IOS::ES::Content content{};
-  bool content_read = false;
-  bool group_read = false;
-  u64 bytes_to_read = DEFAULT_READ_SIZE;
-  u64 excess_bytes = 0;
-  if (m_content_index < m_content_offsets.size() &&
-      m_content_offsets[m_content_index] == m_progress)
+  // Take every chunk that has been read so far, up to one per thread, and check them all at once
+  std::vector<ChunkToProcess> chunks;
   {
-    m_volume.GetTMD(PARTITION_NONE).GetContent(m_content_index, &content);
-    bytes_to_read = Common::AlignUp(content.size, 0x40);
-    content_read = true;
-
-    const u16 next_content_index = m_content_index + 1;
-    if (next_content_index < m_content_offsets.size() &&
-        m_content_offsets[next_content_index] < m_progress + bytes_to_read)
+    std::unique_lock lk(m_read_mutex);
+    m_chunk_read.wait(lk, [this] { return !m_read_chunks.empty(); });
+    const size_t chunk_count = std::min<size_t>(m_read_chunks.size(), m_num_worker_threads + 1);
+    for (size_t i = 0; i < chunk_count; ++i)
     {
-      excess_bytes = m_progress + bytes_to_read - m_content_offsets[next_content_index];
+      chunks.push_back(std::move(m_read_chunks.front()));
+      m_read_chunks.pop_front();
     }
   }
-  else if (m_content_index < m_content_offsets.size() &&
-           m_content_offsets[m_content_index] > m_progress)
-  {
-    bytes_to_read = std::min(bytes_to_read, m_content_offsets[m_content_index] - m_progress);
-  }
-  else if (m_group_index < m_groups.size() && m_groups[m_group_index].offset == m_progress)
+  m_chunk_taken.notify_one();
+
+  std::vector<std::function<void()>> tasks;
+  std::vector<std::optional<IOS::ES::Content>> corrupt_contents(chunks.size());
+
+  u64 progress = m_progress;
+  size_t chunks_to_hash = 0;
+  for (size_t i = 0; i < chunks.size(); ++i)
   {
-    const size_t blocks =
-        m_groups[m_group_index].block_index_end - m_groups[m_group_index].block_index_start;
-    bytes_to_read = VolumeWii::BLOCK_TOTAL_SIZE * blocks;
-    group_read = true;
+    const ChunkToProcess& chunk = chunks[i];
 
-    if (m_group_index + 1 < m_groups.size() &&
-        m_groups[m_group_index + 1].offset < m_progress + bytes_to_read)
+    if (chunk.read_failed)
     {
-      excess_bytes = m_progress + bytes_to_read - m_groups[m_group_index + 1].offset;
+      ERROR_LOG_FMT(DISCIO, "Read failed at {:#x} to {:#x}", progress,
+                    progress + chunk.bytes_to_read);
+
+      m_read_errors_occurred = true;
+      m_calculating_any_hash = false;
     }
-  }
-  else if (m_group_index < m_groups.size() && m_groups[m_group_index].offset > m_progress)
-  {
-    bytes_to_read = std::min(bytes_to_read, m_groups[m_group_index].offset - m_progress);
-  }
 
-  if (m_progress + bytes_to_read > m_max_progress)
-  {
-    const u64 bytes_over_max = m_progress + bytes_to_read - m_max_progress;
+    if (m_calculating_any_hash)
+      chunks_to_hash = i + 1;
 
-    if (m_data_size_type == DataSizeType::LowerBound)
+    if (chunk.content)
     {
-      // Disc images in NFS format can have the last referenced block be past m_max_progress.
-      // For NFS, reading beyond m_max_progress doesn't return an error, so let's read beyond it.
-      excess_bytes = std::max(excess_bytes, bytes_over_max);
+      tasks.emplace_back([this, &chunk, &corrupt_content = corrupt_contents[i]] {
+        if (chunk.read_failed || !m_volume.CheckContentIntegrity(*chunk.content, *chunk.data,
+                                                                  m_ticket))
+        {
+          corrupt_content = chunk.content;
+        }
+      });
+      m_content_index++;
     }
-    else
+
+    if (chunk.group_index)
     {
-      // Don't read beyond the end of the disc.
-      bytes_to_read -= bytes_over_max;
-      excess_bytes -= std::min(excess_bytes, bytes_over_max);
-      content_read = false;
-      group_read = false;
+      tasks.emplace_back([this, &chunk] {
+        VerifyGroup(m_groups[*chunk.group_index], *chunk.data, chunk.read_failed);
+      });
+      m_group_index++;
     }
-  }
-
-  const bool is_data_needed = m_calculating_any_hash || content_read || group_read;
-  const bool read_failed = is_data_needed && !ReadChunkAndWaitForAsyncOperations(bytes_to_read);
 
-  if (read_failed)
-  {
-    ERROR_LOG_FMT(DISCIO, "Read failed at {:#x} to {:#x}", m_progress, m_progress + bytes_to_read);
-
-    m_read_errors_occurred = true;
-    m_calculating_any_hash = false;
+    progress += chunk.bytes_to_read - chunk.excess_bytes;
   }
 
-  m_excess_bytes = excess_bytes;
-  const u64 byte_increment = bytes_to_read - excess_bytes;
-
+  // Each hash has to be updated with the chunks in order, so each hash is one task
   if (m_calculating_any_hash)
   {
     if (m_hashes_to_calculate.crc32)
     {
-      m_crc32_future = std::async(std::launch::async, [this, byte_increment] {
-        m_crc32_context = Common::UpdateCRC32(m_crc32_context, m_data.data(),
-                                              static_cast<size_t>(byte_increment));
+      tasks.emplace_back([this, &chunks, chunks_to_hash] {
+        for (size_t i = 0; i < chunks_to_hash; ++i)
+        {
+          m_crc32_context = Common::UpdateCRC32(
+              m_crc32_context, chunks[i].data->data(),
+              static_cast<size_t>(chunks[i].bytes_to_read - chunks[i].excess_bytes));
+        }
       });
     }
 
     if (m_hashes_to_calculate.md5)
     {
-      m_md5_future = std::async(std::launch::async, [this, byte_increment] {
-        mbedtls_md5_update_ret(&m_md5_context, m_data.data(), byte_increment);
+      tasks.emplace_back([this, &chunks, chunks_to_hash] {
+        for (size_t i = 0; i < chunks_to_hash; ++i)
+        {
+          mbedtls_md5_update_ret(&m_md5_context, chunks[i].data->data(),
+                                 chunks[i].bytes_to_read - chunks[i].excess_bytes);
+        }
       });
     }
 
     if (m_hashes_to_calculate.sha1)
     {
-      m_sha1_future = std::async(std::launch::async, [this, byte_increment] {
-        m_sha1_context->Update(m_data.data(), byte_increment);
+      tasks.emplace_back([this, &chunks, chunks_to_hash] {
+        for (size_t i = 0; i < chunks_to_hash; ++i)
+        {
+          m_sha1_context->Update(chunks[i].data->data(),
+                                 chunks[i].bytes_to_read - chunks[i].excess_bytes);
+        }
       });
     }
   }
 
-  if (content_read)
-  {
-    m_content_future = std::async(std::launch::async, [this, read_failed, content] {
-      if (read_failed || !m_volume.CheckContentIntegrity(content, m_data, m_ticket))
-      {
-        AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content.id));
-      }
-    });
+  m_thread_pool.ParallelFor(static_cast<u32>(tasks.size()), [&tasks](u32 i) { tasks[i](); });
 
-    m_content_index++;
+  for (const std::optional<IOS::ES::Content>& content : corrupt_contents)
+  {
+    if (content)
+      AddProblem(Severity::High, Common::FmtFormatT("Content {0:08x} is corrupt.", content->id));
   }
 
-  if (group_read)
+  m_progress = progress;
+}
+
+void VolumeVerifier::VerifyGroup(const GroupToVerify& group, const std::vector<u8>& data,
+                                 bool read_failed)
+{
+  u64 biggest_verified_offset = 0;
+  size_t block_errors = 0;
+  size_t unused_block_errors = 0;
+
+  u64 offset_in_group = 0;
+  for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
+       ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
   {
-    m_group_future = std::async(std::launch::async, [this, read_failed,
-                                                     group_index = m_group_index] {
-      const GroupToVerify& group = m_groups[group_index];
-      u64 offset_in_group = 0;
-      for (u64 block_index = group.block_index_start; block_index < group.block_index_end;
-           ++block_index, offset_in_group += VolumeWii::BLOCK_TOTAL_SIZE)
-      {
-        const u64 block_offset = group.offset + offset_in_group;
+    const u64 block_offset = group.offset + offset_in_group;
 
-        if (!read_failed && m_volume.CheckBlockIntegrity(
-                                block_index, m_data.data() + offset_in_group, group.partition))
-        {
-          m_biggest_verified_offset =
-              std::max(m_biggest_verified_offset, block_offset + VolumeWii::BLOCK_TOTAL_SIZE);
-        }
-        else
-        {
-          if (m_scrubber.CanBlockBeScrubbed(block_offset))
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
-            m_unused_block_errors[group.partition]++;
-          }
-          else
-          {
-            WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
-            m_block_errors[group.partition]++;
-          }
-        }
+    if (!read_failed &&
+        m_volume.CheckBlockIntegrity(block_index, data.data() + offset_in_group, group.partition))
+    {
+      biggest_verified_offset = block_offset + VolumeWii::BLOCK_TOTAL_SIZE;
+    }
+    else
+    {
+      if (m_scrubber.CanBlockBeScrubbed(block_offset))
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for unused block at {:#x}", block_offset);
+        unused_block_errors++;
       }
-    });
-
-    m_group_index++;
+      else
+      {
+        WARN_LOG_FMT(DISCIO, "Integrity check failed for block at {:#x}", block_offset);
+        block_errors++;
+      }
+    }
   }
 
-  m_progress += byte_increment;
+  std::lock_guard lk(m_group_mutex);
+  m_biggest_verified_offset = std::max(m_biggest_verified_offset, biggest_verified_offset);
+  if (block_errors > 0)
+    m_block_errors[group.partition] += block_errors;
+  if (unused_block_errors > 0)
+    m_unused_block_errors[group.partition] += unused_block_errors;
 }
 
 u64 VolumeVerifier::GetBytesProcessed() const
@@ -1293,7 +1418,8 @@ void VolumeVerifier::Finish()
     return;
   m_done = true;
 
-  WaitForAsyncOperations();
+  StopReadAhead();
+  m_thread_pool.Stop();
 
   if (m_calculating_any_hash)
   {
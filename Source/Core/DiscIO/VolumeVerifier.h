@@ -3,17 +3,22 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <mbedtls/md5.h>
 
 #include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
+#include "Common/ThreadPool.h"
 #include "Core/IOS/ES/Formats.h"
 #include "DiscIO/DiscScrubber.h"
 #include "DiscIO/Volume.h"
@@ -27,7 +32,9 @@
 // verifier.Finish();
 // auto result = verifier.GetResult();
 //
-// Start, Process and Finish may take some time to run.
+// Start, Process and Finish may take some time to run. After Start, the volume is read on a
+// separate thread a few chunks ahead of Process, and the volume must not be used by anything else
+// until Finish has been called or the verifier has been destroyed.
 //
 // GetResult() can be called before the processing is finished, but the result will be incomplete.
 
@@ -124,10 +131,14 @@ public:
     RedumpVerifier::Result redump;
   };
 
-  VolumeVerifier(const Volume& volume, bool redump_verification, Hashes<bool> hashes_to_calculate);
+  // Hashes and Wii groups are checked on num_worker_threads threads in addition to the thread
+  // which calls Process. Verifiers which run at the same time should split the cores between them.
+  VolumeVerifier(const Volume& volume, bool redump_verification, Hashes<bool> hashes_to_calculate,
+                 u32 num_worker_threads = GetDefaultWorkerThreadCount());
   ~VolumeVerifier();
 
   static Hashes<bool> GetDefaultHashesToCalculate();
+  static u32 GetDefaultWorkerThreadCount();
   void Start();
   void Process();
   u64 GetBytesProcessed() const;
@@ -144,6 +155,16 @@ private:
     size_t block_index_end;
   };
 
+  struct ChunkToProcess
+  {
+    u64 bytes_to_read = 0;
+    u64 excess_bytes = 0;
+    std::optional<IOS::ES::Content> content;
+    std::optional<size_t> group_index;
+    std::shared_ptr<const std::vector<u8>> data;
+    bool read_failed = false;
+  };
+
   std::vector<Partition> CheckPartitions();
   bool CheckPartition(const Partition& partition);  // Returns false if partition should be ignored
   std::string GetPartitionName(std::optional<u32> type) const;
@@ -156,8 +177,10 @@ private:
   void CheckMisc();
   void CheckSuperPaperMario();
   void SetUpHashing();
-  void WaitForAsyncOperations() const;
-  bool ReadChunkAndWaitForAsyncOperations(u64 bytes_to_read);
+  ChunkToProcess GetNextChunk(u64 progress, u16* content_index, size_t* group_index) const;
+  void ReadAheadThread();
+  void StopReadAhead();
+  void VerifyGroup(const GroupToVerify& group, const std::vector<u8>& data, bool read_failed);
 
   void AddProblem(Severity severity, std::string text);
 
@@ -178,13 +201,23 @@ private:
   mbedtls_md5_context m_md5_context{};
   std::unique_ptr<Common::SHA1::Context> m_sha1_context;
 
-  u64 m_excess_bytes = 0;
-  std::vector<u8> m_data;
-  std::future<void> m_crc32_future;
-  std::future<void> m_md5_future;
-  std::future<void> m_sha1_future;
-  std::future<void> m_content_future;
-  std::future<void> m_group_future;
+  // Chunks which have been read by m_read_thread but not yet handled by Process
+  std::thread m_read_thread;
+  std::mutex m_read_mutex;
+  std::condition_variable m_chunk_read;
+  std::condition_variable m_chunk_taken;
+  std::deque<ChunkToProcess> m_read_chunks;
+  size_t m_max_read_chunks;
+  bool m_stop_reading = false;
+
+  Common::ThreadPool m_thread_pool;
+  u32 m_num_worker_threads;
+
+  // Guards the members below it, which are updated by the group checks on the thread pool
+  std::mutex m_group_mutex;
+  std::map<Partition, size_t> m_block_errors;
+  std::map<Partition, size_t> m_unused_block_errors;
+  u64 m_biggest_verified_offset = 0;
 
   DiscScrubber m_scrubber;
   IOS::ES::TicketReader m_ticket;
@@ -192,11 +225,8 @@ private:
   u16 m_content_index = 0;
   std::vector<GroupToVerify> m_groups;
   size_t m_group_index = 0;  // Index in m_groups, not index in a specific partition
-  std::map<Partition, size_t> m_block_errors;
-  std::map<Partition, size_t> m_unused_block_errors;
 
   u64 m_biggest_referenced_offset = 0;
-  u64 m_biggest_verified_offset = 0;
 
   bool m_started = false;
   bool m_done = false;
@@ -30,6 +30,7 @@
 #include "DiscIO/Enums.h"
 #include "DiscIO/FileSystemGCWii.h"
 #include "DiscIO/Filesystem.h"
+#include "DiscIO/SharedChunkCache.h"
 #include "DiscIO/Volume.h"
 #include "DiscIO/WiiSaveBanner.h"
 
@@ -43,6 +44,7 @@ VolumeWii::VolumeWii(std::unique_ptr<BlobReader> reader)
 
   m_has_hashes = m_reader->ReadSwapped<u8>(0x60) == u8(0);
   m_has_encryption = m_reader->ReadSwapped<u8>(0x61) == u8(0);
+  m_content_id = m_reader->GetContentID();
 
   if (m_has_encryption && !m_has_hashes)
     ERROR_LOG_FMT(DISCIO, "Wii disc has encryption but no hashes! This probably won't work well");
@@ -204,14 +206,29 @@ bool VolumeWii::Read(u64 offset, u64 length, u8* buffer, const Partition& partit
 
     if (m_last_decrypted_block != block_offset_on_disc)
     {
+      // The old data gets overwritten even if reading the new block fails
+      m_last_decrypted_block = UINT64_MAX;
+
       if (m_has_encryption)
       {
-        // Read the current block
-        if (!m_reader->Read(block_offset_on_disc, BLOCK_TOTAL_SIZE, read_buffer.get()))
-          return false;
+        SharedChunkCache* shared_cache = m_content_id ? SharedChunkCache::GetInstance() : nullptr;
+        const SharedChunkCache::Key shared_cache_key{m_content_id.value_or(Common::SHA1::Digest{}),
+                                                     SharedChunkCache::DataType::WiiDecryptedBlock,
+                                                     block_offset_on_disc, 0};
+
+        if (!shared_cache ||
+            !shared_cache->Get(shared_cache_key, m_last_decrypted_block_data, BLOCK_DATA_SIZE))
+        {
+          // Read the current block
+          if (!m_reader->Read(block_offset_on_disc, BLOCK_TOTAL_SIZE, read_buffer.get()))
+            return false;
+
+          // Decrypt the block's data
+          DecryptBlockData(read_buffer.get(), m_last_decrypted_block_data, aes_context);
 
-        // Decrypt the block's data
-        DecryptBlockData(read_buffer.get(), m_last_decrypted_block_data, aes_context);
+          if (shared_cache)
+            shared_cache->Insert(shared_cache_key, m_last_decrypted_block_data, BLOCK_DATA_SIZE);
+        }
       }
       else
       {
@@ -468,14 +485,10 @@ bool VolumeWii::CheckBlockIntegrity(u64 block_index, const u8* encrypted_data,
     cluster_data = encrypted_data + BLOCK_HEADER_SIZE;
   }
 
-  for (u32 hash_index = 0; hash_index < 31; ++hash_index)
-  {
-    if (Common::SHA1::CalculateDigest(&cluster_data[hash_index * 0x400], 0x400) !=
-        hashes.h0[hash_index])
-    {
-      return false;
-    }
-  }
+  std::array<Common::SHA1::Digest, 31> h0;
+  Common::SHA1::CalculateDigests(cluster_data, 0x400, 0x400, h0.size(), h0.data());
+  if (h0 != hashes.h0)
+    return false;
 
   if (Common::SHA1::CalculateDigest(hashes.h0) != hashes.h1[block_index % 8])
     return false;
@@ -526,8 +539,8 @@ bool VolumeWii::HashGroup(const std::array<u8, BLOCK_DATA_SIZE> in[BLOCKS_PER_GR
       if (success)
       {
         // H0 hashes
-        for (size_t j = 0; j < 31; ++j)
-          out[i].h0[j] = Common::SHA1::CalculateDigest(in[i].data() + j * 0x400, 0x400);
+        Common::SHA1::CalculateDigests(in[i].data(), 0x400, 0x400, out[i].h0.size(),
+                                       out[i].h0.data());
 
         // H0 padding
         out[i].padding_0 = {};
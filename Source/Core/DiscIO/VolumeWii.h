@@ -130,6 +130,8 @@ private:
   Partition m_game_partition;
   bool m_has_hashes;
   bool m_has_encryption;
+  // For sharing decrypted blocks with other processes through SharedChunkCache
+  std::optional<Common::SHA1::Digest> m_content_id;
 
   mutable u64 m_last_decrypted_block;
   mutable u8 m_last_decrypted_block_data[BLOCK_DATA_SIZE]{};
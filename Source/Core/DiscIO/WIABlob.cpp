@@ -27,8 +27,10 @@
 #include "Common/MsgHandler.h"
 #include "Common/ScopeGuard.h"
 #include "Common/Swap.h"
+#include "Common/Timer.h"
 
 #include "DiscIO/Blob.h"
+#include "DiscIO/DecompressionPool.h"
 #include "DiscIO/DiscUtils.h"
 #include "DiscIO/Filesystem.h"
 #include "DiscIO/LaggedFibonacciGenerator.h"
@@ -78,8 +80,10 @@ std::pair<int, int> GetAllowedCompressionLevels(WIARVZCompressionType compressio
 }
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path)
-    : m_file(std::move(file)), m_encryption_cache(this)
+WIARVZFileReader<RVZ>::WIARVZFileReader(File::IOFile file, const std::string& path,
+                                        u64 chunk_cache_size)
+    : m_file(std::move(file)), m_chunk_cache_size(chunk_cache_size),
+      m_encryption_cache(this, ENCRYPTION_CACHE_GROUPS)
 {
   m_valid = Initialize(path);
 }
@@ -158,6 +162,28 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
     return false;
   }
 
+  // RVZ files which use a Zstandard dictionary store its size in the compressor data,
+  // and the dictionary itself is stored right after header 2 (and covered by its hash)
+  if (RVZ && m_compression_type == WIARVZCompressionType::Zstd &&
+      m_header_2.compressor_data_size >= sizeof(u32))
+  {
+    u32 dictionary_size;
+    std::memcpy(&dictionary_size, m_header_2.compressor_data, sizeof(dictionary_size));
+    dictionary_size = Common::swap32(dictionary_size);
+
+    if (dictionary_size > header_2.size() || header_2.size() - dictionary_size < sizeof(WIAHeader2))
+      return false;
+
+    const auto dictionary_begin = header_2.begin() + sizeof(WIAHeader2);
+    m_zstd_dictionary = std::make_unique<ZstdDictionary>(
+        std::vector<u8>(dictionary_begin, dictionary_begin + dictionary_size));
+    if (!m_zstd_dictionary->PrepareForDecompression())
+    {
+      ERROR_LOG_FMT(DISCIO, "Invalid Zstandard dictionary in {}", path);
+      return false;
+    }
+  }
+
   const size_t number_of_partition_entries = Common::swap32(m_header_2.number_of_partition_entries);
   const size_t partition_entry_size = Common::swap32(m_header_2.partition_entry_size);
   std::vector<u8> partition_entries(partition_entry_size * number_of_partition_entries);
@@ -233,6 +259,16 @@ bool WIARVZFileReader<RVZ>::Initialize(const std::string& path)
   if (HasDataOverlap())
     return false;
 
+  // Identifies the file for SharedChunkCache. The headers are covered by header_1_hash, and the
+  // entries pin down where the data of every group is stored.
+  std::unique_ptr<Common::SHA1::Context> context = Common::SHA1::CreateContext();
+  context->Update(m_header_1.header_1_hash.data(), m_header_1.header_1_hash.size());
+  context->Update(reinterpret_cast<const u8*>(m_raw_data_entries.data()),
+                  m_raw_data_entries.size() * sizeof(RawDataEntry));
+  context->Update(reinterpret_cast<const u8*>(m_group_entries.data()),
+                  m_group_entries.size() * sizeof(GroupEntry));
+  m_content_id = context->Finish();
+
   return true;
 }
 
@@ -273,10 +309,11 @@ bool WIARVZFileReader<RVZ>::HasDataOverlap() const
 }
 
 template <bool RVZ>
-std::unique_ptr<WIARVZFileReader<RVZ>> WIARVZFileReader<RVZ>::Create(File::IOFile file,
-                                                                     const std::string& path)
+std::unique_ptr<WIARVZFileReader<RVZ>>
+WIARVZFileReader<RVZ>::Create(File::IOFile file, const std::string& path, u64 chunk_cache_size)
 {
-  std::unique_ptr<WIARVZFileReader> blob(new WIARVZFileReader(std::move(file), path));
+  std::unique_ptr<WIARVZFileReader> blob(
+      new WIARVZFileReader(std::move(file), path, chunk_cache_size));
   return blob->m_valid ? std::move(blob) : nullptr;
 }
 
@@ -365,6 +402,9 @@ bool WIARVZFileReader<RVZ>::Read(u64 offset, u64 size, u8* out_ptr)
 
         const u64 bytes_to_read = std::min(data_size - (offset - data_offset), size);
 
+        DecompressWiiGroupsInParallel(offset - partition_data_offset, bytes_to_read, partition,
+                                      partition_total_sectors * VolumeWii::BLOCK_DATA_SIZE);
+
         m_exception_list.clear();
         m_write_to_exception_list = true;
         m_exception_list_last_group_index = std::numeric_limits<u64>::max();
@@ -454,8 +494,7 @@ bool WIARVZFileReader<RVZ>::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
   if (!partition)
     return false;
 
-  const u64 chunk_size = Common::swap32(m_header_2.chunk_size) * VolumeWii::BLOCK_DATA_SIZE /
-                         VolumeWii::BLOCK_TOTAL_SIZE;
+  const u64 chunk_size = GetDecryptedChunkSize();
 
   for (const PartitionDataEntry& data : partition->data_entries)
   {
@@ -466,10 +505,10 @@ bool WIARVZFileReader<RVZ>::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
         (Common::swap32(data.first_sector) - partition_first_sector) * VolumeWii::BLOCK_DATA_SIZE;
     const u64 data_size = Common::swap32(data.number_of_sectors) * VolumeWii::BLOCK_DATA_SIZE;
 
-    if (!ReadFromGroups(
-            &offset, &size, &out_ptr, chunk_size, VolumeWii::BLOCK_DATA_SIZE, data_offset,
-            data_size, Common::swap32(data.group_index), Common::swap32(data.number_of_groups),
-            std::max<u32>(1, static_cast<u32>(chunk_size / VolumeWii::GROUP_DATA_SIZE))))
+    if (!ReadFromGroups(&offset, &size, &out_ptr, chunk_size, VolumeWii::BLOCK_DATA_SIZE,
+                        data_offset, data_size, Common::swap32(data.group_index),
+                        Common::swap32(data.number_of_groups),
+                        GetDecryptedExceptionLists(chunk_size)))
     {
       return false;
     }
@@ -478,6 +517,19 @@ bool WIARVZFileReader<RVZ>::ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr,
   return size == 0;
 }
 
+template <bool RVZ>
+u64 WIARVZFileReader<RVZ>::GetDecryptedChunkSize() const
+{
+  return Common::swap32(m_header_2.chunk_size) * VolumeWii::BLOCK_DATA_SIZE /
+         VolumeWii::BLOCK_TOTAL_SIZE;
+}
+
+template <bool RVZ>
+u32 WIARVZFileReader<RVZ>::GetDecryptedExceptionLists(u64 decrypted_chunk_size)
+{
+  return std::max<u32>(1, static_cast<u32>(decrypted_chunk_size / VolumeWii::GROUP_DATA_SIZE));
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr, u64 chunk_size,
                                            u32 sector_size, u64 data_offset, u64 data_size,
@@ -490,6 +542,21 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   if (*offset < data_offset)
     return false;
 
+  // Reads which span several chunks that aren't cached decompress them on the shared workers
+  if (GetDecompressionThreadCount() > 0 && *size > 0)
+  {
+    const u64 aligned_data_offset = data_offset - data_offset % sector_size;
+    const u64 end_offset = std::min(*offset + *size, data_offset + data_size);
+    if ((end_offset - 1 - aligned_data_offset) / chunk_size >
+        (*offset - aligned_data_offset) / chunk_size)
+    {
+      std::vector<ChunkParameters> chunks;
+      CollectGroupChunks(*offset, *size, chunk_size, sector_size, data_offset, data_size,
+                         group_index, number_of_groups, exception_lists, &chunks);
+      DecompressChunksInParallel(chunks);
+    }
+  }
+
   const u64 skipped_data = data_offset % sector_size;
   data_offset -= skipped_data;
   data_size += skipped_data;
@@ -501,44 +568,30 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
     if (total_group_index >= m_group_entries.size())
       return false;
 
-    const GroupEntry group = m_group_entries[total_group_index];
     const u64 group_offset_in_data = i * chunk_size;
     const u64 offset_in_group = *offset - group_offset_in_data - data_offset;
 
     chunk_size = std::min(chunk_size, data_size - group_offset_in_data);
 
     const u64 bytes_to_read = std::min(chunk_size - offset_in_group, *size);
-    u32 group_data_size = Common::swap32(group.data_size);
-
-    WIARVZCompressionType compression_type = m_compression_type;
-    u32 rvz_packed_size = 0;
-    if constexpr (RVZ)
-    {
-      if ((group_data_size & 0x80000000) == 0)
-        compression_type = WIARVZCompressionType::None;
 
-      group_data_size &= 0x7FFFFFFF;
+    const std::optional<ChunkParameters> parameters = GetGroupChunkParameters(
+        total_group_index, chunk_size, group_offset_in_data, exception_lists);
 
-      rvz_packed_size = Common::swap32(group.rvz_packed_size);
-    }
-
-    if (group_data_size == 0)
+    if (!parameters)
     {
       std::memset(*out_ptr, 0, bytes_to_read);
     }
     else
     {
-      const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
-
-      Chunk& chunk =
-          ReadCompressedData(group_offset_in_file, group_data_size, chunk_size, compression_type,
-                             exception_lists, rvz_packed_size, group_offset_in_data);
+      Chunk& chunk = ReadCompressedData(*parameters);
 
       if (!chunk.Read(offset_in_group, bytes_to_read, *out_ptr))
       {
-        m_cached_chunk_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+        EvictCachedChunk(parameters->offset_in_file);
         return false;
       }
+      ShareChunkIfDecompressed(*parameters, &chunk);
 
       if (m_write_to_exception_list && m_exception_list_last_group_index != total_group_index)
       {
@@ -559,6 +612,150 @@ bool WIARVZFileReader<RVZ>::ReadFromGroups(u64* offset, u64* size, u8** out_ptr,
   return true;
 }
 
+template <bool RVZ>
+std::optional<typename WIARVZFileReader<RVZ>::ChunkParameters>
+WIARVZFileReader<RVZ>::GetGroupChunkParameters(u64 total_group_index, u64 chunk_size,
+                                               u64 group_offset_in_data,
+                                               u32 exception_lists) const
+{
+  const GroupEntry& group = m_group_entries[total_group_index];
+  u32 group_data_size = Common::swap32(group.data_size);
+
+  WIARVZCompressionType compression_type = m_compression_type;
+  u32 rvz_packed_size = 0;
+  if constexpr (RVZ)
+  {
+    if ((group_data_size & 0x80000000) == 0)
+      compression_type = WIARVZCompressionType::None;
+
+    group_data_size &= 0x7FFFFFFF;
+
+    rvz_packed_size = Common::swap32(group.rvz_packed_size);
+  }
+
+  // A group without any data is all zeroes
+  if (group_data_size == 0)
+    return std::nullopt;
+
+  const u64 group_offset_in_file = static_cast<u64>(Common::swap32(group.data_offset)) << 2;
+  return ChunkParameters{group_offset_in_file, group_data_size, chunk_size, compression_type,
+                         exception_lists, rvz_packed_size, group_offset_in_data};
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::CollectGroupChunks(u64 offset, u64 size, u64 chunk_size,
+                                               u32 sector_size, u64 data_offset, u64 data_size,
+                                               u32 group_index, u32 number_of_groups,
+                                               u32 exception_lists,
+                                               std::vector<ChunkParameters>* chunks) const
+{
+  const u64 start_offset = std::max(offset, data_offset);
+  const u64 end_offset = std::min(offset + size, data_offset + data_size);
+  if (start_offset >= end_offset)
+    return;
+
+  const u64 skipped_data = data_offset % sector_size;
+  data_offset -= skipped_data;
+  data_size += skipped_data;
+
+  const u64 start_group_index = (start_offset - data_offset) / chunk_size;
+  const u64 end_group_index = (end_offset - 1 - data_offset) / chunk_size + 1;
+  for (u64 i = start_group_index; i < std::min<u64>(end_group_index, number_of_groups); ++i)
+  {
+    const u64 total_group_index = group_index + i;
+    if (total_group_index >= m_group_entries.size())
+      return;
+
+    const u64 group_offset_in_data = i * chunk_size;
+    const std::optional<ChunkParameters> parameters = GetGroupChunkParameters(
+        total_group_index, std::min(chunk_size, data_size - group_offset_in_data),
+        group_offset_in_data, exception_lists);
+    if (parameters)
+      chunks->push_back(*parameters);
+  }
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::DecompressWiiGroupsInParallel(u64 offset, u64 size,
+                                                          const PartitionEntry& partition,
+                                                          u64 partition_data_decrypted_size)
+{
+  if (GetDecompressionThreadCount() == 0 || size == 0)
+    return;
+
+  const u32 partition_first_sector = Common::swap32(partition.data_entries[0].first_sector);
+  const u64 partition_data_offset = partition_first_sector * VolumeWii::BLOCK_TOTAL_SIZE;
+  const u64 chunk_size = GetDecryptedChunkSize();
+  const u32 exception_lists = GetDecryptedExceptionLists(chunk_size);
+
+  // Groups which are still in the encryption cache don't need their chunks anymore
+  std::vector<ChunkParameters> chunks;
+  const u64 first_group = offset / VolumeWii::GROUP_TOTAL_SIZE;
+  const u64 last_group = (offset + size - 1) / VolumeWii::GROUP_TOTAL_SIZE;
+  for (u64 i = first_group; i <= last_group; ++i)
+  {
+    if (m_encryption_cache.HasGroup(i * VolumeWii::GROUP_TOTAL_SIZE, partition_data_offset))
+      continue;
+
+    const u64 group_offset = i * VolumeWii::GROUP_DATA_SIZE;
+    if (group_offset >= partition_data_decrypted_size)
+      break;
+    const u64 group_size =
+        std::min(VolumeWii::GROUP_DATA_SIZE, partition_data_decrypted_size - group_offset);
+
+    for (const PartitionDataEntry& data : partition.data_entries)
+    {
+      const u64 data_offset =
+          (Common::swap32(data.first_sector) - partition_first_sector) * VolumeWii::BLOCK_DATA_SIZE;
+      const u64 data_size = Common::swap32(data.number_of_sectors) * VolumeWii::BLOCK_DATA_SIZE;
+
+      CollectGroupChunks(group_offset, group_size, chunk_size, VolumeWii::BLOCK_DATA_SIZE,
+                         data_offset, data_size, Common::swap32(data.group_index),
+                         Common::swap32(data.number_of_groups), exception_lists, &chunks);
+    }
+  }
+
+  DecompressChunksInParallel(chunks);
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::DecompressChunksInParallel(const std::vector<ChunkParameters>& chunks)
+{
+  // Add the chunks to the cache first. They are only decompressed here if they all fit into the
+  // cache at once, since they would otherwise evict each other before getting read.
+  std::vector<std::pair<const ChunkParameters*, Chunk*>> new_chunks;
+  u64 memory_usage = 0;
+  for (const ChunkParameters& parameters : chunks)
+  {
+    if (FindCachedChunk(parameters.offset_in_file) != m_cached_chunks.end())
+      continue;
+
+    Chunk chunk = CreateChunk(parameters);
+    memory_usage += chunk.GetMemoryUsage();
+    if (memory_usage > m_chunk_cache_size)
+      break;
+
+    new_chunks.emplace_back(&parameters,
+                            &InsertCachedChunk(parameters.offset_in_file, std::move(chunk)));
+  }
+
+  // A single chunk gets decompressed by the read itself
+  if (new_chunks.size() < 2)
+    return;
+
+  std::vector<u8> failed(new_chunks.size());
+  ParallelDecompress(static_cast<u32>(new_chunks.size()), [&](u32 i) {
+    failed[i] = !DecompressAndShareChunk(*new_chunks[i].first, new_chunks[i].second);
+  });
+
+  // Let the read run into the error again, so that it gets reported the usual way
+  for (size_t i = 0; i < new_chunks.size(); ++i)
+  {
+    if (failed[i])
+      EvictCachedChunk(new_chunks[i].first->offset_in_file);
+  }
+}
+
 template <bool RVZ>
 typename WIARVZFileReader<RVZ>::Chunk&
 WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_size,
@@ -566,18 +763,52 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                           WIARVZCompressionType compression_type,
                                           u32 exception_lists, u32 rvz_packed_size, u64 data_offset)
 {
-  if (offset_in_file == m_cached_chunk_offset)
-    return m_cached_chunk;
+  return ReadCompressedData(ChunkParameters{offset_in_file, compressed_size, decompressed_size,
+                                            compression_type, exception_lists, rvz_packed_size,
+                                            data_offset});
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk&
+WIARVZFileReader<RVZ>::ReadCompressedData(const ChunkParameters& parameters)
+{
+  const auto it = FindCachedChunk(parameters.offset_in_file);
+  if (it != m_cached_chunks.end())
+  {
+    m_cached_chunks.splice(m_cached_chunks.begin(), m_cached_chunks, it);
+    return it->chunk;
+  }
+
+  return InsertCachedChunk(parameters.offset_in_file, CreateChunk(parameters));
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk
+WIARVZFileReader<RVZ>::CreateChunk(const ChunkParameters& parameters)
+{
+  SharedChunkCache* shared_cache = m_content_id ? SharedChunkCache::GetInstance() : nullptr;
+  if (shared_cache)
+  {
+    std::vector<u8> data;
+    if (shared_cache->Get(GetSharedCacheKey(parameters), parameters.decompressed_size, &data))
+    {
+      std::optional<Chunk> chunk =
+          Chunk::FromCacheableData(std::move(data), parameters.decompressed_size);
+      if (chunk)
+        return std::move(*chunk);
+    }
+  }
 
   std::unique_ptr<Decompressor> decompressor;
-  switch (compression_type)
+  switch (parameters.compression_type)
   {
   case WIARVZCompressionType::None:
     decompressor = std::make_unique<NoneDecompressor>();
     break;
   case WIARVZCompressionType::Purge:
-    decompressor = std::make_unique<PurgeDecompressor>(rvz_packed_size == 0 ? decompressed_size :
-                                                                              rvz_packed_size);
+    decompressor = std::make_unique<PurgeDecompressor>(
+        parameters.rvz_packed_size == 0 ? parameters.decompressed_size :
+                                          parameters.rvz_packed_size);
     break;
   case WIARVZCompressionType::Bzip2:
     decompressor = std::make_unique<Bzip2Decompressor>();
@@ -591,17 +822,98 @@ WIARVZFileReader<RVZ>::ReadCompressedData(u64 offset_in_file, u64 compressed_siz
                                                       m_header_2.compressor_data_size);
     break;
   case WIARVZCompressionType::Zstd:
-    decompressor = std::make_unique<ZstdDecompressor>();
+    decompressor = std::make_unique<ZstdDecompressor>(m_zstd_dictionary.get());
     break;
   }
 
-  const bool compressed_exception_lists = compression_type > WIARVZCompressionType::Purge;
+  const bool compressed_exception_lists =
+      parameters.compression_type > WIARVZCompressionType::Purge;
+
+  return Chunk(&m_file, &m_file_mutex, parameters.offset_in_file, parameters.compressed_size,
+               parameters.decompressed_size, parameters.exception_lists,
+               compressed_exception_lists, parameters.rvz_packed_size, parameters.data_offset,
+               std::move(decompressor));
+}
+
+template <bool RVZ>
+SharedChunkCache::Key
+WIARVZFileReader<RVZ>::GetSharedCacheKey(const ChunkParameters& parameters) const
+{
+  return SharedChunkCache::Key{*m_content_id, SharedChunkCache::DataType::WIARVZChunk,
+                               parameters.offset_in_file, parameters.data_offset};
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::DecompressAndShareChunk(const ChunkParameters& parameters,
+                                                    Chunk* chunk) const
+{
+  // Chunks which came from the shared cache are already decompressed
+  if (!chunk->IsDecompressed() && !chunk->DecompressAll())
+    return false;
+
+  ShareChunkIfDecompressed(parameters, chunk);
+  return true;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::ShareChunkIfDecompressed(const ChunkParameters& parameters,
+                                                     Chunk* chunk) const
+{
+  // Other processes can only use chunks that are fully decompressed. Reads that only need the
+  // start of a chunk don't decompress the rest of it just for sharing.
+  if (chunk->IsShared() || !chunk->IsDecompressed())
+    return;
+
+  SharedChunkCache* shared_cache = m_content_id ? SharedChunkCache::GetInstance() : nullptr;
+  if (!shared_cache)
+    return;
+
+  const std::vector<u8> data = chunk->GetCacheableData();
+  shared_cache->Insert(GetSharedCacheKey(parameters), parameters.decompressed_size, data.data(),
+                       data.size());
+  chunk->SetShared();
+}
+
+template <bool RVZ>
+typename std::list<typename WIARVZFileReader<RVZ>::CachedChunk>::iterator
+WIARVZFileReader<RVZ>::FindCachedChunk(u64 offset_in_file)
+{
+  const auto it = m_cached_chunk_map.find(offset_in_file);
+  return it != m_cached_chunk_map.end() ? it->second : m_cached_chunks.end();
+}
+
+template <bool RVZ>
+typename WIARVZFileReader<RVZ>::Chunk& WIARVZFileReader<RVZ>::InsertCachedChunk(u64 offset_in_file,
+                                                                                Chunk chunk)
+{
+  m_cached_chunks_memory_usage += chunk.GetMemoryUsage();
+  m_cached_chunks.push_front(CachedChunk{offset_in_file, std::move(chunk)});
+  m_cached_chunk_map[offset_in_file] = m_cached_chunks.begin();
+  TrimChunkCache();
+  return m_cached_chunks.front().chunk;
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::EvictCachedChunk(u64 offset_in_file)
+{
+  const auto it = FindCachedChunk(offset_in_file);
+  if (it == m_cached_chunks.end())
+    return;
 
-  m_cached_chunk =
-      Chunk(&m_file, offset_in_file, compressed_size, decompressed_size, exception_lists,
-            compressed_exception_lists, rvz_packed_size, data_offset, std::move(decompressor));
-  m_cached_chunk_offset = offset_in_file;
-  return m_cached_chunk;
+  m_cached_chunks_memory_usage -= it->chunk.GetMemoryUsage();
+  m_cached_chunk_map.erase(offset_in_file);
+  m_cached_chunks.erase(it);
+}
+
+template <bool RVZ>
+void WIARVZFileReader<RVZ>::TrimChunkCache()
+{
+  while (m_cached_chunks.size() > 1 && m_cached_chunks_memory_usage > m_chunk_cache_size)
+  {
+    m_cached_chunks_memory_usage -= m_cached_chunks.back().chunk.GetMemoryUsage();
+    m_cached_chunk_map.erase(m_cached_chunks.back().offset_in_file);
+    m_cached_chunks.pop_back();
+  }
 }
 
 template <bool RVZ>
@@ -622,11 +934,13 @@ template <bool RVZ>
 WIARVZFileReader<RVZ>::Chunk::Chunk() = default;
 
 template <bool RVZ>
-WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size,
+WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, std::mutex* file_mutex,
+                                    u64 offset_in_file, u64 compressed_size,
                                     u64 decompressed_size, u32 exception_lists,
                                     bool compressed_exception_lists, u32 rvz_packed_size,
                                     u64 data_offset, std::unique_ptr<Decompressor> decompressor)
-    : m_decompressor(std::move(decompressor)), m_file(file), m_offset_in_file(offset_in_file),
+    : m_decompressor(std::move(decompressor)), m_file(file), m_file_mutex(file_mutex),
+      m_offset_in_file(offset_in_file),
       m_exception_lists(exception_lists), m_compressed_exception_lists(compressed_exception_lists),
       m_rvz_packed_size(rvz_packed_size), m_data_offset(data_offset)
 {
@@ -645,16 +959,82 @@ WIARVZFileReader<RVZ>::Chunk::Chunk(File::IOFile* file, u64 offset_in_file, u64
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 {
-  if (!m_decompressor || !m_file ||
-      offset + size > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
-  {
+  if (!DecompressUpTo(offset + size))
+    return false;
+
+  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
+  return true;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressAll()
+{
+  return DecompressUpTo(m_out.data.size() - m_out_bytes_allocated_for_exceptions);
+}
+
+template <bool RVZ>
+std::vector<u8> WIARVZFileReader<RVZ>::Chunk::GetCacheableData() const
+{
+  ASSERT(m_exception_lists == 0);
+
+  const u8* exceptions = m_compressed_exception_lists ? m_out.data.data() : m_in.data.data();
+  const u32 exceptions_size =
+      static_cast<u32>(m_compressed_exception_lists ? m_out_bytes_used_for_exceptions :
+                                                      m_in_bytes_used_for_exceptions);
+  const size_t data_size = m_out.data.size() - m_out_bytes_allocated_for_exceptions;
+
+  std::vector<u8> result(sizeof(exceptions_size) + exceptions_size + data_size);
+  u8* ptr = result.data();
+  std::memcpy(ptr, &exceptions_size, sizeof(exceptions_size));
+  ptr += sizeof(exceptions_size);
+  std::memcpy(ptr, exceptions, exceptions_size);
+  ptr += exceptions_size;
+  std::memcpy(ptr, m_out.data.data() + m_out_bytes_used_for_exceptions, data_size);
+
+  return result;
+}
+
+template <bool RVZ>
+std::optional<typename WIARVZFileReader<RVZ>::Chunk>
+WIARVZFileReader<RVZ>::Chunk::FromCacheableData(std::vector<u8> data, u64 decompressed_size)
+{
+  u32 exceptions_size;
+  if (data.size() < sizeof(exceptions_size))
+    return std::nullopt;
+  std::memcpy(&exceptions_size, data.data(), sizeof(exceptions_size));
+  if (data.size() != sizeof(exceptions_size) + u64(exceptions_size) + decompressed_size)
+    return std::nullopt;
+
+  // The exceptions are placed where DecompressUpTo would have put compressed exception lists
+  data.erase(data.begin(), data.begin() + sizeof(exceptions_size));
+
+  Chunk chunk;
+  chunk.m_out.bytes_written = data.size();
+  chunk.m_out.data = std::move(data);
+  chunk.m_out_bytes_allocated_for_exceptions = exceptions_size;
+  chunk.m_out_bytes_used_for_exceptions = exceptions_size;
+  chunk.m_compressed_exception_lists = true;
+  chunk.m_shared = true;
+  return chunk;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::Chunk::DecompressUpTo(u64 end)
+{
+  if (end > m_out.data.size() - m_out_bytes_allocated_for_exceptions)
+    return false;
+
+  // Chunks created by FromCacheableData have no decompressor but all of their data
+  if (end <= GetOutBytesWrittenExcludingExceptions())
+    return true;
+
+  if (!m_decompressor || !m_file)
     return false;
-  }
 
-  while (offset + size > GetOutBytesWrittenExcludingExceptions())
+  while (end > GetOutBytesWrittenExcludingExceptions())
   {
     u64 bytes_to_read;
-    if (offset + size == m_out.data.size())
+    if (end == m_out.data.size())
     {
       // Read all the remaining data.
       bytes_to_read = m_in.data.size() - m_in.bytes_written;
@@ -667,7 +1047,7 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
 
       // The compressed data is probably not much bigger than the decompressed data.
       // Add a few bytes for possible compression overhead and for any hash exceptions.
-      bytes_to_read = offset + size - GetOutBytesWrittenExcludingExceptions() + 0x100;
+      bytes_to_read = end - GetOutBytesWrittenExcludingExceptions() + 0x100;
 
       // Align the access in an attempt to gain speed. But we don't actually know the
       // block size of the underlying storage device, so we just use the Wii block size.
@@ -685,10 +1065,13 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
       return false;
     }
 
-    if (!m_file->Seek(m_offset_in_file, File::SeekOrigin::Begin))
-      return false;
-    if (!m_file->ReadBytes(m_in.data.data() + m_in.bytes_written, bytes_to_read))
-      return false;
+    {
+      std::lock_guard lk(*m_file_mutex);
+      if (!m_file->Seek(m_offset_in_file, File::SeekOrigin::Begin))
+        return false;
+      if (!m_file->ReadBytes(m_in.data.data() + m_in.bytes_written, bytes_to_read))
+        return false;
+    }
 
     m_offset_in_file += bytes_to_read;
     m_in.bytes_written += bytes_to_read;
@@ -747,7 +1130,6 @@ bool WIARVZFileReader<RVZ>::Chunk::Read(u64 offset, u64 size, u8* out_ptr)
     }
   }
 
-  std::memcpy(out_ptr, m_out.data.data() + offset + m_out_bytes_used_for_exceptions, size);
   return true;
 }
 
@@ -1052,10 +1434,124 @@ std::optional<std::vector<u8>> WIARVZFileReader<RVZ>::Compress(Compressor* compr
   return std::vector<u8>(data, data + size);
 }
 
+template <bool RVZ>
+std::vector<u8> WIARVZFileReader<RVZ>::CreateZstdDictionary(BlobReader* infile,
+                                                            const VolumeDisc* infile_volume)
+{
+  // The bundled Zstandard library does not include the dictionary builder, so instead of training
+  // a dictionary, we use samples taken at evenly spaced offsets across the disc as a raw content
+  // dictionary. For Wii discs, the decrypted partition data is sampled, since that is what the
+  // chunks contain after RVZ has stripped the encryption.
+
+  struct Region
+  {
+    Partition partition;
+    u64 size;
+  };
+
+  std::vector<Region> regions;
+  const auto add_region = [&regions](Partition partition, u64 size) {
+    size = Common::AlignDown(size, ZSTD_DICTIONARY_SAMPLE_SIZE);
+    if (size != 0)
+      regions.push_back({partition, size});
+  };
+
+  if (infile_volume && infile_volume->GetVolumeType() == Platform::WiiDisc)
+  {
+    for (const Partition& partition : infile_volume->GetPartitions())
+    {
+      const std::optional<u64> data_size =
+          infile_volume->ReadSwappedAndShifted(partition.offset + 0x2bc, PARTITION_NONE);
+      if (data_size)
+      {
+        add_region(partition,
+                   *data_size / VolumeWii::BLOCK_TOTAL_SIZE * VolumeWii::BLOCK_DATA_SIZE);
+      }
+    }
+  }
+  else
+  {
+    add_region(PARTITION_NONE, infile->GetDataSize());
+  }
+
+  u64 total_size = 0;
+  for (const Region& region : regions)
+    total_size += region.size;
+  if (total_size == 0)
+    return {};
+
+  // Take more candidates than needed, since a lot of them will likely turn out to be junk data,
+  // encrypted data or padding, none of which is useful in a dictionary
+  constexpr size_t candidate_count = ZSTD_DICTIONARY_SAMPLES * 4;
+  const u64 step = std::max<u64>(
+      ZSTD_DICTIONARY_SAMPLE_SIZE,
+      Common::AlignDown(total_size / candidate_count, ZSTD_DICTIONARY_SAMPLE_SIZE));
+
+  ZSTD_CCtx* context = ZSTD_createCCtx();
+  if (!context)
+    return {};
+  Common::ScopeGuard context_guard{[context] { ZSTD_freeCCtx(context); }};
+
+  std::vector<u8> samples;
+  std::vector<u8> sample(ZSTD_DICTIONARY_SAMPLE_SIZE);
+  std::vector<u8> compressed(ZSTD_compressBound(ZSTD_DICTIONARY_SAMPLE_SIZE));
+
+  auto region = regions.begin();
+  u64 region_start = 0;
+  for (u64 position = 0; position < total_size; position += step)
+  {
+    while (position - region_start >= region->size)
+    {
+      region_start += region->size;
+      ++region;
+    }
+
+    const u64 offset = position - region_start;
+    const bool success =
+        region->partition == PARTITION_NONE ?
+            infile->Read(offset, sample.size(), sample.data()) :
+            infile_volume->Read(offset, sample.size(), sample.data(), region->partition);
+    if (!success)
+      continue;
+
+    if (std::all_of(sample.begin(), sample.end(), [&](u8 x) { return x == sample[0]; }))
+      continue;
+
+    const size_t compressed_size = ZSTD_compressCCtx(context, compressed.data(), compressed.size(),
+                                                     sample.data(), sample.size(), 1);
+    if (ZSTD_isError(compressed_size) || compressed_size > sample.size() * 7 / 8)
+      continue;
+
+    samples.insert(samples.end(), sample.begin(), sample.end());
+  }
+
+  // If there are more usable samples than needed, pick samples spread out across the whole disc
+  const size_t usable_samples = samples.size() / ZSTD_DICTIONARY_SAMPLE_SIZE;
+  const size_t sample_step = std::max<size_t>(1, usable_samples / ZSTD_DICTIONARY_SAMPLES);
+  constexpr size_t max_dictionary_size = ZSTD_DICTIONARY_SAMPLES * ZSTD_DICTIONARY_SAMPLE_SIZE;
+
+  std::vector<u8> dictionary;
+  for (size_t i = 0; i < usable_samples && dictionary.size() < max_dictionary_size;
+       i += sample_step)
+  {
+    const auto begin = samples.begin() + i * ZSTD_DICTIONARY_SAMPLE_SIZE;
+    dictionary.insert(dictionary.end(), begin, begin + ZSTD_DICTIONARY_SAMPLE_SIZE);
+  }
+
+  // Zstandard would try to parse a dictionary starting with its magic number as a formatted
+  // dictionary rather than as raw content
+  if (dictionary.size() >= sizeof(u32) && Common::swap32(dictionary.data()) == 0x37A430EC)
+    dictionary.erase(dictionary.begin(), dictionary.begin() + sizeof(u32));
+
+  return dictionary;
+}
+
 template <bool RVZ>
 void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                                             WIARVZCompressionType compression_type,
-                                            int compression_level, WIAHeader2* header_2)
+                                            int compression_level,
+                                            const ZstdDictionary* zstd_dictionary,
+                                            WIAHeader2* header_2)
 {
   switch (compression_type)
   {
@@ -1086,7 +1582,7 @@ void WIARVZFileReader<RVZ>::SetUpCompressor(std::unique_ptr<Compressor>* compres
     break;
   }
   case WIARVZCompressionType::Zstd:
-    *compressor = std::make_unique<ZstdCompressor>(compression_level);
+    *compressor = std::make_unique<ZstdCompressor>(compression_level, zstd_dictionary);
     break;
   }
 }
@@ -1294,6 +1790,8 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
                                           u64 chunks_per_wii_group, u64 exception_lists_per_chunk,
                                           bool compressed_exception_lists, bool compression)
 {
+  const u64 process_start_us = Common::Timer::NowUs();
+
   std::vector<OutputParametersEntry> output_entries;
 
   if (!parameters.data_entry->is_partition)
@@ -1538,6 +2036,9 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
     }
   }
 
+  const u64 compress_start_us = Common::Timer::NowUs();
+  state->stage_times->process_us += compress_start_us - process_start_us;
+
   for (OutputParametersEntry& entry : output_entries)
   {
     TryReuse(reusable_groups, reusable_groups_mutex, &entry);
@@ -1629,6 +2130,8 @@ WIARVZFileReader<RVZ>::ProcessAndCompress(CompressThreadState* state, CompressPa
     }
   }
 
+  state->stage_times->compress_us += Common::Timer::NowUs() - compress_start_us;
+
   return OutputParameters{std::move(output_entries), parameters.bytes_read, parameters.group_index};
 }
 
@@ -1703,6 +2206,79 @@ ConversionResultCode WIARVZFileReader<RVZ>::RunCallback(size_t groups_written, u
                                       ConversionResultCode::Canceled;
 }
 
+template <bool RVZ>
+std::optional<typename WIARVZFileReader<RVZ>::Checkpoint>
+WIARVZFileReader<RVZ>::ReadCheckpoint(const std::string& path,
+                                      const Common::SHA1::Digest& conversion_id,
+                                      std::vector<GroupEntry>* group_entries)
+{
+  // Checkpoints are only meant to be used on the machine that created them,
+  // so everything except the group entries is stored in native endianness
+
+  std::string data;
+  if (!File::ReadFileToString(path, data))
+    return std::nullopt;
+
+  constexpr size_t header_size = sizeof(u32) * 2 + Common::SHA1::DIGEST_LEN + sizeof(Checkpoint);
+  if (data.size() < header_size + Common::SHA1::DIGEST_LEN)
+    return std::nullopt;
+
+  const u8* ptr = reinterpret_cast<const u8*>(data.data());
+  const size_t hashed_size = data.size() - Common::SHA1::DIGEST_LEN;
+  if (!std::equal(ptr + hashed_size, ptr + data.size(),
+                  Common::SHA1::CalculateDigest(ptr, hashed_size).begin()))
+  {
+    return std::nullopt;
+  }
+
+  u32 magic;
+  u32 version;
+  Common::SHA1::Digest file_conversion_id;
+  Checkpoint checkpoint;
+  std::memcpy(&magic, ptr, sizeof(magic));
+  ptr += sizeof(magic);
+  std::memcpy(&version, ptr, sizeof(version));
+  ptr += sizeof(version);
+  std::memcpy(file_conversion_id.data(), ptr, file_conversion_id.size());
+  ptr += file_conversion_id.size();
+  std::memcpy(&checkpoint, ptr, sizeof(checkpoint));
+  ptr += sizeof(checkpoint);
+
+  if (magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION ||
+      file_conversion_id != conversion_id || checkpoint.groups_written > group_entries->size() ||
+      hashed_size - header_size != checkpoint.groups_written * sizeof(GroupEntry))
+  {
+    return std::nullopt;
+  }
+
+  std::memcpy(group_entries->data(), ptr, checkpoint.groups_written * sizeof(GroupEntry));
+  return checkpoint;
+}
+
+template <bool RVZ>
+bool WIARVZFileReader<RVZ>::WriteCheckpoint(const std::string& path,
+                                            const Common::SHA1::Digest& conversion_id,
+                                            const Checkpoint& checkpoint,
+                                            const std::vector<GroupEntry>& group_entries)
+{
+  std::vector<u8> data;
+  PushBack(&data, CHECKPOINT_MAGIC);
+  PushBack(&data, CHECKPOINT_VERSION);
+  PushBack(&data, conversion_id);
+  PushBack(&data, checkpoint);
+  PushBack(&data, reinterpret_cast<const u8*>(group_entries.data()),
+           reinterpret_cast<const u8*>(group_entries.data() + checkpoint.groups_written));
+  PushBack(&data, Common::SHA1::CalculateDigest(data));
+
+  // Write to a temporary file first so that a crash can't leave a half-written checkpoint behind
+  const std::string temp_path = path + ".tmp";
+  File::IOFile file(temp_path, "wb");
+  if (!file.WriteBytes(data.data(), data.size()) || !file.Close())
+    return false;
+
+  return File::Rename(temp_path, path);
+}
+
 template <bool RVZ>
 bool WIARVZFileReader<RVZ>::WriteHeader(File::IOFile* file, const u8* data, size_t size,
                                         u64 upper_bound, u64* bytes_written, u64* offset_out)
@@ -1729,11 +2305,28 @@ template <bool RVZ>
 ConversionResultCode
 WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                File::IOFile* outfile, WIARVZCompressionType compression_type,
-                               int compression_level, int chunk_size, CompressCB callback)
+                               int compression_level, int chunk_size, bool zstd_dictionary,
+                               CompressCB callback, const std::string& checkpoint_path,
+                               ConversionStatistics* statistics)
 {
   ASSERT(infile->GetDataSizeType() == DataSizeType::Accurate);
   ASSERT(chunk_size > 0);
 
+  const u64 start_us = Common::Timer::NowUs();
+
+  std::unique_ptr<ZstdDictionary> dictionary;
+  if (RVZ && compression_type == WIARVZCompressionType::Zstd && zstd_dictionary)
+  {
+    std::vector<u8> dictionary_data = CreateZstdDictionary(infile, infile_volume);
+    if (!dictionary_data.empty())
+    {
+      dictionary = std::make_unique<ZstdDictionary>(std::move(dictionary_data));
+      if (!dictionary->PrepareForCompression(compression_level))
+        return ConversionResultCode::InternalError;
+    }
+  }
+  const size_t dictionary_size = dictionary ? dictionary->GetData().size() : 0;
+
   const u64 iso_size = infile->GetDataSize();
   const u64 chunks_per_wii_group = std::max<u64>(1, VolumeWii::GROUP_TOTAL_SIZE / chunk_size);
   const u64 exception_lists_per_chunk = std::max<u64>(1, chunk_size / VolumeWii::GROUP_TOTAL_SIZE);
@@ -1774,8 +2367,8 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   // fit in that space, we will need to write them at the end of the file instead.
   const u64 headers_size_upper_bound = [&] {
     // 0x100 is added to account for compression overhead (in particular for Purge).
-    u64 upper_bound = sizeof(WIAHeader1) + sizeof(WIAHeader2) + partition_entries_size +
-                      raw_data_entries_size + 0x100;
+    u64 upper_bound = sizeof(WIAHeader1) + sizeof(WIAHeader2) + dictionary_size +
+                      partition_entries_size + raw_data_entries_size + 0x100;
 
     // Compared to WIA, RVZ adds an extra member to the GroupEntry struct. This added data usually
     // compresses well, so we'll assume the compression ratio for RVZ GroupEntries is 9 / 16 or
@@ -1791,21 +2384,79 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
     return Common::AlignUp(upper_bound, VolumeWii::BLOCK_TOTAL_SIZE);
   }();
 
-  std::vector<u8> buffer;
-
-  buffer.resize(headers_size_upper_bound);
-  outfile->WriteBytes(buffer.data(), buffer.size());
-  bytes_written = headers_size_upper_bound;
-
   if (!infile->Read(0, header_2.disc_header.size(), header_2.disc_header.data()))
     return ConversionResultCode::ReadFailed;
   // We intentionally do not increment bytes_read here, since these bytes will be read again
 
+  // Identifies the input and the settings, so that we don't resume from a checkpoint which was
+  // made by a conversion that would have resulted in a different output file
+  Common::SHA1::Digest conversion_id{};
+  std::optional<Checkpoint> checkpoint;
+  if (!checkpoint_path.empty())
+  {
+    auto context = Common::SHA1::CreateContext();
+    const auto update = [&context](const auto& x) {
+      context->Update(reinterpret_cast<const u8*>(&x), sizeof(x));
+    };
+    update(RVZ);
+    update(iso_size);
+    update(compression_type);
+    update(compression_level);
+    update(chunk_size);
+    update(header_2.disc_header);
+    context->Update(reinterpret_cast<const u8*>(partition_entries.data()), partition_entries_size);
+    context->Update(reinterpret_cast<const u8*>(raw_data_entries.data()), raw_data_entries_size);
+    if (dictionary)
+      context->Update(dictionary->GetData());
+    conversion_id = context->Finish();
+
+    checkpoint = ReadCheckpoint(checkpoint_path, conversion_id, &group_entries);
+    if (checkpoint && outfile->GetSize() < checkpoint->bytes_written)
+      checkpoint.reset();
+  }
+
+  std::vector<u8> buffer;
+  u64 groups_already_written = 0;
+
+  if (checkpoint)
+  {
+    // Discard anything that was written after the checkpoint was made
+    if (!outfile->Resize(checkpoint->bytes_written) || !outfile->Seek(0, File::SeekOrigin::End))
+      return ConversionResultCode::WriteFailed;
+
+    groups_already_written = checkpoint->groups_written;
+    bytes_written = checkpoint->bytes_written;
+
+    NOTICE_LOG_FMT(DISCIO, "Resuming conversion at block {} of {}", groups_already_written,
+                   total_groups);
+  }
+  else
+  {
+    // A checkpoint which doesn't match this conversion must not be left behind
+    if (!checkpoint_path.empty())
+      File::Delete(checkpoint_path, File::IfAbsentBehavior::NoConsoleWarning);
+
+    if (!outfile->Resize(0) || !outfile->Seek(0, File::SeekOrigin::Begin))
+      return ConversionResultCode::WriteFailed;
+
+    buffer.resize(headers_size_upper_bound);
+    outfile->WriteBytes(buffer.data(), buffer.size());
+    bytes_written = headers_size_upper_bound;
+  }
+
   std::map<ReuseID, GroupEntry> reusable_groups;
   std::mutex reusable_groups_mutex;
 
+  StageTimes stage_times;
+  u64 read_us = 0;
+  u64 write_us = 0;
+  u64 next_checkpoint = Common::AlignUp(checkpoint ? checkpoint->bytes_read + 1 : 1,
+                                        CHECKPOINT_INTERVAL);
+
   const auto set_up_compress_thread_state = [&](CompressThreadState* state) {
-    SetUpCompressor(&state->compressor, compression_type, compression_level, nullptr);
+    SetUpCompressor(&state->compressor, compression_type, compression_level, dictionary.get(),
+                    nullptr);
+    state->stage_times = &stage_times;
     return ConversionResultCode::Success;
   };
 
@@ -1824,15 +2475,35 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   };
 
   const auto output = [&](OutputParameters parameters) {
+    const u64 write_start_us = Common::Timer::NowUs();
     const ConversionResultCode result =
         Output(&parameters.entries, outfile, &reusable_groups, &reusable_groups_mutex,
                &group_entries[parameters.group_index], &bytes_written);
+    write_us += Common::Timer::NowUs() - write_start_us;
 
     if (result != ConversionResultCode::Success)
       return result;
 
-    return RunCallback(parameters.group_index + parameters.entries.size(), parameters.bytes_read,
-                       bytes_written, total_groups, iso_size, callback);
+    const size_t groups_written = parameters.group_index + parameters.entries.size();
+
+    if (!checkpoint_path.empty() && parameters.bytes_read >= next_checkpoint)
+    {
+      // The data has to actually be in the file before we write a checkpoint that refers to it
+      if (!outfile->Flush())
+        return ConversionResultCode::WriteFailed;
+
+      if (!WriteCheckpoint(checkpoint_path, conversion_id,
+                           Checkpoint{groups_written, parameters.bytes_read, bytes_written},
+                           group_entries))
+      {
+        WARN_LOG_FMT(DISCIO, "Failed to write conversion checkpoint to {}", checkpoint_path);
+      }
+
+      next_checkpoint = Common::AlignUp(parameters.bytes_read + 1, CHECKPOINT_INTERVAL);
+    }
+
+    return RunCallback(groups_written, parameters.bytes_read, bytes_written, total_groups,
+                       iso_size, callback);
   };
 
   MultithreadedCompressor<CompressThreadState, CompressParameters, OutputParameters> mt_compressor(
@@ -1897,13 +2568,23 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
         bytes_to_read = std::max<u64>(bytes_to_read, VolumeWii::GROUP_TOTAL_SIZE);
       bytes_to_read = std::min<u64>(bytes_to_read, data_offset + data_size - bytes_read);
 
-      buffer.resize(bytes_to_read);
-      if (!infile->Read(bytes_read, bytes_to_read, buffer.data()))
-        return ConversionResultCode::ReadFailed;
-      bytes_read += bytes_to_read;
-
-      mt_compressor.CompressAndWrite(CompressParameters{
-          buffer, &data_entry, data_offset_in_partition, bytes_read, groups_processed});
+      if (groups_processed < groups_already_written)
+      {
+        // This data was converted before resuming from the checkpoint
+        bytes_read += bytes_to_read;
+      }
+      else
+      {
+        const u64 read_start_us = Common::Timer::NowUs();
+        buffer.resize(bytes_to_read);
+        if (!infile->Read(bytes_read, bytes_to_read, buffer.data()))
+          return ConversionResultCode::ReadFailed;
+        bytes_read += bytes_to_read;
+        read_us += Common::Timer::NowUs() - read_start_us;
+
+        mt_compressor.CompressAndWrite(CompressParameters{
+            buffer, &data_entry, data_offset_in_partition, bytes_read, groups_processed});
+      }
 
       data_offset += bytes_to_read;
       data_size -= bytes_to_read;
@@ -1933,8 +2614,18 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   if (status != ConversionResultCode::Success)
     return status;
 
+  if (statistics)
+  {
+    statistics->bytes_read = iso_size - (checkpoint ? checkpoint->bytes_read : 0);
+    statistics->read_us = read_us;
+    statistics->process_us = stage_times.process_us.load();
+    statistics->compress_us = stage_times.compress_us.load();
+    statistics->write_us = write_us;
+  }
+
   std::unique_ptr<Compressor> compressor;
-  SetUpCompressor(&compressor, compression_type, compression_level, &header_2);
+  SetUpCompressor(&compressor, compression_type, compression_level, dictionary.get(),
+                  &header_2);
 
   const std::optional<std::vector<u8>> compressed_raw_data_entries = Compress(
       compressor.get(), reinterpret_cast<u8*>(raw_data_entries.data()), raw_data_entries_size);
@@ -1950,6 +2641,20 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   if (!outfile->Seek(sizeof(WIAHeader1) + sizeof(WIAHeader2), File::SeekOrigin::Begin))
     return ConversionResultCode::WriteFailed;
 
+  if (dictionary)
+  {
+    // The dictionary is part of header 2 as far as header_2_size and header_2_hash are concerned
+    if (!outfile->WriteBytes(dictionary->GetData().data(), dictionary_size))
+      return ConversionResultCode::WriteFailed;
+    bytes_written += dictionary_size;
+    if (!PadTo4(outfile, &bytes_written))
+      return ConversionResultCode::WriteFailed;
+
+    const u32 dictionary_size_be = Common::swap32(static_cast<u32>(dictionary_size));
+    std::memcpy(header_2.compressor_data, &dictionary_size_be, sizeof(dictionary_size_be));
+    header_2.compressor_data_size = sizeof(dictionary_size_be);
+  }
+
   u64 partition_entries_offset;
   if (!WriteHeader(outfile, reinterpret_cast<u8*>(partition_entries.data()), partition_entries_size,
                    headers_size_upper_bound, &bytes_written, &partition_entries_offset))
@@ -2004,11 +2709,24 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
 
   header_1.magic = RVZ ? RVZ_MAGIC : WIA_MAGIC;
   header_1.version = Common::swap32(RVZ ? RVZ_VERSION : WIA_VERSION);
-  header_1.version_compatible =
-      Common::swap32(RVZ ? RVZ_VERSION_WRITE_COMPATIBLE : WIA_VERSION_WRITE_COMPATIBLE);
-  header_1.header_2_size = Common::swap32(sizeof(WIAHeader2));
-  header_1.header_2_hash =
-      Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_2), sizeof(header_2));
+  if (dictionary)
+  {
+    header_1.version_compatible = Common::swap32(RVZ_VERSION_ZSTD_DICTIONARY_COMPATIBLE);
+    header_1.header_2_size = Common::swap32(static_cast<u32>(sizeof(WIAHeader2) + dictionary_size));
+
+    auto context = Common::SHA1::CreateContext();
+    context->Update(reinterpret_cast<const u8*>(&header_2), sizeof(header_2));
+    context->Update(dictionary->GetData());
+    header_1.header_2_hash = context->Finish();
+  }
+  else
+  {
+    header_1.version_compatible =
+        Common::swap32(RVZ ? RVZ_VERSION_WRITE_COMPATIBLE : WIA_VERSION_WRITE_COMPATIBLE);
+    header_1.header_2_size = Common::swap32(sizeof(WIAHeader2));
+    header_1.header_2_hash =
+        Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_2), sizeof(header_2));
+  }
   header_1.iso_file_size = Common::swap64(infile->GetDataSize());
   header_1.wia_file_size = Common::swap64(outfile->GetSize());
   header_1.header_1_hash = Common::SHA1::CalculateDigest(reinterpret_cast<const u8*>(&header_1),
@@ -2022,15 +2740,22 @@ WIARVZFileReader<RVZ>::Convert(BlobReader* infile, const VolumeDisc* infile_volu
   if (!outfile->WriteArray(&header_2, 1))
     return ConversionResultCode::WriteFailed;
 
+  if (statistics)
+    statistics->total_us = Common::Timer::NowUs() - start_us;
+
   return ConversionResultCode::Success;
 }
 
 bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                        const std::string& outfile_path, bool rvz,
                        WIARVZCompressionType compression_type, int compression_level,
-                       int chunk_size, CompressCB callback)
+                       int chunk_size, bool zstd_dictionary, CompressCB callback,
+                       const std::string& checkpoint_path, ConversionStatistics* statistics)
 {
-  File::IOFile outfile(outfile_path, "wb");
+  // When there is a checkpoint, the existing output file has to be kept so that it can be resumed
+  const bool resumable = !checkpoint_path.empty() && File::Exists(checkpoint_path) &&
+                         File::Exists(outfile_path);
+  File::IOFile outfile(outfile_path, resumable ? "r+b" : "wb");
   if (!outfile)
   {
     PanicAlertFmtT(
@@ -2046,7 +2771,7 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
   const auto convert = rvz ? RVZFileReader::Convert : WIAFileReader::Convert;
   const ConversionResultCode result =
       convert(infile, infile_volume.get(), &outfile, compression_type, compression_level,
-              chunk_size, callback);
+              chunk_size, zstd_dictionary, callback, checkpoint_path, statistics);
 
   if (result == ConversionResultCode::ReadFailed)
     PanicAlertFmtT("Failed to read from the input file \"{0}\".", infile_path);
@@ -2058,9 +2783,14 @@ bool ConvertToWIAOrRVZ(BlobReader* infile, const std::string& infile_path,
                    outfile_path);
   }
 
-  if (result != ConversionResultCode::Success)
+  if (result == ConversionResultCode::Success)
+  {
+    if (!checkpoint_path.empty())
+      File::Delete(checkpoint_path, File::IfAbsentBehavior::NoConsoleWarning);
+  }
+  else if (checkpoint_path.empty() || !File::Exists(checkpoint_path))
   {
-    // Remove the incomplete output file
+    // Remove the incomplete output file, unless a checkpoint makes it possible to resume later
     outfile.Close();
     File::Delete(outfile_path);
   }
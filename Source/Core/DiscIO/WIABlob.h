@@ -4,11 +4,16 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <limits>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
 
 #include "Common/CommonTypes.h"
@@ -17,6 +22,7 @@
 #include "Common/Swap.h"
 #include "DiscIO/Blob.h"
 #include "DiscIO/MultithreadedCompressor.h"
+#include "DiscIO/SharedChunkCache.h"
 #include "DiscIO/WIACompression.h"
 #include "DiscIO/WiiEncryptionCache.h"
 
@@ -46,7 +52,9 @@ class WIARVZFileReader : public BlobReader
 public:
   ~WIARVZFileReader();
 
-  static std::unique_ptr<WIARVZFileReader> Create(File::IOFile file, const std::string& path);
+  static std::unique_ptr<WIARVZFileReader>
+  Create(File::IOFile file, const std::string& path,
+         u64 chunk_cache_size = DEFAULT_CHUNK_CACHE_SIZE);
 
   BlobType GetBlobType() const override;
 
@@ -62,13 +70,25 @@ public:
     return static_cast<int>(static_cast<s32>(Common::swap32(m_header_2.compression_level)));
   }
 
+  std::optional<Common::SHA1::Digest> GetContentID() const override { return m_content_id; }
+
   bool Read(u64 offset, u64 size, u8* out_ptr) override;
   bool SupportsReadWiiDecrypted(u64 offset, u64 size, u64 partition_data_offset) const override;
   bool ReadWiiDecrypted(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset) override;
 
+  // zstd_dictionary only has an effect for RVZ files using Zstandard. It makes all chunks get
+  // compressed using a dictionary made from samples of the disc, which improves the compression
+  // ratio of small chunks. Files using this can't be read by older versions of Dolphin.
+  //
+  // If checkpoint_path is not empty, the progress of the conversion is regularly saved there, and
+  // if a checkpoint from an earlier conversion with the same input and settings already exists
+  // there, the conversion continues where that conversion left off. outfile must then be opened
+  // for both reading and writing.
   static ConversionResultCode Convert(BlobReader* infile, const VolumeDisc* infile_volume,
                                       File::IOFile* outfile, WIARVZCompressionType compression_type,
-                                      int compression_level, int chunk_size, CompressCB callback);
+                                      int compression_level, int chunk_size, bool zstd_dictionary,
+                                      CompressCB callback, const std::string& checkpoint_path,
+                                      ConversionStatistics* statistics);
 
 private:
   using WiiKey = std::array<u8, 16>;
@@ -183,16 +203,48 @@ private:
     }
   };
 
+  struct ChunkParameters
+  {
+    u64 offset_in_file;
+    u64 compressed_size;
+    u64 decompressed_size;
+    WIARVZCompressionType compression_type;
+    u32 exception_lists;
+    u32 rvz_packed_size;
+    u64 data_offset;
+  };
+
   class Chunk
   {
   public:
     Chunk();
-    Chunk(File::IOFile* file, u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
-          u32 exception_lists, bool compressed_exception_lists, u32 rvz_packed_size,
-          u64 data_offset, std::unique_ptr<Decompressor> decompressor);
+    Chunk(File::IOFile* file, std::mutex* file_mutex, u64 offset_in_file, u64 compressed_size,
+          u64 decompressed_size, u32 exception_lists, bool compressed_exception_lists,
+          u32 rvz_packed_size, u64 data_offset, std::unique_ptr<Decompressor> decompressor);
 
     bool Read(u64 offset, u64 size, u8* out_ptr);
 
+    // Chunks which are decompressed on different threads at the same time must share file_mutex
+    bool DecompressAll();
+
+    size_t GetMemoryUsage() const { return m_in.data.size() + m_out.data.size(); }
+
+    // Returns the hash exceptions and the decompressed data in a form that FromCacheableData can
+    // turn back into a chunk. This can only be called once DecompressAll has succeeded.
+    std::vector<u8> GetCacheableData() const;
+    // Creates an already decompressed chunk from data returned by GetCacheableData
+    static std::optional<Chunk> FromCacheableData(std::vector<u8> data, u64 decompressed_size);
+
+    bool IsDecompressed() const
+    {
+      return GetOutBytesWrittenExcludingExceptions() ==
+             m_out.data.size() - m_out_bytes_allocated_for_exceptions;
+    }
+
+    // Whether the chunk has been offered to other processes, or came from them
+    bool IsShared() const { return m_shared; }
+    void SetShared() { m_shared = true; }
+
     // This can only be called once at least one byte of data has been read
     void GetHashExceptions(std::vector<HashExceptionEntry>* exception_list,
                            u64 exception_list_index, u16 additional_offset) const;
@@ -204,6 +256,7 @@ private:
     }
 
   private:
+    bool DecompressUpTo(u64 end);
     bool Decompress();
     bool HandleExceptions(const u8* data, size_t bytes_allocated, size_t bytes_written,
                           size_t* bytes_used, bool align);
@@ -216,6 +269,7 @@ private:
 
     std::unique_ptr<Decompressor> m_decompressor = nullptr;
     File::IOFile* m_file = nullptr;
+    std::mutex* m_file_mutex = nullptr;
     u64 m_offset_in_file = 0;
 
     size_t m_out_bytes_allocated_for_exceptions = 0;
@@ -225,9 +279,16 @@ private:
     bool m_compressed_exception_lists = false;
     u32 m_rvz_packed_size = 0;
     u64 m_data_offset = 0;
+    bool m_shared = false;
+  };
+
+  struct CachedChunk
+  {
+    u64 offset_in_file;
+    Chunk chunk;
   };
 
-  explicit WIARVZFileReader(File::IOFile file, const std::string& path);
+  WIARVZFileReader(File::IOFile file, const std::string& path, u64 chunk_cache_size);
   bool Initialize(const std::string& path);
   bool HasDataOverlap() const;
 
@@ -236,9 +297,35 @@ private:
   bool ReadFromGroups(u64* offset, u64* size, u8** out_ptr, u64 chunk_size, u32 sector_size,
                       u64 data_offset, u64 data_size, u32 group_index, u32 number_of_groups,
                       u32 exception_lists);
+  std::optional<ChunkParameters> GetGroupChunkParameters(u64 total_group_index, u64 chunk_size,
+                                                         u64 group_offset_in_data,
+                                                         u32 exception_lists) const;
+  void CollectGroupChunks(u64 offset, u64 size, u64 chunk_size, u32 sector_size, u64 data_offset,
+                          u64 data_size, u32 group_index, u32 number_of_groups,
+                          u32 exception_lists, std::vector<ChunkParameters>* chunks) const;
+  // Decompresses the chunks that Read will need for re-encrypting the given groups
+  void DecompressWiiGroupsInParallel(u64 offset, u64 size, const PartitionEntry& partition,
+                                     u64 partition_data_decrypted_size);
+  void DecompressChunksInParallel(const std::vector<ChunkParameters>& chunks);
+
+  u64 GetDecryptedChunkSize() const;
+  static u32 GetDecryptedExceptionLists(u64 decrypted_chunk_size);
+
   Chunk& ReadCompressedData(u64 offset_in_file, u64 compressed_size, u64 decompressed_size,
                             WIARVZCompressionType compression_type, u32 exception_lists = 0,
                             u32 rvz_packed_size = 0, u64 data_offset = 0);
+  Chunk& ReadCompressedData(const ChunkParameters& parameters);
+  Chunk CreateChunk(const ChunkParameters& parameters);
+  SharedChunkCache::Key GetSharedCacheKey(const ChunkParameters& parameters) const;
+  // Fully decompresses a chunk which was just created and offers it to other processes through
+  // SharedChunkCache. Can be called for different chunks on several threads at once.
+  bool DecompressAndShareChunk(const ChunkParameters& parameters, Chunk* chunk) const;
+  // Offers a chunk to other processes if reads have decompressed all of it
+  void ShareChunkIfDecompressed(const ChunkParameters& parameters, Chunk* chunk) const;
+  typename std::list<CachedChunk>::iterator FindCachedChunk(u64 offset_in_file);
+  Chunk& InsertCachedChunk(u64 offset_in_file, Chunk chunk);
+  void EvictCachedChunk(u64 offset_in_file);
+  void TrimChunkCache();
 
   static bool ApplyHashExceptions(const std::vector<HashExceptionEntry>& exception_list,
                                   VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]);
@@ -273,11 +360,18 @@ private:
     u8 value;
   };
 
+  struct StageTimes
+  {
+    std::atomic<u64> process_us = 0;
+    std::atomic<u64> compress_us = 0;
+  };
+
   struct CompressThreadState
   {
     using WiiBlockData = std::array<u8, VolumeWii::BLOCK_DATA_SIZE>;
 
     std::unique_ptr<Compressor> compressor;
+    StageTimes* stage_times = nullptr;
 
     std::vector<WiiBlockData> decryption_buffer =
         std::vector<WiiBlockData>(VolumeWii::BLOCKS_PER_GROUP);
@@ -342,7 +436,22 @@ private:
 
   static void SetUpCompressor(std::unique_ptr<Compressor>* compressor,
                               WIARVZCompressionType compression_type, int compression_level,
-                              WIAHeader2* header_2);
+                              const ZstdDictionary* zstd_dictionary, WIAHeader2* header_2);
+  static std::vector<u8> CreateZstdDictionary(BlobReader* infile, const VolumeDisc* infile_volume);
+
+  struct Checkpoint
+  {
+    u64 groups_written;
+    u64 bytes_read;
+    u64 bytes_written;
+  };
+
+  static std::optional<Checkpoint> ReadCheckpoint(const std::string& path,
+                                                  const Common::SHA1::Digest& conversion_id,
+                                                  std::vector<GroupEntry>* group_entries);
+  static bool WriteCheckpoint(const std::string& path, const Common::SHA1::Digest& conversion_id,
+                              const Checkpoint& checkpoint,
+                              const std::vector<GroupEntry>& group_entries);
   static bool TryReuse(std::map<ReuseID, GroupEntry>* reusable_groups,
                        std::mutex* reusable_groups_mutex, OutputParametersEntry* entry);
   static ConversionResult<OutputParameters>
@@ -365,8 +474,16 @@ private:
   WIARVZCompressionType m_compression_type;
 
   File::IOFile m_file;
-  Chunk m_cached_chunk;
-  u64 m_cached_chunk_offset = std::numeric_limits<u64>::max();
+  std::mutex m_file_mutex;
+
+  // Decompressed chunks are kept in memory up to m_chunk_cache_size bytes (but at least one chunk),
+  // so that reads alternating between a few areas of the disc don't decompress the same chunks
+  // repeatedly. Most recently used first.
+  std::list<CachedChunk> m_cached_chunks;
+  std::unordered_map<u64, typename std::list<CachedChunk>::iterator> m_cached_chunk_map;
+  size_t m_cached_chunks_memory_usage = 0;
+  u64 m_chunk_cache_size;
+
   WiiEncryptionCache m_encryption_cache;
 
   std::vector<HashExceptionEntry> m_exception_list;
@@ -375,12 +492,19 @@ private:
 
   WIAHeader1 m_header_1;
   WIAHeader2 m_header_2;
+  std::unique_ptr<ZstdDictionary> m_zstd_dictionary;
   std::vector<PartitionEntry> m_partition_entries;
   std::vector<RawDataEntry> m_raw_data_entries;
   std::vector<GroupEntry> m_group_entries;
 
   std::map<u64, DataEntry> m_data_entries;
 
+  // Set once the file has been successfully opened. Chunks are only shared with other processes
+  // through SharedChunkCache after that.
+  std::optional<Common::SHA1::Digest> m_content_id;
+
+  static constexpr size_t ENCRYPTION_CACHE_GROUPS = 4;
+
   // Perhaps we could set WIA_VERSION_WRITE_COMPATIBLE to 0.9, but WIA version 0.9 was never in
   // any official release of wit, and interim versions (either source or binaries) are hard to find.
   // Since we've been unable to check if we're write compatible with 0.9, we set it 1.0 to be safe.
@@ -389,9 +513,20 @@ private:
   static constexpr u32 WIA_VERSION_WRITE_COMPATIBLE = 0x01000000;
   static constexpr u32 WIA_VERSION_READ_COMPATIBLE = 0x00080000;
 
-  static constexpr u32 RVZ_VERSION = 0x01000000;
+  static constexpr u32 RVZ_VERSION = 0x01010000;
   static constexpr u32 RVZ_VERSION_WRITE_COMPATIBLE = 0x00030000;
   static constexpr u32 RVZ_VERSION_READ_COMPATIBLE = 0x00030000;
+  // Used instead of RVZ_VERSION_WRITE_COMPATIBLE for files that use a Zstandard dictionary
+  static constexpr u32 RVZ_VERSION_ZSTD_DICTIONARY_COMPATIBLE = 0x01010000;
+
+  static constexpr u32 CHECKPOINT_MAGIC = 0x5A565243;  // "CRVZ" (byteswapped to little endian)
+  static constexpr u32 CHECKPOINT_VERSION = 1;
+  // How much input data to convert between writing checkpoints
+  static constexpr u64 CHECKPOINT_INTERVAL = 0x10000000;
+
+  // The Zstandard dictionary is made of this many samples of this size
+  static constexpr size_t ZSTD_DICTIONARY_SAMPLES = 32;
+  static constexpr size_t ZSTD_DICTIONARY_SAMPLE_SIZE = 0x1000;
 };
 
 using WIAFileReader = WIARVZFileReader<false>;
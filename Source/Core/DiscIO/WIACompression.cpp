@@ -9,6 +9,7 @@
 #include <limits>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include <bzlib.h>
@@ -256,9 +257,40 @@ bool LZMADecompressor::Decompress(const DecompressionBuffer& in, DecompressionBu
   return result == LZMA_OK || result == LZMA_STREAM_END;
 }
 
-ZstdDecompressor::ZstdDecompressor()
+ZstdDictionary::ZstdDictionary(std::vector<u8> data) : m_data(std::move(data))
+{
+}
+
+ZstdDictionary::~ZstdDictionary()
+{
+  ZSTD_freeCDict(m_cdict);
+  ZSTD_freeDDict(m_ddict);
+}
+
+bool ZstdDictionary::PrepareForCompression(int compression_level)
+{
+  ZSTD_freeCDict(m_cdict);
+  m_cdict = ZSTD_createCDict(m_data.data(), m_data.size(), compression_level);
+  return m_cdict != nullptr;
+}
+
+bool ZstdDictionary::PrepareForDecompression()
+{
+  ZSTD_freeDDict(m_ddict);
+  m_ddict = ZSTD_createDDict(m_data.data(), m_data.size());
+  return m_ddict != nullptr;
+}
+
+ZstdDecompressor::ZstdDecompressor(const ZstdDictionary* dictionary)
 {
   m_stream = ZSTD_createDStream();
+
+  if (m_stream && dictionary &&
+      ZSTD_isError(ZSTD_DCtx_refDDict(m_stream, dictionary->GetDDict())))
+  {
+    ZSTD_freeDStream(m_stream);
+    m_stream = nullptr;
+  }
 }
 
 ZstdDecompressor::~ZstdDecompressor()
@@ -733,12 +765,13 @@ size_t LZMACompressor::GetSize() const
   return static_cast<size_t>(m_stream.next_out - m_buffer.data());
 }
 
-ZstdCompressor::ZstdCompressor(int compression_level)
+ZstdCompressor::ZstdCompressor(int compression_level, const ZstdDictionary* dictionary)
 {
   m_stream = ZSTD_createCStream();
 
   if (ZSTD_isError(ZSTD_CCtx_setParameter(m_stream, ZSTD_c_compressionLevel, compression_level)) ||
-      ZSTD_isError(ZSTD_CCtx_setParameter(m_stream, ZSTD_c_contentSizeFlag, 0)))
+      ZSTD_isError(ZSTD_CCtx_setParameter(m_stream, ZSTD_c_contentSizeFlag, 0)) ||
+      (dictionary && ZSTD_isError(ZSTD_CCtx_refCDict(m_stream, dictionary->GetCDict()))))
   {
     m_stream = nullptr;
   }
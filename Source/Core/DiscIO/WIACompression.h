@@ -102,10 +102,34 @@ private:
   bool m_error_occurred = false;
 };
 
+// A raw content dictionary which all Zstandard compressed data in an RVZ file is compressed with.
+// Once prepared, the digested dictionary is read-only and can be shared between threads.
+class ZstdDictionary final
+{
+public:
+  explicit ZstdDictionary(std::vector<u8> data);
+  ~ZstdDictionary();
+
+  ZstdDictionary(const ZstdDictionary&) = delete;
+  ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+  bool PrepareForCompression(int compression_level);
+  bool PrepareForDecompression();
+
+  const std::vector<u8>& GetData() const { return m_data; }
+  const ZSTD_CDict* GetCDict() const { return m_cdict; }
+  const ZSTD_DDict* GetDDict() const { return m_ddict; }
+
+private:
+  std::vector<u8> m_data;
+  ZSTD_CDict* m_cdict = nullptr;
+  ZSTD_DDict* m_ddict = nullptr;
+};
+
 class ZstdDecompressor final : public Decompressor
 {
 public:
-  ZstdDecompressor();
+  explicit ZstdDecompressor(const ZstdDictionary* dictionary = nullptr);
   ~ZstdDecompressor();
 
   bool Decompress(const DecompressionBuffer& in, DecompressionBuffer* out,
@@ -228,7 +252,7 @@ private:
 class ZstdCompressor final : public Compressor
 {
 public:
-  ZstdCompressor(int compression_level);
+  ZstdCompressor(int compression_level, const ZstdDictionary* dictionary = nullptr);
   ~ZstdCompressor();
 
   bool Start(std::optional<u64> size) override;
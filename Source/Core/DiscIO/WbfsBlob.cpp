@@ -24,8 +24,8 @@ static const u64 WII_SECTOR_SIZE = 0x8000;
 static const u64 WII_SECTOR_COUNT = 143432 * 2;
 static const u64 WII_DISC_HEADER_SIZE = 256;
 
-WbfsFileReader::WbfsFileReader(File::IOFile file, const std::string& path)
-    : m_size(0), m_good(false)
+WbfsFileReader::WbfsFileReader(File::IOFile file, const std::string& path, bool memory_mapped)
+    : m_size(0), m_good(false), m_memory_mapped(memory_mapped)
 {
   if (!AddFileToList(std::move(file)))
     return;
@@ -77,9 +77,13 @@ bool WbfsFileReader::AddFileToList(File::IOFile file)
     return false;
 
   const u64 file_size = file.GetSize();
-  m_files.emplace_back(std::move(file), m_size, file_size);
+  FileEntry& entry = m_files.emplace_back(std::move(file), m_size, file_size);
   m_size += file_size;
 
+  // If mapping is disabled or fails, we simply keep using regular reads
+  if (m_memory_mapped)
+    entry.mapping.Map(entry.file);
+
   return true;
 }
 
@@ -119,15 +123,21 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
 
   while (nbytes)
   {
+    u64 file_offset;
     u64 read_size;
-    File::IOFile& data_file = SeekToCluster(offset, &read_size);
-    if (read_size == 0)
+    FileEntry* file_entry = FindCluster(offset, &file_offset, &read_size);
+    if (!file_entry)
       return false;
     read_size = std::min(read_size, nbytes);
 
-    if (!data_file.ReadBytes(out_ptr, read_size))
+    if (file_entry->mapping.IsMapped())
+    {
+      std::memcpy(out_ptr, file_entry->mapping.GetData() + file_offset, read_size);
+    }
+    else if (!(file_entry->file.Seek(file_offset, File::SeekOrigin::Begin) &&
+               file_entry->file.ReadBytes(out_ptr, read_size)))
     {
-      data_file.ClearError();
+      file_entry->file.ClearError();
       return false;
     }
 
@@ -139,7 +149,8 @@ bool WbfsFileReader::Read(u64 offset, u64 nbytes, u8* out_ptr)
   return true;
 }
 
-File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
+WbfsFileReader::FileEntry* WbfsFileReader::FindCluster(u64 offset, u64* file_offset,
+                                                       u64* available)
 {
   u64 base_cluster = (offset >> m_header.wbfs_sector_shift);
   if (base_cluster < m_blocks_per_disc)
@@ -152,29 +163,25 @@ File::IOFile& WbfsFileReader::SeekToCluster(u64 offset, u64* available)
     {
       if (final_address < (file_entry.base_address + file_entry.size))
       {
-        file_entry.file.Seek(final_address - file_entry.base_address, File::SeekOrigin::Begin);
-        if (available)
-        {
-          u64 till_end_of_file = file_entry.size - (final_address - file_entry.base_address);
-          u64 till_end_of_sector = m_wbfs_sector_size - cluster_offset;
-          *available = std::min(till_end_of_file, till_end_of_sector);
-        }
-
-        return file_entry.file;
+        *file_offset = final_address - file_entry.base_address;
+        u64 till_end_of_file = file_entry.size - *file_offset;
+        u64 till_end_of_sector = m_wbfs_sector_size - cluster_offset;
+        *available = std::min(till_end_of_file, till_end_of_sector);
+
+        return &file_entry;
       }
     }
   }
 
   ERROR_LOG_FMT(DISCIO, "Read beyond end of disc");
-  if (available)
-    *available = 0;
-  m_files[0].file.Seek(0, File::SeekOrigin::Begin);
-  return m_files[0].file;
+  return nullptr;
 }
 
-std::unique_ptr<WbfsFileReader> WbfsFileReader::Create(File::IOFile file, const std::string& path)
+std::unique_ptr<WbfsFileReader> WbfsFileReader::Create(File::IOFile file, const std::string& path,
+                                                       bool memory_mapped)
 {
-  auto reader = std::unique_ptr<WbfsFileReader>(new WbfsFileReader(std::move(file), path));
+  auto reader =
+      std::unique_ptr<WbfsFileReader>(new WbfsFileReader(std::move(file), path, memory_mapped));
 
   if (!reader->IsGood())
     reader.reset();
@@ -9,6 +9,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "DiscIO/Blob.h"
 
 namespace DiscIO
@@ -20,7 +21,8 @@ class WbfsFileReader : public BlobReader
 public:
   ~WbfsFileReader();
 
-  static std::unique_ptr<WbfsFileReader> Create(File::IOFile file, const std::string& path);
+  static std::unique_ptr<WbfsFileReader> Create(File::IOFile file, const std::string& path,
+                                                bool memory_mapped = false);
 
   BlobType GetBlobType() const override { return BlobType::WBFS; }
 
@@ -36,13 +38,12 @@ public:
   bool Read(u64 offset, u64 nbytes, u8* out_ptr) override;
 
 private:
-  WbfsFileReader(File::IOFile file, const std::string& path);
+  WbfsFileReader(File::IOFile file, const std::string& path, bool memory_mapped);
 
   void OpenAdditionalFiles(const std::string& path);
   bool AddFileToList(File::IOFile file);
   bool ReadHeader();
 
-  File::IOFile& SeekToCluster(u64 offset, u64* available);
   bool IsGood() { return m_good; }
   struct FileEntry
   {
@@ -52,10 +53,13 @@ private:
     }
 
     File::IOFile file;
+    File::MappedFile mapping;
     u64 base_address;
     u64 size;
   };
 
+  FileEntry* FindCluster(u64 offset, u64* file_offset, u64* available);
+
   std::vector<FileEntry> m_files;
 
   u64 m_size;
@@ -81,6 +85,7 @@ private:
   u64 m_blocks_per_disc;
 
   bool m_good;
+  bool m_memory_mapped;
 };
 
 }  // namespace DiscIO
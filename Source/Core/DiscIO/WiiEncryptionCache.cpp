@@ -3,6 +3,7 @@
 
 #include "DiscIO/WiiEncryptionCache.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <limits>
@@ -15,7 +16,8 @@
 
 namespace DiscIO
 {
-WiiEncryptionCache::WiiEncryptionCache(BlobReader* blob) : m_blob(blob)
+WiiEncryptionCache::WiiEncryptionCache(BlobReader* blob, size_t max_groups)
+    : m_blob(blob), m_max_groups(std::max<size_t>(1, max_groups))
 {
 }
 
@@ -26,43 +28,63 @@ WiiEncryptionCache::EncryptGroup(u64 offset, u64 partition_data_offset,
                                  u64 partition_data_decrypted_size, const Key& key,
                                  const HashExceptionCallback& hash_exception_callback)
 {
-  // Only allocate memory if this function actually ends up getting called
-  if (!m_cache)
-  {
-    m_cache = std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>();
-    m_cached_offset = std::numeric_limits<u64>::max();
-  }
-
   ASSERT(offset % VolumeWii::GROUP_TOTAL_SIZE == 0);
   const u64 group_offset_in_partition =
       offset / VolumeWii::GROUP_TOTAL_SIZE * VolumeWii::GROUP_DATA_SIZE;
   const u64 group_offset_on_disc = partition_data_offset + offset;
 
-  if (m_cached_offset != group_offset_on_disc)
+  const auto it = std::find_if(m_cache.begin(), m_cache.end(), [&](const CachedGroup& group) {
+    return group.offset == group_offset_on_disc;
+  });
+  if (it != m_cache.end())
+  {
+    std::rotate(m_cache.begin(), it, it + 1);
+    return m_cache.front().data.get();
+  }
+
+  // Only allocate memory if this function actually ends up getting called
+  if (m_cache.size() < m_max_groups)
+  {
+    m_cache.insert(m_cache.begin(),
+                   CachedGroup{std::numeric_limits<u64>::max(),
+                               std::make_unique<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>>()});
+  }
+  else
+  {
+    std::rotate(m_cache.begin(), m_cache.end() - 1, m_cache.end());
+  }
+
+  CachedGroup& group = m_cache.front();
+
+  std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
+
+  if (hash_exception_callback)
   {
-    std::function<void(VolumeWii::HashBlock * hash_blocks)> hash_exception_callback_2;
-
-    if (hash_exception_callback)
-    {
-      hash_exception_callback_2 =
-          [offset, &hash_exception_callback](
-              VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
-            return hash_exception_callback(hash_blocks, offset);
-          };
-    }
-
-    if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
-                                 partition_data_decrypted_size, key, m_blob, m_cache.get(),
-                                 hash_exception_callback_2))
-    {
-      m_cached_offset = std::numeric_limits<u64>::max();  // Invalidate the cache
-      return nullptr;
-    }
-
-    m_cached_offset = group_offset_on_disc;
+    hash_exception_callback_2 =
+        [offset, &hash_exception_callback](
+            VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP]) {
+          return hash_exception_callback(hash_blocks, offset);
+        };
   }
 
-  return m_cache.get();
+  if (!VolumeWii::EncryptGroup(group_offset_in_partition, partition_data_offset,
+                               partition_data_decrypted_size, key, m_blob, group.data.get(),
+                               hash_exception_callback_2))
+  {
+    group.offset = std::numeric_limits<u64>::max();  // Invalidate the cache
+    return nullptr;
+  }
+
+  group.offset = group_offset_on_disc;
+  return group.data.get();
+}
+
+bool WiiEncryptionCache::HasGroup(u64 offset, u64 partition_data_offset) const
+{
+  const u64 group_offset_on_disc = partition_data_offset + offset;
+  return std::any_of(m_cache.begin(), m_cache.end(), [&](const CachedGroup& group) {
+    return group.offset == group_offset_on_disc;
+  });
 }
 
 bool WiiEncryptionCache::EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset,
@@ -6,6 +6,7 @@
 #include <array>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "DiscIO/VolumeWii.h"
@@ -22,7 +23,8 @@ public:
       VolumeWii::HashBlock hash_blocks[VolumeWii::BLOCKS_PER_GROUP], u64 offset)>;
 
   // The blob pointer is kept around for the lifetime of this object.
-  explicit WiiEncryptionCache(BlobReader* blob);
+  // Up to max_groups encrypted groups are kept, with the least recently used one being replaced.
+  explicit WiiEncryptionCache(BlobReader* blob, size_t max_groups = 1);
   ~WiiEncryptionCache();
 
   WiiEncryptionCache(WiiEncryptionCache&&) = default;
@@ -41,6 +43,9 @@ public:
   EncryptGroup(u64 offset, u64 partition_data_offset, u64 partition_data_decrypted_size,
                const Key& key, const HashExceptionCallback& hash_exception_callback = {});
 
+  // Returns whether EncryptGroup can return the given group without reading from the blob.
+  bool HasGroup(u64 offset, u64 partition_data_offset) const;
+
   // Encrypts a variable number of groups, as determined by the offset and size parameters.
   // Supports reading groups partially.
   bool EncryptGroups(u64 offset, u64 size, u8* out_ptr, u64 partition_data_offset,
@@ -48,9 +53,17 @@ public:
                      const HashExceptionCallback& hash_exception_callback = {});
 
 private:
+  struct CachedGroup
+  {
+    u64 offset;
+    std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> data;
+  };
+
   BlobReader* m_blob;
-  std::unique_ptr<std::array<u8, VolumeWii::GROUP_TOTAL_SIZE>> m_cache;
-  u64 m_cached_offset = 0;
+  size_t m_max_groups;
+
+  // Most recently used first
+  std::vector<CachedGroup> m_cache;
 };
 
 }  // namespace DiscIO
@@ -30,6 +30,7 @@
 #include "Core/IOS/USB/Bluetooth/BTBase.h"
 #include "Core/IOS/USB/Bluetooth/BTReal.h"
 #include "Core/State.h"
+#include "Core/StateRewind.h"
 #include "Core/System.h"
 #include "Core/WiiUtils.h"
 
@@ -604,6 +605,9 @@ void HotkeyScheduler::Run()
     if (IsHotkey(HK_UNDO_SAVE_STATE))
       emit StateSaveUndo();
 
+    if (IsHotkey(HK_REWIND_STATE))
+      State::Rewind();
+
     if (IsHotkey(HK_LOAD_STATE_FILE))
       emit StateLoadFile();
 
@@ -7,9 +7,11 @@
 #include <limits>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <OptionParser.h>
+#include <fmt/format.h>
 
 #include "Common/CommonTypes.h"
 #include "DiscIO/Blob.h"
@@ -23,6 +25,24 @@
 
 namespace DolphinTool
 {
+static void PrintThroughput(const DiscIO::ConversionStatistics& statistics)
+{
+  const auto print_stage = [&statistics](std::string_view name, u64 us) {
+    const double mib_per_second =
+        us == 0 ? 0.0 : static_cast<double>(statistics.bytes_read) / us * 1000000 / (1024 * 1024);
+    std::cout << fmt::format("{:<9} {:>10.1f} MiB/s {:>10.2f} s", name, mib_per_second,
+                             us / 1000000.0)
+              << std::endl;
+  };
+
+  // The process and compress stages run on several threads, so their throughput is per thread
+  print_stage("Read", statistics.read_us);
+  print_stage("Process", statistics.process_us);
+  print_stage("Compress", statistics.compress_us);
+  print_stage("Write", statistics.write_us);
+  print_stage("Total", statistics.total_us);
+}
+
 int ConvertCommand::Main(const std::vector<std::string>& args)
 {
   optparse::OptionParser parser;
@@ -75,6 +95,21 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
       .help("Level of compression for the selected method. Ignored if 'none'. Suggested value for "
             "zstd: 5");
 
+  parser.add_option("-z", "--zstd_dictionary")
+      .action("store_true")
+      .help("Compress RVZ chunks using a dictionary sampled from the disc. Only for zstd. "
+            "Improves the compression ratio for small block sizes, but the output cannot be read "
+            "by older versions of Dolphin.");
+
+  parser.add_option("-r", "--resumable")
+      .action("store_true")
+      .help("Regularly save the progress of WIA/RVZ conversions to a checkpoint file next to the "
+            "output, and resume from that checkpoint if the conversion was interrupted before.");
+
+  parser.add_option("-t", "--throughput")
+      .action("store_true")
+      .help("Print the throughput of each stage of WIA/RVZ conversions when done.");
+
   const optparse::Values& options = parser.parse_args(args);
 
   // Initialize the dolphin user directory, required for temporary processing files
@@ -270,6 +305,27 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
     }
   }
 
+  // --zstd_dictionary
+  const bool zstd_dictionary = static_cast<bool>(options.get("zstd_dictionary"));
+  if (zstd_dictionary && (format != DiscIO::BlobType::RVZ ||
+                          compression_o != DiscIO::WIARVZCompressionType::Zstd))
+  {
+    std::cerr << "Error: A Zstandard dictionary can only be used for RVZ with zstd compression"
+              << std::endl;
+    return 1;
+  }
+
+  // --resumable, --throughput
+  const bool resumable = static_cast<bool>(options.get("resumable"));
+  const bool throughput = static_cast<bool>(options.get("throughput"));
+  if ((resumable || throughput) && format != DiscIO::BlobType::WIA &&
+      format != DiscIO::BlobType::RVZ)
+  {
+    std::cerr << "Warning: --resumable and --throughput only apply to WIA and RVZ. Continuing "
+                 "anyway."
+              << std::endl;
+  }
+
   // Perform the conversion
   const auto NOOP_STATUS_CALLBACK = [](const std::string& text, float percent) { return true; };
 
@@ -302,10 +358,17 @@ int ConvertCommand::Main(const std::vector<std::string>& args)
   case DiscIO::BlobType::WIA:
   case DiscIO::BlobType::RVZ:
   {
+    const std::string checkpoint_path = resumable ? output_file_path + ".checkpoint" : "";
+    DiscIO::ConversionStatistics statistics;
+
     success = DiscIO::ConvertToWIAOrRVZ(blob_reader.get(), input_file_path, output_file_path,
                                         format == DiscIO::BlobType::RVZ, compression_o.value(),
                                         compression_level_o.value(), block_size_o.value(),
-                                        NOOP_STATUS_CALLBACK);
+                                        zstd_dictionary, NOOP_STATUS_CALLBACK, checkpoint_path,
+                                        &statistics);
+
+    if (success && throughput)
+      PrintThroughput(statistics);
     break;
   }
 
@@ -4,8 +4,16 @@
 #include "DolphinTool/VerifyCommand.h"
 #include "UICommon/UICommon.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 #include <OptionParser.h>
 
+#include "Common/FileSearch.h"
+#include "Common/StringUtil.h"
+
 namespace DolphinTool
 {
 int VerifyCommand::Main(const std::vector<std::string>& args)
@@ -25,6 +33,19 @@ int VerifyCommand::Main(const std::vector<std::string>& args)
       .help("Path to disc image FILE.")
       .metavar("FILE");
 
+  parser->add_option("-d", "--directory")
+      .type("string")
+      .action("store")
+      .help("Verify every disc image in DIR and its subdirectories instead of a single FILE.")
+      .metavar("DIR");
+
+  parser->add_option("-j", "--jobs")
+      .type("int")
+      .action("store")
+      .help("Optional. Number of disc images to verify at the same time when using --directory. "
+            "Default is 2.")
+      .metavar("N");
+
   parser->add_option("-a", "--algorithm")
       .type("string")
       .action("store")
@@ -45,11 +66,28 @@ int VerifyCommand::Main(const std::vector<std::string>& args)
 
   // Validate options
   const std::string input_file_path = static_cast<const char*>(options.get("input"));
-  if (input_file_path.empty())
+  const std::string directory_path = static_cast<const char*>(options.get("directory"));
+  if (input_file_path.empty() && directory_path.empty())
   {
     std::cerr << "Error: No input set" << std::endl;
     return 1;
   }
+  if (!input_file_path.empty() && !directory_path.empty())
+  {
+    std::cerr << "Error: --input and --directory can't be used together" << std::endl;
+    return 1;
+  }
+
+  int jobs = 2;
+  if (options.is_set("jobs"))
+  {
+    jobs = static_cast<int>(options.get("jobs"));
+    if (jobs < 1)
+    {
+      std::cerr << "Error: --jobs must be at least 1" << std::endl;
+      return 1;
+    }
+  }
 
   std::optional<std::string> algorithm;
   if (options.is_set("algorithm"))
@@ -79,6 +117,9 @@ int VerifyCommand::Main(const std::vector<std::string>& args)
     return 1;
   }
 
+  if (!directory_path.empty())
+    return VerifyDirectory(directory_path, hashes_to_calculate, algorithm, jobs);
+
   // Open the volume
   std::shared_ptr<DiscIO::VolumeDisc> volume = DiscIO::CreateDisc(input_file_path);
   if (!volume)
@@ -168,12 +209,13 @@ void VerifyCommand::PrintFullReport(const std::optional<DiscIO::VolumeVerifier::
 
 std::optional<DiscIO::VolumeVerifier::Result>
 VerifyCommand::VerifyVolume(std::shared_ptr<DiscIO::VolumeDisc> volume,
-                            const DiscIO::Hashes<bool>& hashes_to_calculate)
+                            const DiscIO::Hashes<bool>& hashes_to_calculate,
+                            u32 num_worker_threads)
 {
   if (!volume)
     return std::nullopt;
 
-  DiscIO::VolumeVerifier verifier(*volume, false, hashes_to_calculate);
+  DiscIO::VolumeVerifier verifier(*volume, false, hashes_to_calculate, num_worker_threads);
 
   verifier.Start();
   while (verifier.GetBytesProcessed() != verifier.GetTotalBytes())
@@ -187,6 +229,100 @@ VerifyCommand::VerifyVolume(std::shared_ptr<DiscIO::VolumeDisc> volume,
   return result;
 }
 
+int VerifyCommand::VerifyDirectory(const std::string& directory_path,
+                                   const DiscIO::Hashes<bool>& hashes_to_calculate,
+                                   const std::optional<std::string>& algorithm, int jobs)
+{
+  static const std::vector<std::string> disc_image_extensions = {
+      ".gcm", ".tgc", ".iso", ".ciso", ".gcz", ".wbfs", ".wia", ".rvz", ".nfs"};
+
+  std::vector<std::string> paths =
+      Common::DoFileSearch({directory_path}, disc_image_extensions, true);
+
+  // The other parts of an NFS disc image get opened along with hif_000000.nfs
+  std::erase_if(paths, [](const std::string& path) {
+    std::string file_name;
+    std::string extension;
+    SplitPath(path, nullptr, &file_name, &extension);
+    Common::ToLower(&extension);
+    return extension == ".nfs" && file_name != "hif_000000";
+  });
+
+  if (paths.empty())
+  {
+    std::cerr << "Error: No disc images found in " << directory_path << std::endl;
+    return 1;
+  }
+
+  // The disc images which are verified at once split the CPU cores between them, so that verifying
+  // several disc images at once doesn't start several threads per CPU core. Besides its worker
+  // threads, every job has the thread it runs on and the verifier's read-ahead thread.
+  const u32 num_jobs = static_cast<u32>(std::min<size_t>(jobs, paths.size()));
+  const u32 num_cores = DiscIO::VolumeVerifier::GetDefaultWorkerThreadCount() + 1;
+  const u32 worker_threads_per_job = std::max<u32>(num_cores / num_jobs, 2) - 2;
+
+  std::mutex output_mutex;
+  std::atomic<size_t> next_index = 0;
+  std::atomic<size_t> failures = 0;
+
+  const auto verify_disc_images = [&] {
+    for (size_t i = next_index++; i < paths.size(); i = next_index++)
+    {
+      const std::string& path = paths[i];
+
+      std::optional<DiscIO::VolumeVerifier::Result> result;
+      std::shared_ptr<DiscIO::VolumeDisc> volume = DiscIO::CreateDisc(path);
+      if (volume)
+        result = VerifyVolume(volume, hashes_to_calculate, worker_threads_per_job);
+
+      std::lock_guard lk(output_mutex);
+
+      if (!volume || !result)
+      {
+        std::cerr << "Error: Unable to " << (volume ? "verify volume" : "open disc image") << " "
+                  << path << std::endl;
+        failures++;
+        continue;
+      }
+
+      if (algorithm == std::nullopt)
+      {
+        std::cout << path << std::endl;
+        PrintFullReport(result);
+        std::cout << std::endl;
+        continue;
+      }
+
+      const std::vector<u8>* hash = nullptr;
+      if (hashes_to_calculate.crc32 && !result->hashes.crc32.empty())
+        hash = &result->hashes.crc32;
+      else if (hashes_to_calculate.md5 && !result->hashes.md5.empty())
+        hash = &result->hashes.md5;
+      else if (hashes_to_calculate.sha1 && !result->hashes.sha1.empty())
+        hash = &result->hashes.sha1;
+
+      if (hash)
+      {
+        std::cout << HashToHexString(*hash) << "  " << path << std::endl;
+      }
+      else
+      {
+        std::cerr << "Error: No hash computed for " << path << std::endl;
+        failures++;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (u32 i = 1; i < num_jobs; ++i)
+    threads.emplace_back(verify_disc_images);
+  verify_disc_images();
+  for (std::thread& thread : threads)
+    thread.join();
+
+  return failures == 0 ? 0 : 1;
+}
+
 std::string VerifyCommand::HashToHexString(const std::vector<u8>& hash)
 {
   std::stringstream ss;
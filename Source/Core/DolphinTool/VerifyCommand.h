@@ -24,7 +24,12 @@ private:
 
   std::optional<DiscIO::VolumeVerifier::Result>
   VerifyVolume(std::shared_ptr<DiscIO::VolumeDisc> volume,
-               const DiscIO::Hashes<bool>& hashes_to_calculate);
+               const DiscIO::Hashes<bool>& hashes_to_calculate,
+               u32 num_worker_threads = DiscIO::VolumeVerifier::GetDefaultWorkerThreadCount());
+
+  int VerifyDirectory(const std::string& directory_path,
+                      const DiscIO::Hashes<bool>& hashes_to_calculate,
+                      const std::optional<std::string>& algorithm, int jobs);
 
   std::string HashToHexString(const std::vector<u8>& hash);
 };
@@ -4,11 +4,15 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
@@ -25,6 +29,14 @@ namespace Rasterizer
 {
 static constexpr int BLOCK_SIZE = 2;
 
+// Size of the screen tiles which are distributed between the rasterizer threads. This has to be a
+// multiple of BLOCK_SIZE, so that no pixel block is split between two tiles.
+static constexpr s32 TILE_SIZE = 32;
+static constexpr s32 NUM_TILES_X = (static_cast<s32>(EFB_WIDTH) + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr s32 NUM_TILES_Y = (static_cast<s32>(EFB_HEIGHT) + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr u32 NUM_TILES = NUM_TILES_X * NUM_TILES_Y;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0);
+
 struct SlopeContext
 {
   SlopeContext(const OutputVertexData* v0, const OutputVertexData* v1, const OutputVertexData* v2,
@@ -96,22 +108,48 @@ struct Slope
   }
 };
 
-static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
+// Everything needed to rasterize a triangle which passed the scissor test.
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Half-edge constants and deltas, in 28.4 fixed point
+  s32 C1, C2, C3;
+  s32 DX12, DX23, DX31;
+  s32 DY12, DY23, DY31;
+
+  // Bounding rectangle, clipped to the scissor rectangle
+  s32 minx, maxx, miny, maxy;
+};
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// State of a thread which rasterizes triangles
+struct RasterContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+  u32 rasterizedPixels = 0;
+};
+
+static Slope ZSlope;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
-void Init()
-{
-  // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
-  // needs to be set to an (untested) default value.
-  ZSlope = Slope();
-}
+// One context per thread that rasterizes, the GPU thread included.
+static std::vector<std::unique_ptr<RasterContext>> s_contexts;
+
+// When using more than one thread, triangles are set up on the GPU thread in submission order and
+// put into the bins of the tiles they overlap. All tiles are rasterized once the current batch has
+// been submitted, with every tile being drawn by a single thread. As each pixel is only ever
+// written by one thread, and the triangles of a tile are drawn in submission order, the output is
+// the same as when rasterizing everything on the GPU thread.
+static std::vector<TriangleSetup> s_triangles;
+static std::array<std::vector<u32>, NUM_TILES> s_tile_bins;
+static std::atomic<u32> s_next_tile;
+
+static Common::ThreadPool s_thread_pool;
 
 void ScissorChanged()
 {
@@ -140,16 +178,21 @@ static inline int iround(float x)
   return t;
 }
 
-void SetTevKonstColors()
+void UpdateTevState()
 {
-  tev.SetKonstColors();
+  for (auto& context : s_contexts)
+  {
+    context->tev.SetKonstColors();
+    context->tev.SetupCombiners();
+  }
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(RasterContext& context, const TriangleSetup& triangle, s32 x, s32 y, s32 xi,
+                 s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  context.rasterizedPixels++;
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(triangle.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
@@ -164,7 +207,9 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
     EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  Tev& tev = context.tev;
+  const RasterBlock& rasterBlock = context.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -175,7 +220,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      u16 color = (u16)triangle.ColorSlopes[i][comp].GetValue(x, y);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -207,7 +252,8 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear,
+                                u32 texmap, u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -218,9 +264,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -258,7 +304,8 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const TriangleSetup& triangle, s32 blockX,
+                       s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -269,19 +316,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / triangle.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = triangle.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = triangle.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = triangle.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -291,7 +338,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -303,7 +351,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -320,14 +369,12 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
   }
 }
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
+// Computes the slopes and edge functions of a triangle. Returns false if the triangle is entirely
+// outside of the scissor rectangle.
+static bool SetupTriangle(TriangleSetup* triangle, const OutputVertexData* v0,
+                          const OutputVertexData* v1, const OutputVertexData* v2,
+                          const BPFunctions::ScissorRect& scissor)
 {
-  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
-  // zfreeze depends on it
-  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
-
   // adapted from http://devmaster.net/posts/6145/advanced-rasterization
 
   // 28.4 fixed-pou32 coordinates. rounded to nearest and adjusted to match hardware output
@@ -349,15 +396,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-pos32 deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -376,28 +414,39 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   maxy = std::min(maxy, scissor.rect.bottom);
 
   if (minx >= maxx || miny >= maxy)
-    return;
+    return false;
+
+  triangle->minx = minx;
+  triangle->maxx = maxx;
+  triangle->miny = miny;
+  triangle->maxy = maxy;
 
   // Set up the remaining slopes
   const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
                          scissor.y_off);
 
+  triangle->ZSlope = ZSlope;
+
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
+  triangle->WSlope = Slope(w[0], w[1], w[2], ctx);
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    {
+      triangle->ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
     {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
+      triangle->TexSlopes[i][comp] =
+          Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
+                v2->texCoords[i][comp] * w[2], ctx);
     }
   }
 
@@ -414,6 +463,46 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
     C3++;
 
+  triangle->C1 = C1;
+  triangle->C2 = C2;
+  triangle->C3 = C3;
+  triangle->DX12 = DX12;
+  triangle->DX23 = DX23;
+  triangle->DX31 = DX31;
+  triangle->DY12 = DY12;
+  triangle->DY23 = DY23;
+  triangle->DY31 = DY31;
+
+  return true;
+}
+
+// Draws the part of a triangle which is inside the given rectangle. The rectangle has to be within
+// the bounding rectangle of the triangle, and its left and top edges have to be aligned to
+// BLOCK_SIZE unless they are the ones of the bounding rectangle.
+static void RasterizeTriangle(RasterContext& context, const TriangleSetup& triangle, s32 minx,
+                              s32 maxx, s32 miny, s32 maxy)
+{
+  const s32 C1 = triangle.C1;
+  const s32 C2 = triangle.C2;
+  const s32 C3 = triangle.C3;
+
+  const s32 DX12 = triangle.DX12;
+  const s32 DX23 = triangle.DX23;
+  const s32 DX31 = triangle.DX31;
+
+  const s32 DY12 = triangle.DY12;
+  const s32 DY23 = triangle.DY23;
+  const s32 DY31 = triangle.DY31;
+
+  // Fixed-pos32 deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
@@ -455,7 +544,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context.rasterBlock, triangle, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -465,7 +554,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(context, triangle, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -488,7 +577,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(context, triangle, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -505,6 +594,44 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+static void BinTriangle(const TriangleSetup& triangle)
+{
+  const u32 index = static_cast<u32>(s_triangles.size());
+  s_triangles.push_back(triangle);
+
+  for (s32 tile_y = triangle.miny / TILE_SIZE; tile_y <= (triangle.maxy - 1) / TILE_SIZE;
+       tile_y++)
+  {
+    for (s32 tile_x = triangle.minx / TILE_SIZE; tile_x <= (triangle.maxx - 1) / TILE_SIZE;
+         tile_x++)
+    {
+      s_tile_bins[tile_y * NUM_TILES_X + tile_x].push_back(index);
+    }
+  }
+}
+
+static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
+                                  const OutputVertexData* v2,
+                                  const BPFunctions::ScissorRect& scissor)
+{
+  // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
+  // zfreeze depends on it
+  UpdateZSlope(v0, v1, v2, scissor.x_off, scissor.y_off);
+
+  TriangleSetup triangle;
+  if (!SetupTriangle(&triangle, v0, v1, v2, scissor))
+    return;
+
+  if (s_thread_pool.GetNumWorkers() != 0)
+  {
+    BinTriangle(triangle);
+    return;
+  }
+
+  RasterizeTriangle(*s_contexts[0], triangle, triangle.minx, triangle.maxx, triangle.miny,
+                    triangle.maxy);
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
@@ -513,4 +640,89 @@ void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v
   for (const auto& scissor : scissors)
     DrawTriangleFrontFace(v0, v1, v2, scissor);
 }
+
+// Draws binned tiles until there are none left.
+static void RasterizeTiles(RasterContext& context)
+{
+  for (u32 tile = s_next_tile.fetch_add(1, std::memory_order_relaxed); tile < NUM_TILES;
+       tile = s_next_tile.fetch_add(1, std::memory_order_relaxed))
+  {
+    const s32 tile_minx = static_cast<s32>(tile % NUM_TILES_X) * TILE_SIZE;
+    const s32 tile_miny = static_cast<s32>(tile / NUM_TILES_X) * TILE_SIZE;
+
+    for (const u32 index : s_tile_bins[tile])
+    {
+      const TriangleSetup& triangle = s_triangles[index];
+      RasterizeTriangle(context, triangle, std::max(triangle.minx, tile_minx),
+                        std::min(triangle.maxx, tile_minx + TILE_SIZE),
+                        std::max(triangle.miny, tile_miny),
+                        std::min(triangle.maxy, tile_miny + TILE_SIZE));
+    }
+  }
+}
+
+static void SetNumThreads(u32 num_threads)
+{
+  if (num_threads == s_contexts.size())
+    return;
+
+  s_contexts.resize(num_threads);
+  for (auto& context : s_contexts)
+  {
+    if (!context)
+    {
+      context = std::make_unique<RasterContext>();
+    }
+  }
+
+  // The GPU thread takes part in rasterizing as well
+  s_thread_pool.Start(num_threads - 1, "SW rasterizer");
+}
+
+void Init()
+{
+  // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
+  // needs to be set to an (untested) default value.
+  ZSlope = Slope();
+
+  SetNumThreads(1);
+}
+
+void Shutdown()
+{
+  s_thread_pool.Stop();
+  s_contexts.clear();
+  s_triangles.clear();
+  for (auto& bin : s_tile_bins)
+    bin.clear();
+}
+
+void Flush()
+{
+  if (!s_triangles.empty())
+  {
+    // Each task draws tiles with its own context until none are left, so no two threads ever
+    // use the same context
+    s_next_tile.store(0, std::memory_order_relaxed);
+    s_thread_pool.ParallelFor(static_cast<u32>(s_contexts.size()),
+                              [](u32 i) { RasterizeTiles(*s_contexts[i]); });
+
+    s_triangles.clear();
+    for (auto& bin : s_tile_bins)
+      bin.clear();
+  }
+
+  for (auto& context : s_contexts)
+  {
+    ADDSTAT(g_stats.this_frame.rasterized_pixels, context->rasterizedPixels);
+    ADDSTAT(g_stats.this_frame.tev_pixels_in, context->tev.PixelsIn);
+    ADDSTAT(g_stats.this_frame.tev_pixels_out, context->tev.PixelsOut);
+    context->rasterizedPixels = 0;
+    context->tev.PixelsIn = 0;
+    context->tev.PixelsOut = 0;
+  }
+
+  // Nothing is being rasterized at this point, so the number of threads can be changed safely.
+  SetNumThreads(g_ActiveConfig.GetSWRasterizerThreads());
+}
 }  // namespace Rasterizer
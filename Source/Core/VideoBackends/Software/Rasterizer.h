@@ -10,6 +10,7 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
@@ -17,7 +18,12 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
 
-void SetTevKonstColors();
+// Has to be called before drawing a batch, to pick up changes to the TEV configuration
+void UpdateTevState();
+
+// Waits until all triangles drawn so far have been rasterized. Has to be called at the end of each
+// batch, as the rasterizer threads read the current BP state.
+void Flush();
 
 struct RasterBlockPixel
 {
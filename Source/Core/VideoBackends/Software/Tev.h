@@ -203,8 +203,29 @@ class Tev
     INDIRECT = 32
   };
 
+  // Per-lane parameters of a stage whose color and alpha combiners both use the regular formula,
+  // which allows evaluating all four channels at once. Lanes are in TevColor order (ABGR).
+  struct CombinerLanes
+  {
+    s16 scale[4];   // 1 << left shift
+    s16 bias[4];
+    s32 round[4];
+    s32 negate_before_shift[4];  // all bits set for alpha subtraction
+    s32 negate_after_shift[4];   // all bits set for color subtraction
+    s32 divide2[4];              // all bits set if the result is shifted right by one
+    s16 clamp_min[4];
+    s16 clamp_max[4];
+  };
+
+  std::array<CombinerLanes, 16> m_CombinerLanes{};
+  std::array<bool, 16> m_RegularCombiners{};
+
   void SetRasColor(RasColorChan colorChan, u32 swaptable);
 
+  static void GetCombinerLanes(const TevColorRef& color, const TevAlphaRef& alpha, s16 lanes[4]);
+  static void CombineRegular(const CombinerLanes& lanes, const s16 a[4], const s16 b[4],
+                             const s16 c[4], const s16 d[4], s16 out[4]);
+
   void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
@@ -221,6 +242,11 @@ public:
   s32 TextureLod[16]{};
   bool TextureLinear[16]{};
 
+  // Number of pixels which were drawn and which passed all tests. The rasterizer adds these to
+  // the statistics, as it may run several Tev instances at the same time.
+  u32 PixelsIn = 0;
+  u32 PixelsOut = 0;
+
   enum
   {
     ALP_C,
@@ -230,5 +256,7 @@ public:
   };
 
   void SetKonstColors();
+  // Has to be called when the TEV stage configuration changes
+  void SetupCombiners();
   void Draw();
 };
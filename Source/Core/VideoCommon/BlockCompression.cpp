@@ -0,0 +1,253 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/BlockCompression.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace VideoCommon
+{
+namespace
+{
+using Block = std::array<std::array<u8, 4>, BC_BLOCK_SIZE * BC_BLOCK_SIZE>;
+using Color = std::array<float, 3>;
+
+constexpr u32 GetBlockCount(u32 extent)
+{
+  return std::max((extent + BC_BLOCK_SIZE - 1) / BC_BLOCK_SIZE, 1u);
+}
+
+// Blocks which extend past the edge of the image get the edge pixels repeated into them
+Block FetchBlock(const u8* src, u32 width, u32 height, u32 row_length, u32 block_x, u32 block_y)
+{
+  Block block;
+  for (u32 y = 0; y < BC_BLOCK_SIZE; ++y)
+  {
+    const u32 src_y = std::min(block_y * BC_BLOCK_SIZE + y, height - 1);
+    for (u32 x = 0; x < BC_BLOCK_SIZE; ++x)
+    {
+      const u32 src_x = std::min(block_x * BC_BLOCK_SIZE + x, width - 1);
+      std::memcpy(block[y * BC_BLOCK_SIZE + x].data(),
+                  src + (static_cast<size_t>(src_y) * row_length + src_x) * 4, 4);
+    }
+  }
+  return block;
+}
+
+u16 PackRGB565(const std::array<u8, 4>& color)
+{
+  const auto quantize = [](u8 value, int max) {
+    return static_cast<u16>((value * max + 127) / 255);
+  };
+  return static_cast<u16>((quantize(color[0], 31) << 11) | (quantize(color[1], 63) << 5) |
+                          quantize(color[2], 31));
+}
+
+std::array<int, 3> UnpackRGB565(u16 color)
+{
+  const int r = (color >> 11) & 0x1f;
+  const int g = (color >> 5) & 0x3f;
+  const int b = color & 0x1f;
+  return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+void CompressColorBlock(const Block& block, u8* dst)
+{
+  Color mean{};
+  Color min{255, 255, 255};
+  Color max{};
+  for (const auto& pixel : block)
+  {
+    for (size_t c = 0; c < 3; ++c)
+    {
+      mean[c] += pixel[c];
+      min[c] = std::min<float>(min[c], pixel[c]);
+      max[c] = std::max<float>(max[c], pixel[c]);
+    }
+  }
+  for (float& component : mean)
+    component /= block.size();
+
+  // Find the axis along which the colors vary the most, using a few iterations of the power
+  // method on their covariance matrix, starting from the diagonal of their bounding box
+  std::array<float, 6> covariance{};
+  for (const auto& pixel : block)
+  {
+    const Color d{pixel[0] - mean[0], pixel[1] - mean[1], pixel[2] - mean[2]};
+    covariance[0] += d[0] * d[0];
+    covariance[1] += d[0] * d[1];
+    covariance[2] += d[0] * d[2];
+    covariance[3] += d[1] * d[1];
+    covariance[4] += d[1] * d[2];
+    covariance[5] += d[2] * d[2];
+  }
+
+  Color axis{max[0] - min[0], max[1] - min[1], max[2] - min[2]};
+  for (int i = 0; i < 4; ++i)
+  {
+    const Color next{
+        covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2],
+        covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2],
+        covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2],
+    };
+    const float length = std::max({std::abs(next[0]), std::abs(next[1]), std::abs(next[2])});
+    if (length < 1e-6f)
+      break;
+
+    for (size_t c = 0; c < 3; ++c)
+      axis[c] = next[c] / length;
+  }
+
+  // Use the colors furthest apart along the axis as endpoints
+  float min_dot = std::numeric_limits<float>::max();
+  float max_dot = std::numeric_limits<float>::lowest();
+  size_t min_index = 0;
+  size_t max_index = 0;
+  for (size_t i = 0; i < block.size(); ++i)
+  {
+    float dot = 0;
+    for (size_t c = 0; c < 3; ++c)
+      dot += (block[i][c] - mean[c]) * axis[c];
+
+    if (dot < min_dot)
+    {
+      min_dot = dot;
+      min_index = i;
+    }
+    if (dot > max_dot)
+    {
+      max_dot = dot;
+      max_index = i;
+    }
+  }
+
+  // color0 > color1 selects the mode with four colors and no transparency
+  u16 color0 = PackRGB565(block[max_index]);
+  u16 color1 = PackRGB565(block[min_index]);
+  if (color0 < color1)
+    std::swap(color0, color1);
+
+  u32 indices = 0;
+  if (color0 != color1)
+  {
+    const std::array<int, 3> c0 = UnpackRGB565(color0);
+    const std::array<int, 3> c1 = UnpackRGB565(color1);
+    std::array<std::array<int, 3>, 4> palette{c0, c1};
+    for (size_t c = 0; c < 3; ++c)
+    {
+      palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+      palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+    }
+
+    for (size_t i = 0; i < block.size(); ++i)
+    {
+      u32 best_index = 0;
+      int best_distance = std::numeric_limits<int>::max();
+      for (u32 j = 0; j < palette.size(); ++j)
+      {
+        int distance = 0;
+        for (size_t c = 0; c < 3; ++c)
+        {
+          const int d = block[i][c] - palette[j][c];
+          distance += d * d;
+        }
+        if (distance < best_distance)
+        {
+          best_distance = distance;
+          best_index = j;
+        }
+      }
+      indices |= best_index << (2 * i);
+    }
+  }
+
+  dst[0] = static_cast<u8>(color0);
+  dst[1] = static_cast<u8>(color0 >> 8);
+  dst[2] = static_cast<u8>(color1);
+  dst[3] = static_cast<u8>(color1 >> 8);
+  for (int i = 0; i < 4; ++i)
+    dst[4 + i] = static_cast<u8>(indices >> (8 * i));
+}
+
+void CompressAlphaBlock(const Block& block, u8* dst)
+{
+  u8 min = 255;
+  u8 max = 0;
+  for (const auto& pixel : block)
+  {
+    min = std::min(min, pixel[3]);
+    max = std::max(max, pixel[3]);
+  }
+
+  // alpha0 > alpha1 selects the mode with eight interpolated values
+  u64 indices = 0;
+  if (min != max)
+  {
+    std::array<int, 8> palette{max, min};
+    for (int i = 2; i < 8; ++i)
+      palette[i] = ((8 - i) * max + (i - 1) * min) / 7;
+
+    for (size_t i = 0; i < block.size(); ++i)
+    {
+      u64 best_index = 0;
+      int best_distance = std::numeric_limits<int>::max();
+      for (u32 j = 0; j < palette.size(); ++j)
+      {
+        const int distance = std::abs(block[i][3] - palette[j]);
+        if (distance < best_distance)
+        {
+          best_distance = distance;
+          best_index = j;
+        }
+      }
+      indices |= best_index << (3 * i);
+    }
+  }
+
+  dst[0] = max;
+  dst[1] = min;
+  for (int i = 0; i < 6; ++i)
+    dst[2 + i] = static_cast<u8>(indices >> (8 * i));
+}
+
+template <typename CompressBlockFunction>
+void CompressImage(const u8* src, u32 width, u32 height, u32 src_row_length, u8* dst,
+                   u32 bytes_per_block, CompressBlockFunction compress_block)
+{
+  const u32 blocks_wide = GetBlockCount(width);
+  const u32 blocks_high = GetBlockCount(height);
+  for (u32 block_y = 0; block_y < blocks_high; ++block_y)
+  {
+    for (u32 block_x = 0; block_x < blocks_wide; ++block_x)
+    {
+      compress_block(FetchBlock(src, width, height, src_row_length, block_x, block_y), dst);
+      dst += bytes_per_block;
+    }
+  }
+}
+}  // namespace
+
+size_t GetBlockCompressedSize(u32 width, u32 height, u32 bytes_per_block)
+{
+  return static_cast<size_t>(GetBlockCount(width)) * GetBlockCount(height) * bytes_per_block;
+}
+
+void CompressBC1(const u8* src, u32 width, u32 height, u32 src_row_length, u8* dst)
+{
+  CompressImage(src, width, height, src_row_length, dst, BC1_BYTES_PER_BLOCK, CompressColorBlock);
+}
+
+void CompressBC3(const u8* src, u32 width, u32 height, u32 src_row_length, u8* dst)
+{
+  CompressImage(src, width, height, src_row_length, dst, BC3_BYTES_PER_BLOCK,
+                [](const Block& block, u8* block_dst) {
+                  CompressAlphaBlock(block, block_dst);
+                  CompressColorBlock(block, block_dst + 8);
+                });
+}
+}  // namespace VideoCommon
@@ -0,0 +1,28 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
+
+namespace VideoCommon
+{
+// Encoders for the block compressed formats that custom textures can be stored in. They are tuned
+// for speed over quality, since they are used to compress textures while the game is running.
+
+constexpr u32 BC_BLOCK_SIZE = 4;
+constexpr u32 BC1_BYTES_PER_BLOCK = 8;
+constexpr u32 BC3_BYTES_PER_BLOCK = 16;
+
+// Returns the size in bytes of an image of the given size once compressed.
+// Images whose size isn't a multiple of the block size are padded to whole blocks.
+size_t GetBlockCompressedSize(u32 width, u32 height, u32 bytes_per_block);
+
+// Compresses RGBA8 image data to BC1 (DXT1), ignoring alpha. src_row_length is in pixels.
+void CompressBC1(const u8* src, u32 width, u32 height, u32 src_row_length, u8* dst);
+
+// Compresses RGBA8 image data to BC3 (DXT5). src_row_length is in pixels.
+void CompressBC3(const u8* src, u32 width, u32 height, u32 src_row_length, u8* dst);
+}  // namespace VideoCommon
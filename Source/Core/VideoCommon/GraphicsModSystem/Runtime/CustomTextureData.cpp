@@ -8,11 +8,14 @@
 #include <cstdint>
 #include <cstring>
 #include <functional>
+#include <optional>
 
 #include "Common/Align.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
 #include "Common/Image.h"
 #include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
 #include "Common/Swap.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -75,6 +78,9 @@ struct DDS_PIXELFORMAT
 #define DDS_HEADER_FLAGS_PITCH 0x00000008       // DDSD_PITCH
 #define DDS_HEADER_FLAGS_LINEARSIZE 0x00080000  // DDSD_LINEARSIZE
 
+#define DDS_SURFACE_FLAGS_TEXTURE 0x00001000  // DDSCAPS_TEXTURE
+#define DDS_SURFACE_FLAGS_MIPMAP 0x00400008   // DDSCAPS_COMPLEX | DDSCAPS_MIPMAP
+
 // Subset here matches D3D10_RESOURCE_DIMENSION and D3D11_RESOURCE_DIMENSION
 enum DDS_RESOURCE_DIMENSION
 {
@@ -125,9 +131,17 @@ constexpr DDS_PIXELFORMAT DDSPF_X8B8G8R8 = {
     sizeof(DDS_PIXELFORMAT), DDS_RGB, 0, 32, 0x000000ff, 0x0000ff00, 0x00ff0000, 0x00000000};
 constexpr DDS_PIXELFORMAT DDSPF_R8G8B8 = {
     sizeof(DDS_PIXELFORMAT), DDS_RGB, 0, 24, 0x00ff0000, 0x0000ff00, 0x000000ff, 0x00000000};
+constexpr DDS_PIXELFORMAT DDSPF_DXT1 = {
+    sizeof(DDS_PIXELFORMAT), DDS_FOURCC, MAKEFOURCC('D', 'X', 'T', '1'), 0, 0, 0, 0, 0};
+constexpr DDS_PIXELFORMAT DDSPF_DXT5 = {
+    sizeof(DDS_PIXELFORMAT), DDS_FOURCC, MAKEFOURCC('D', 'X', 'T', '5'), 0, 0, 0, 0, 0};
 
 // End of Microsoft code from DDS.h.
 
+// Files written by SaveDDSTexture store this and their tag at the start of dwReserved1, which
+// other DDS readers ignore
+constexpr u32 DOLPHIN_TAG_MAGIC = MAKEFOURCC('D', 'L', 'P', 'H');
+
 static constexpr bool DDSPixelFormatMatches(const DDS_PIXELFORMAT& pf1, const DDS_PIXELFORMAT& pf2)
 {
   return std::tie(pf1.dwSize, pf1.dwFlags, pf1.dwFourCC, pf1.dwRGBBitCount, pf1.dwRBitMask,
@@ -147,6 +161,7 @@ struct DDSLoadInfo
   size_t first_mip_offset = 0;
   size_t first_mip_size = 0;
   u32 first_mip_row_length = 0;
+  std::optional<u64> tag;
 
   std::function<void(VideoCommon::CustomTextureData::Level*)> conversion_function;
 };
@@ -270,6 +285,9 @@ static bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
   if (info->width == 0 || info->height == 0)
     return false;
 
+  if (header.dwReserved1[0] == DOLPHIN_TAG_MAGIC)
+    info->tag = header.dwReserved1[1] | static_cast<u64>(header.dwReserved1[2]) << 32;
+
   // Check for mip levels.
   if (header.dwFlags & DDS_HEADER_FLAGS_MIPMAP)
   {
@@ -416,9 +434,12 @@ static bool ParseDDSHeader(File::IOFile& file, DDSLoadInfo* info)
   return true;
 }
 
+// If the file is mapped, the level is copied from the mapping at the given offset instead of being
+// read from the current position of the file.
 static bool ReadMipLevel(VideoCommon::CustomTextureData::Level* level, File::IOFile& file,
-                         const std::string& filename, u32 mip_level, const DDSLoadInfo& info,
-                         u32 width, u32 height, u32 row_length, size_t size)
+                         const File::MappedFile& mapping, u64 offset, const std::string& filename,
+                         u32 mip_level, const DDSLoadInfo& info, u32 width, u32 height,
+                         u32 row_length, size_t size)
 {
   // D3D11 cannot handle block compressed textures where the first mip level is
   // not a multiple of the block size.
@@ -438,8 +459,16 @@ static bool ReadMipLevel(VideoCommon::CustomTextureData::Level* level, File::IOF
   level->format = info.format;
   level->row_length = row_length;
   level->data.resize(size);
-  if (!file.ReadBytes(level->data.data(), level->data.size()))
+  if (mapping.IsMapped())
+  {
+    if (offset > mapping.GetSize() || size > mapping.GetSize() - offset)
+      return false;
+    std::memcpy(level->data.data(), mapping.GetData() + offset, size);
+  }
+  else if (!file.ReadBytes(level->data.data(), level->data.size()))
+  {
     return false;
+  }
 
   // Apply conversion function for uncompressed textures.
   if (info.conversion_function)
@@ -448,11 +477,10 @@ static bool ReadMipLevel(VideoCommon::CustomTextureData::Level* level, File::IOF
   return true;
 }
 
-}  // namespace
-
-namespace VideoCommon
-{
-bool LoadDDSTexture(CustomTextureData* texture, const std::string& filename)
+// If required_tag is set, the file must have been written by SaveDDSTexture with that tag, and
+// must contain every mip level its header declares.
+static bool LoadDDSTextureLevels(VideoCommon::CustomTextureData* texture,
+                                 const std::string& filename, std::optional<u64> required_tag)
 {
   File::IOFile file;
   file.Open(filename, "rb");
@@ -463,15 +491,24 @@ bool LoadDDSTexture(CustomTextureData* texture, const std::string& filename)
   if (!ParseDDSHeader(file, &info))
     return false;
 
+  if (required_tag && info.tag != required_tag)
+    return false;
+
+  // Copying the levels out of a mapping of the file avoids a read call per level
+  File::MappedFile mapping;
+  mapping.Map(file);
+
   // Read first mip level, as it may have a custom pitch.
-  CustomTextureData::Level first_level;
+  VideoCommon::CustomTextureData::Level first_level;
+  u64 offset = info.first_mip_offset;
   if (!file.Seek(info.first_mip_offset, File::SeekOrigin::Begin) ||
-      !ReadMipLevel(&first_level, file, filename, 0, info, info.width, info.height,
-                    info.first_mip_row_length, info.first_mip_size))
+      !ReadMipLevel(&first_level, file, mapping, offset, filename, 0, info, info.width,
+                    info.height, info.first_mip_row_length, info.first_mip_size))
   {
     return false;
   }
 
+  offset += info.first_mip_size;
   texture->m_levels.push_back(std::move(first_level));
 
   // Read in any remaining mip levels in the file.
@@ -488,17 +525,39 @@ bool LoadDDSTexture(CustomTextureData* texture, const std::string& filename)
     u32 blocks_high = GetBlockCount(mip_height, info.block_size);
     u32 mip_row_length = blocks_wide * info.block_size;
     size_t mip_size = blocks_wide * static_cast<size_t>(info.bytes_per_block) * blocks_high;
-    CustomTextureData::Level level;
-    if (!ReadMipLevel(&level, file, filename, i, info, mip_width, mip_height, mip_row_length,
-                      mip_size))
+    VideoCommon::CustomTextureData::Level level;
+    if (!ReadMipLevel(&level, file, mapping, offset, filename, i, info, mip_width, mip_height,
+                      mip_row_length, mip_size))
+    {
+      if (required_tag)
+      {
+        texture->m_levels.clear();
+        return false;
+      }
       break;
+    }
 
+    offset += mip_size;
     texture->m_levels.push_back(std::move(level));
   }
 
   return true;
 }
 
+}  // namespace
+
+namespace VideoCommon
+{
+bool LoadDDSTexture(CustomTextureData* texture, const std::string& filename)
+{
+  return LoadDDSTextureLevels(texture, filename, std::nullopt);
+}
+
+bool LoadTaggedDDSTexture(CustomTextureData* texture, const std::string& filename, u64 tag)
+{
+  return LoadDDSTextureLevels(texture, filename, tag);
+}
+
 bool LoadDDSTexture(CustomTextureData::Level* level, const std::string& filename, u32 mip_level)
 {
   // Only loading a single mip level.
@@ -511,8 +570,90 @@ bool LoadDDSTexture(CustomTextureData::Level* level, const std::string& filename
   if (!ParseDDSHeader(file, &info))
     return false;
 
-  return ReadMipLevel(level, file, filename, mip_level, info, info.width, info.height,
-                      info.first_mip_row_length, info.first_mip_size);
+  return ReadMipLevel(level, file, File::MappedFile{}, info.first_mip_offset, filename, mip_level,
+                      info, info.width, info.height, info.first_mip_row_length,
+                      info.first_mip_size);
+}
+
+bool SaveDDSTexture(const CustomTextureData& texture, const std::string& filename, u64 tag)
+{
+  if (texture.m_levels.empty())
+    return false;
+
+  const CustomTextureData::Level& first_level = texture.m_levels[0];
+
+  DDS_HEADER header{};
+  header.dwSize = sizeof(header);
+  header.dwFlags = DDS_HEADER_FLAGS_TEXTURE | DDS_HEADER_FLAGS_MIPMAP;
+  header.dwHeight = first_level.height;
+  header.dwWidth = first_level.width;
+  header.dwMipMapCount = static_cast<u32>(texture.m_levels.size());
+  header.dwReserved1[0] = DOLPHIN_TAG_MAGIC;
+  header.dwReserved1[1] = static_cast<u32>(tag);
+  header.dwReserved1[2] = static_cast<u32>(tag >> 32);
+  header.dwCaps = DDS_SURFACE_FLAGS_TEXTURE;
+  if (texture.m_levels.size() > 1)
+    header.dwCaps |= DDS_SURFACE_FLAGS_MIPMAP;
+
+  u32 block_size;
+  u32 bytes_per_block;
+  switch (first_level.format)
+  {
+  case AbstractTextureFormat::RGBA8:
+    header.ddspf = DDSPF_A8B8G8R8;
+    block_size = 1;
+    bytes_per_block = 4;
+    break;
+  case AbstractTextureFormat::DXT1:
+    header.ddspf = DDSPF_DXT1;
+    block_size = 4;
+    bytes_per_block = 8;
+    break;
+  case AbstractTextureFormat::DXT5:
+    header.ddspf = DDSPF_DXT5;
+    block_size = 4;
+    bytes_per_block = 16;
+    break;
+  default:
+    return false;
+  }
+
+  // Only tightly packed levels in the layout LoadDDSTexture expects can be written as they are
+  u32 mip_width = first_level.width;
+  u32 mip_height = first_level.height;
+  for (const CustomTextureData::Level& level : texture.m_levels)
+  {
+    const u32 blocks_wide = GetBlockCount(mip_width, block_size);
+    const u32 blocks_high = GetBlockCount(mip_height, block_size);
+    if (level.format != first_level.format || level.width != mip_width ||
+        level.height != mip_height || level.row_length != blocks_wide * block_size ||
+        level.data.size() != blocks_wide * static_cast<size_t>(bytes_per_block) * blocks_high)
+    {
+      return false;
+    }
+
+    mip_width = std::max(mip_width / 2, 1u);
+    mip_height = std::max(mip_height / 2, 1u);
+  }
+
+  // Write to a temporary file first, so that a partially written file is never loaded
+  const std::string temp_filename = filename + ".tmp";
+  {
+    File::IOFile file(temp_filename, "wb");
+    if (!file.WriteBytes(&DDS_MAGIC, sizeof(DDS_MAGIC)) ||
+        !file.WriteBytes(&header, sizeof(header)))
+    {
+      return false;
+    }
+
+    for (const CustomTextureData::Level& level : texture.m_levels)
+    {
+      if (!file.WriteBytes(level.data.data(), level.data.size()))
+        return false;
+    }
+  }
+
+  return File::Rename(temp_filename, filename);
 }
 
 bool LoadPNGTexture(CustomTextureData* texture, const std::string& filename)
@@ -26,7 +26,13 @@ public:
 };
 
 bool LoadDDSTexture(CustomTextureData* texture, const std::string& filename);
+// Only loads files that were written by SaveDDSTexture with the given tag.
+bool LoadTaggedDDSTexture(CustomTextureData* texture, const std::string& filename, u64 tag);
 bool LoadDDSTexture(CustomTextureData::Level* level, const std::string& filename, u32 mip_level);
 bool LoadPNGTexture(CustomTextureData* texture, const std::string& filename);
 bool LoadPNGTexture(CustomTextureData::Level* level, const std::string& filename);
+
+// Writes all levels of an RGBA8, DXT1 or DXT5 texture to a DDS file. The tag is stored in a part of
+// the header that other programs ignore, so that callers can tell whether a file is up to date.
+bool SaveDDSTexture(const CustomTextureData& texture, const std::string& filename, u64 tag);
 }  // namespace VideoCommon
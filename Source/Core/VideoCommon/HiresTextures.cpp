@@ -4,18 +4,27 @@
 #include "VideoCommon/HiresTextures.h"
 
 #include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <filesystem>
+#include <iterator>
+#include <list>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <xxhash.h>
 
 #include <fmt/format.h>
 
+#include "Common/Align.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonPaths.h"
 #include "Common/FileSearch.h"
 #include "Common/FileUtil.h"
@@ -27,9 +36,12 @@
 #include "Common/StringUtil.h"
 #include "Common/Swap.h"
 #include "Common/Thread.h"
+#include "Common/ThreadPool.h"
 #include "Common/Timer.h"
+#include "Common/WorkQueueThread.h"
 #include "Core/Config/GraphicsSettings.h"
 #include "Core/ConfigManager.h"
+#include "VideoCommon/BlockCompression.h"
 #include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -39,14 +51,328 @@ struct DiskTexture
   bool has_arbitrary_mipmaps;
 };
 
+struct CachedTexture
+{
+  std::shared_ptr<HiresTexture> texture;
+  size_t size;
+  std::list<std::string>::iterator lru_position;
+};
+
+// A texture loaded from PNG files, to be transcoded and written to the disk cache
+struct DiskCacheStore
+{
+  std::string base_filename;
+  VideoCommon::CustomTextureData data;
+  bool has_arbitrary_mipmaps;
+  u64 tag;
+};
+
+struct LoadStatistics
+{
+  std::atomic<u64> textures = 0;
+  std::atomic<u64> bytes = 0;
+  // Summed over all threads that loaded textures
+  std::atomic<u64> load_time_us = 0;
+};
+
 constexpr std::string_view s_format_prefix{"tex1_"};
 
+// Prefetching usually happens while the game is running, so leave a core each for the CPU and GPU
+// threads and one for everything else (audio, the UI), and don't take over large machines either
+constexpr int RESERVED_CORES = 3;
+constexpr int MAX_PREFETCH_THREADS = 8;
+
 static std::unordered_map<std::string, DiskTexture> s_textureMap;
-static std::unordered_map<std::string, std::shared_ptr<HiresTexture>> s_textureCache;
+
+// Loaded textures are kept within s_textureCacheBudget bytes by evicting the least recently used
+static std::unordered_map<std::string, CachedTexture> s_textureCache;
+static std::list<std::string> s_textureCacheLRU;  // Most recently used first
+static size_t s_textureCacheSize = 0;
+static size_t s_textureCacheBudget = 0;
+// Textures that some thread is loading right now, so that no other thread starts loading them too
+static std::unordered_set<std::string> s_texturesBeingLoaded;
+static std::condition_variable s_textureLoaded;
 static std::mutex s_textureCacheMutex;
 static Common::Flag s_textureCacheAbortLoading;
 
+// Textures waiting to be prefetched, shared by all prefetching threads. When Search needs one of
+// them, it loads it right away instead of waiting for its turn, and the prefetching threads skip
+// it once they get to it.
+static std::vector<std::string> s_prefetchQueue;
+static size_t s_prefetchQueuePosition = 0;
+// s_prefetcher hands the queue to s_prefetchPool and reports the results once it's done
 static std::thread s_prefetcher;
+static Common::ThreadPool s_prefetchPool;
+static int s_prefetchThreadCount = 0;
+static bool s_prefetchBudgetReached = false;
+static Common::Timer s_prefetchTimer;
+
+static LoadStatistics s_prefetchStatistics;
+static LoadStatistics s_onDemandStatistics;
+static std::atomic<u64> s_textureCacheEvictions = 0;
+
+// PNG textures are transcoded into DDS files with full mip chains (block compressed if enabled) the
+// first time they are loaded, which are then loaded instead on later runs. Empty if disabled.
+static std::string s_diskCacheDirectory;
+// Bump this when changing how textures are transcoded, to make existing files get replaced
+constexpr u32 DISK_CACHE_VERSION = 1;
+static std::atomic<u64> s_diskCacheHits = 0;
+static std::atomic<u64> s_diskCacheStores = 0;
+// Transcodes the textures that Search had to load on the GPU thread, so that it doesn't stall
+static Common::WorkQueueThread<DiskCacheStore> s_diskCacheWriter;
+
+static size_t GetTextureSize(const HiresTexture& texture)
+{
+  size_t size = 0;
+  for (const VideoCommon::CustomTextureData::Level& level : texture.GetData().m_levels)
+    size += level.data.size();
+  return size;
+}
+
+static void RecordLoad(LoadStatistics* statistics, const HiresTexture* texture, u64 start_us)
+{
+  statistics->load_time_us += Common::Timer::NowUs() - start_us;
+  if (!texture)
+    return;
+
+  ++statistics->textures;
+  statistics->bytes += GetTextureSize(*texture);
+}
+
+static void ResetStatistics(LoadStatistics* statistics)
+{
+  statistics->textures = 0;
+  statistics->bytes = 0;
+  statistics->load_time_us = 0;
+}
+
+static size_t GetTextureCacheBudget()
+{
+  if (g_ActiveConfig.iHiresTexturesCacheSize > 0)
+    return static_cast<size_t>(g_ActiveConfig.iHiresTexturesCacheSize) * 1024 * 1024;
+
+  const size_t sys_mem = Common::MemPhysical();
+  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
+  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
+  return (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+}
+
+// s_textureCacheMutex must be locked
+static void EraseFromTextureCache(std::unordered_map<std::string, CachedTexture>::iterator iter)
+{
+  s_textureCacheSize -= iter->second.size;
+  s_textureCacheLRU.erase(iter->second.lru_position);
+  s_textureCache.erase(iter);
+}
+
+// s_textureCacheMutex must be locked
+static void InsertIntoTextureCache(const std::string& base_filename,
+                                   std::shared_ptr<HiresTexture> texture)
+{
+  const auto iter = s_textureCache.find(base_filename);
+  if (iter != s_textureCache.end())
+    EraseFromTextureCache(iter);
+
+  const size_t size = GetTextureSize(*texture);
+  s_textureCacheLRU.push_front(base_filename);
+  s_textureCache.emplace(base_filename,
+                         CachedTexture{std::move(texture), size, s_textureCacheLRU.begin()});
+  s_textureCacheSize += size;
+
+  while (s_textureCacheSize > s_textureCacheBudget && s_textureCacheLRU.size() > 1)
+  {
+    EraseFromTextureCache(s_textureCache.find(s_textureCacheLRU.back()));
+    ++s_textureCacheEvictions;
+  }
+}
+
+static void ClearTextureCache()
+{
+  std::lock_guard lk(s_textureCacheMutex);
+  s_textureCache.clear();
+  s_textureCacheLRU.clear();
+  s_textureCacheSize = 0;
+}
+
+static std::string GetDiskCachePath(const std::string& base_filename)
+{
+  return s_diskCacheDirectory + base_filename + ".dds";
+}
+
+// Block compression is opt-in, since it's lossy
+static bool ShouldCompress()
+{
+  return g_ActiveConfig.bHiresTexturesDiskCacheCompression &&
+         g_ActiveConfig.backend_info.bSupportsST3CTextures;
+}
+
+// Identifies the source files of a texture and how they get transcoded. Returns nothing if the
+// texture shouldn't be cached on disk, because it's stored as a DDS file already.
+static std::optional<u64> GetDiskCacheTag(const std::string& base_filename)
+{
+  XXH64_state_t* state = XXH64_createState();
+  XXH64_reset(state, DISK_CACHE_VERSION);
+  const bool compress = ShouldCompress();
+  XXH64_update(state, &compress, sizeof(compress));
+
+  std::optional<u64> tag;
+  for (u32 mip_level = 0;; ++mip_level)
+  {
+    std::string filename = base_filename;
+    if (mip_level != 0)
+      filename += fmt::format("_mip{}", mip_level);
+
+    const auto iter = s_textureMap.find(filename);
+    if (iter == s_textureMap.end())
+    {
+      tag = XXH64_digest(state);
+      break;
+    }
+
+    const std::string& path = iter->second.path;
+    std::string extension;
+    SplitPath(path, nullptr, nullptr, &extension);
+    if (Common::CaseInsensitiveEquals(extension, ".dds"))
+      break;
+
+    std::error_code size_error;
+    std::error_code time_error;
+    const std::filesystem::path native_path = StringToPath(path);
+    const u64 size = std::filesystem::file_size(native_path, size_error);
+    const s64 modification_time =
+        std::filesystem::last_write_time(native_path, time_error).time_since_epoch().count();
+    if (size_error || time_error)
+      break;
+
+    XXH64_update(state, path.data(), path.size());
+    XXH64_update(state, &size, sizeof(size));
+    XXH64_update(state, &modification_time, sizeof(modification_time));
+  }
+
+  XXH64_freeState(state);
+  return tag;
+}
+
+static VideoCommon::CustomTextureData::Level
+Downsample(const VideoCommon::CustomTextureData::Level& level)
+{
+  VideoCommon::CustomTextureData::Level result;
+  result.width = std::max(level.width / 2, 1u);
+  result.height = std::max(level.height / 2, 1u);
+  result.row_length = result.width;
+  result.data.resize(static_cast<size_t>(result.width) * result.height * 4);
+
+  for (u32 y = 0; y < result.height; ++y)
+  {
+    const u32 y0 = std::min(y * 2, level.height - 1);
+    const u32 y1 = std::min(y * 2 + 1, level.height - 1);
+    for (u32 x = 0; x < result.width; ++x)
+    {
+      const u32 x0 = std::min(x * 2, level.width - 1);
+      const u32 x1 = std::min(x * 2 + 1, level.width - 1);
+      u8* dst = &result.data[(static_cast<size_t>(y) * result.row_length + x) * 4];
+      for (u32 c = 0; c < 4; ++c)
+      {
+        const auto texel = [&](u32 texel_x, u32 texel_y) {
+          return level.data[(static_cast<size_t>(texel_y) * level.row_length + texel_x) * 4 + c];
+        };
+        dst[c] = static_cast<u8>(
+            (texel(x0, y0) + texel(x1, y0) + texel(x0, y1) + texel(x1, y1) + 2) / 4);
+      }
+    }
+  }
+
+  return result;
+}
+
+static void CompressLevels(VideoCommon::CustomTextureData* data)
+{
+  // D3D requires the first level of block compressed textures to be made of whole blocks
+  const VideoCommon::CustomTextureData::Level& first_level = data->m_levels[0];
+  if (first_level.width % VideoCommon::BC_BLOCK_SIZE != 0 ||
+      first_level.height % VideoCommon::BC_BLOCK_SIZE != 0)
+  {
+    return;
+  }
+
+  // Textures which are entirely opaque fit in BC1, which takes half the space of BC3. This costs
+  // no quality, since BC3 stores colors exactly like BC1 does and only adds an alpha block.
+  bool opaque = true;
+  for (size_t i = 3; i < first_level.data.size() && opaque; i += 4)
+    opaque = first_level.data[i] == 0xff;
+
+  const u32 bytes_per_block =
+      opaque ? VideoCommon::BC1_BYTES_PER_BLOCK : VideoCommon::BC3_BYTES_PER_BLOCK;
+  for (VideoCommon::CustomTextureData::Level& level : data->m_levels)
+  {
+    std::vector<u8> compressed(
+        VideoCommon::GetBlockCompressedSize(level.width, level.height, bytes_per_block));
+    if (opaque)
+      VideoCommon::CompressBC1(level.data.data(), level.width, level.height, level.row_length,
+                               compressed.data());
+    else
+      VideoCommon::CompressBC3(level.data.data(), level.width, level.height, level.row_length,
+                               compressed.data());
+
+    level.data = std::move(compressed);
+    level.format = opaque ? AbstractTextureFormat::DXT1 : AbstractTextureFormat::DXT5;
+    level.row_length = Common::AlignUp(level.width, VideoCommon::BC_BLOCK_SIZE);
+  }
+}
+
+static bool IsUncompressed(const VideoCommon::CustomTextureData& data)
+{
+  return std::all_of(data.m_levels.begin(), data.m_levels.end(), [](const auto& level) {
+    return level.format == AbstractTextureFormat::RGBA8;
+  });
+}
+
+// The disk cache stores textures loaded from PNG files with a full mip chain, which is quick enough
+// to generate on the GPU thread, so it's done for every texture the disk cache gets used for
+static void GenerateMipmaps(VideoCommon::CustomTextureData* data, bool has_arbitrary_mipmaps)
+{
+  if (has_arbitrary_mipmaps || !IsUncompressed(*data))
+    return;
+
+  while (data->m_levels.back().width > 1 || data->m_levels.back().height > 1)
+    data->m_levels.push_back(Downsample(data->m_levels.back()));
+}
+
+// Transcodes a texture that was loaded from PNG files into the form it is stored in on disk, and
+// stores it. The mip chain has to have been generated already.
+static void StoreInDiskCache(const std::string& base_filename, VideoCommon::CustomTextureData* data,
+                             u64 tag)
+{
+  if (!IsUncompressed(*data))
+    return;
+
+  if (ShouldCompress())
+    CompressLevels(data);
+
+  if (VideoCommon::SaveDDSTexture(*data, GetDiskCachePath(base_filename), tag))
+    ++s_diskCacheStores;
+  else
+    WARN_LOG_FMT(VIDEO, "Failed to write custom texture {} to the disk cache", base_filename);
+}
+
+static void StopPrefetching()
+{
+  if (!s_prefetcher.joinable())
+    return;
+
+  s_textureCacheAbortLoading.Set();
+  s_prefetcher.join();
+  s_prefetchPool.Stop();
+
+  s_prefetchQueue.clear();
+  s_prefetchQueuePosition = 0;
+}
+
+static void StopDiskCacheWriter()
+{
+  // Textures that didn't get written yet are simply transcoded again next time
+  s_diskCacheWriter.Shutdown(true);
+}
 
 void HiresTexture::Init()
 {
@@ -60,11 +386,8 @@ void HiresTexture::Shutdown()
 
 void HiresTexture::Update()
 {
-  if (s_prefetcher.joinable())
-  {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
-  }
+  StopPrefetching();
+  StopDiskCacheWriter();
 
   if (!g_ActiveConfig.bHiresTextures)
   {
@@ -74,10 +397,31 @@ void HiresTexture::Update()
 
   if (!g_ActiveConfig.bCacheHiresTextures)
   {
-    s_textureCache.clear();
+    ClearTextureCache();
   }
 
   const std::string& game_id = SConfig::GetInstance().GetGameID();
+  s_diskCacheDirectory.clear();
+  if (g_ActiveConfig.bHiresTexturesDiskCache)
+  {
+    const std::string directory =
+        File::GetUserPath(D_CACHE_IDX) + HIRESTEXTURECACHE_DIR DIR_SEP + game_id + DIR_SEP;
+    if (File::CreateFullPath(directory))
+    {
+      s_diskCacheDirectory = directory;
+      s_diskCacheWriter.Reset("HiresTextures Disk Cache", [](DiskCacheStore store) {
+        StoreInDiskCache(store.base_filename, &store.data, store.tag);
+        if (ShouldCompress())
+        {
+          ReplaceCachedTexture(store.base_filename, std::move(store.data),
+                               store.has_arbitrary_mipmaps);
+        }
+      });
+    }
+    else
+      ERROR_LOG_FMT(VIDEO, "Failed to create the custom texture disk cache at {}", directory);
+  }
+
   const std::set<std::string> texture_directories =
       GetTextureDirectoriesWithGameId(File::GetUserPath(D_HIRESTEXTURES_IDX), game_id);
   const std::vector<std::string> extensions{".png", ".dds"};
@@ -118,99 +462,144 @@ void HiresTexture::Update()
 
   if (g_ActiveConfig.bCacheHiresTextures)
   {
-    // remove cached but deleted textures
-    auto iter = s_textureCache.begin();
-    while (iter != s_textureCache.end())
     {
-      if (s_textureMap.find(iter->first) == s_textureMap.end())
-      {
-        iter = s_textureCache.erase(iter);
-      }
-      else
+      std::lock_guard lk(s_textureCacheMutex);
+
+      // remove cached but deleted textures
+      auto iter = s_textureCache.begin();
+      while (iter != s_textureCache.end())
       {
-        iter++;
+        auto next = std::next(iter);
+        if (s_textureMap.find(iter->first) == s_textureMap.end())
+          EraseFromTextureCache(iter);
+        iter = next;
       }
+
+      s_textureCacheBudget = GetTextureCacheBudget();
+    }
+
+    for (const auto& entry : s_textureMap)
+    {
+      if (entry.first.find("_mip") == std::string::npos)
+        s_prefetchQueue.push_back(entry.first);
     }
 
+    s_prefetchThreadCount =
+        std::clamp(cpu_info.num_cores - RESERVED_CORES, 1, MAX_PREFETCH_THREADS);
+    s_prefetchBudgetReached = false;
+    ResetStatistics(&s_prefetchStatistics);
+    s_prefetchTimer.Start();
+
     s_textureCacheAbortLoading.Clear();
+    // s_prefetcher loads textures as well
+    s_prefetchPool.Start(static_cast<u32>(s_prefetchThreadCount - 1), "Prefetcher");
     s_prefetcher = std::thread(Prefetch);
   }
 }
 
 void HiresTexture::Clear()
 {
-  if (s_prefetcher.joinable())
+  StopPrefetching();
+  StopDiskCacheWriter();
+
+  if (s_onDemandStatistics.textures != 0)
+  {
+    INFO_LOG_FMT(VIDEO,
+                 "Loaded {} custom textures ({:.1f} MB) on demand in {:.1f}s, "
+                 "{} textures were evicted from the cache",
+                 s_onDemandStatistics.textures.load(),
+                 s_onDemandStatistics.bytes / (1024.0 * 1024.0),
+                 s_onDemandStatistics.load_time_us / 1000000.0, s_textureCacheEvictions.load());
+  }
+  ResetStatistics(&s_onDemandStatistics);
+  s_textureCacheEvictions = 0;
+
+  if (s_diskCacheHits != 0 || s_diskCacheStores != 0)
   {
-    s_textureCacheAbortLoading.Set();
-    s_prefetcher.join();
+    INFO_LOG_FMT(VIDEO, "Loaded {} custom textures from the disk cache and added {} to it",
+                 s_diskCacheHits.load(), s_diskCacheStores.load());
   }
+  s_diskCacheHits = 0;
+  s_diskCacheStores = 0;
+
   s_textureMap.clear();
-  s_textureCache.clear();
+  ClearTextureCache();
+}
+
+// Loads textures from the prefetch queue until it's empty or prefetching gets aborted
+void HiresTexture::PrefetchQueuedTextures()
+{
+  std::unique_lock lk(s_textureCacheMutex);
+  while (!s_textureCacheAbortLoading.IsSet() && s_prefetchQueuePosition < s_prefetchQueue.size())
+  {
+    // Prefetching more would only evict textures that were prefetched earlier
+    if (s_textureCacheSize >= s_textureCacheBudget)
+    {
+      s_prefetchBudgetReached = true;
+      break;
+    }
+
+    const std::string& base_filename = s_prefetchQueue[s_prefetchQueuePosition++];
+    if (s_textureCache.contains(base_filename) || s_texturesBeingLoaded.contains(base_filename))
+      continue;
+
+    s_texturesBeingLoaded.insert(base_filename);
+    lk.unlock();
+
+    const u64 start_us = Common::Timer::NowUs();
+    std::shared_ptr<HiresTexture> texture = Load(base_filename, 0, 0, false);
+    RecordLoad(&s_prefetchStatistics, texture.get(), start_us);
+
+    lk.lock();
+    s_texturesBeingLoaded.erase(base_filename);
+    if (texture)
+      InsertIntoTextureCache(base_filename, std::move(texture));
+    s_textureLoaded.notify_all();
+  }
 }
 
 void HiresTexture::Prefetch()
 {
   Common::SetCurrentThreadName("Prefetcher");
 
-  size_t size_sum = 0;
-  const size_t sys_mem = Common::MemPhysical();
-  const size_t recommended_min_mem = 2 * size_t(1024 * 1024 * 1024);
-  // keep 2GB memory for system stability if system RAM is 4GB+ - use half of memory in other cases
-  const size_t max_mem =
-      (sys_mem / 2 < recommended_min_mem) ? (sys_mem / 2) : (sys_mem - recommended_min_mem);
+  s_prefetchPool.ParallelFor(static_cast<u32>(s_prefetchThreadCount),
+                             [](u32) { PrefetchQueuedTextures(); });
 
-  Common::Timer timer;
-  timer.Start();
-  for (const auto& entry : s_textureMap)
-  {
-    const std::string& base_filename = entry.first;
-
-    if (base_filename.find("_mip") == std::string::npos)
-    {
-      std::unique_lock<std::mutex> lk(s_textureCacheMutex);
+  if (s_textureCacheAbortLoading.IsSet())
+    return;
 
-      auto iter = s_textureCache.find(base_filename);
-      if (iter == s_textureCache.end())
-      {
-        // unlock while loading a texture. This may result in a race condition where
-        // we'll load a texture twice, but it reduces the stuttering a lot.
-        lk.unlock();
-        std::unique_ptr<HiresTexture> texture = Load(base_filename, 0, 0);
-        lk.lock();
-        if (texture)
-        {
-          std::shared_ptr<HiresTexture> ptr(std::move(texture));
-          iter = s_textureCache.insert(iter, std::make_pair(base_filename, ptr));
-        }
-      }
-      if (iter != s_textureCache.end())
-      {
-        for (const VideoCommon::CustomTextureData::Level& l : iter->second->m_data.m_levels)
-          size_sum += l.data.size();
-      }
-    }
+  bool budget_reached;
+  size_t budget;
+  {
+    std::lock_guard lk(s_textureCacheMutex);
+    budget_reached = s_prefetchBudgetReached;
+    budget = s_textureCacheBudget;
+  }
 
-    if (s_textureCacheAbortLoading.IsSet())
-    {
-      return;
-    }
+  const u64 textures = s_prefetchStatistics.textures;
+  const double megabytes = s_prefetchStatistics.bytes / (1024.0 * 1024.0);
+  const double seconds = s_prefetchTimer.ElapsedMs() / 1000.0;
 
-    if (size_sum > max_mem)
-    {
-      Config::SetCurrent(Config::GFX_HIRES_TEXTURES, false);
-
-      OSD::AddMessage(
-          fmt::format(
-              "Custom Textures prefetching after {:.1f} MB aborted, not enough RAM available",
-              size_sum / (1024.0 * 1024.0)),
-          10000);
-      return;
-    }
+  if (budget_reached)
+  {
+    OSD::AddMessage(
+        fmt::format("Custom Textures prefetching stopped after {:.1f} MB, the memory budget of "
+                    "{:.1f} MB is used up",
+                    megabytes, budget / (1024.0 * 1024.0)),
+        10000);
+  }
+  else
+  {
+    OSD::AddMessage(fmt::format("Custom Textures loaded, {:.1f} MB in {:.1f}s", megabytes, seconds),
+                    10000);
   }
 
-  OSD::AddMessage(fmt::format("Custom Textures loaded, {:.1f} MB in {:.1f}s",
-                              size_sum / (1024.0 * 1024.0), timer.ElapsedMs() / 1000.0),
-                  10000);
+  INFO_LOG_FMT(VIDEO,
+               "Prefetched {} custom textures ({:.1f} MB) in {:.1f}s on {} threads, {:.1f} MB/s. "
+               "Loading took {:.1f} ms per texture on average.",
+               textures, megabytes, seconds, s_prefetchThreadCount,
+               seconds > 0 ? megabytes / seconds : 0.0,
+               textures > 0 ? s_prefetchStatistics.load_time_us / 1000.0 / textures : 0.0);
 }
 
 std::string HiresTexture::GenBaseName(const TextureInfo& texture_info, bool dump)
@@ -249,28 +638,43 @@ std::string HiresTexture::GenBaseName(const TextureInfo& texture_info, bool dump
 std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_info)
 {
   const std::string base_filename = GenBaseName(texture_info);
+  if (base_filename.empty())
+    return nullptr;
+
+  std::unique_lock lk(s_textureCacheMutex);
 
-  std::lock_guard<std::mutex> lk(s_textureCacheMutex);
+  // If a prefetching thread is loading the texture right now, letting it finish is quicker than
+  // starting over
+  s_textureLoaded.wait(lk, [&] { return !s_texturesBeingLoaded.contains(base_filename); });
 
   auto iter = s_textureCache.find(base_filename);
   if (iter != s_textureCache.end())
   {
-    return iter->second;
+    s_textureCacheLRU.splice(s_textureCacheLRU.begin(), s_textureCacheLRU,
+                             iter->second.lru_position);
+    return iter->second.texture;
   }
 
+  // Load the texture on this thread rather than waiting for its turn in the prefetch queue
+  s_texturesBeingLoaded.insert(base_filename);
+  lk.unlock();
+
+  const u64 start_us = Common::Timer::NowUs();
   std::shared_ptr<HiresTexture> ptr(
-      Load(base_filename, texture_info.GetRawWidth(), texture_info.GetRawHeight()));
+      Load(base_filename, texture_info.GetRawWidth(), texture_info.GetRawHeight(), true));
+  RecordLoad(&s_onDemandStatistics, ptr.get(), start_us);
 
+  lk.lock();
+  s_texturesBeingLoaded.erase(base_filename);
   if (ptr && g_ActiveConfig.bCacheHiresTextures)
-  {
-    s_textureCache[base_filename] = ptr;
-  }
+    InsertIntoTextureCache(base_filename, ptr);
+  s_textureLoaded.notify_all();
 
   return ptr;
 }
 
 std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filename, u32 width,
-                                                 u32 height)
+                                                 u32 height, bool on_gpu_thread)
 {
   // We need to have a level 0 custom texture to even consider loading.
   auto filename_iter = s_textureMap.find(base_filename);
@@ -283,6 +687,20 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
   std::unique_ptr<HiresTexture> ret = std::unique_ptr<HiresTexture>(new HiresTexture());
   const DiskTexture& first_mip_file = filename_iter->second;
   ret->m_has_arbitrary_mipmaps = first_mip_file.has_arbitrary_mipmaps;
+
+  std::optional<u64> disk_cache_tag;
+  if (!s_diskCacheDirectory.empty())
+  {
+    disk_cache_tag = GetDiskCacheTag(base_filename);
+    if (disk_cache_tag && VideoCommon::LoadTaggedDDSTexture(
+                              &ret->m_data, GetDiskCachePath(base_filename), *disk_cache_tag))
+    {
+      ++s_diskCacheHits;
+      return ret;
+    }
+    ret->m_data.m_levels.clear();
+  }
+
   VideoCommon::LoadDDSTexture(&ret->m_data, first_mip_file.path);
 
   // Load remaining mip levels, or from the start if it's not a DDS texture.
@@ -377,9 +795,44 @@ std::unique_ptr<HiresTexture> HiresTexture::Load(const std::string& base_filenam
     return nullptr;
   }
 
+  // Textures are returned in the form they're stored in, so that they look the same as when they
+  // get loaded from the disk cache later. Compressing them is too slow to do on the GPU thread, so
+  // the disk cache writer does that and then swaps the compressed texture in.
+  if (disk_cache_tag)
+  {
+    GenerateMipmaps(&ret->m_data, ret->m_has_arbitrary_mipmaps);
+    if (on_gpu_thread)
+    {
+      s_diskCacheWriter.EmplaceItem(DiskCacheStore{base_filename, ret->m_data,
+                                                   ret->m_has_arbitrary_mipmaps, *disk_cache_tag});
+    }
+    else
+    {
+      StoreInDiskCache(base_filename, &ret->m_data, *disk_cache_tag);
+    }
+  }
+
   return ret;
 }
 
+void HiresTexture::ReplaceCachedTexture(const std::string& base_filename,
+                                        VideoCommon::CustomTextureData data,
+                                        bool has_arbitrary_mipmaps)
+{
+  std::unique_ptr<HiresTexture> texture(new HiresTexture());
+  texture->m_data = std::move(data);
+  texture->m_has_arbitrary_mipmaps = has_arbitrary_mipmaps;
+
+  std::unique_lock lk(s_textureCacheMutex);
+
+  // Search inserts the texture into the cache after Load has queued it here
+  s_textureLoaded.wait(lk, [&] { return !s_texturesBeingLoaded.contains(base_filename); });
+
+  // If the texture isn't cached, it gets loaded from the disk cache the next time it's needed
+  if (s_textureCache.contains(base_filename))
+    InsertIntoTextureCache(base_filename, std::move(texture));
+}
+
 std::set<std::string> GetTextureDirectoriesWithGameId(const std::string& root_directory,
                                                       const std::string& game_id)
 {
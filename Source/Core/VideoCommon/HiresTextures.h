@@ -40,8 +40,13 @@ public:
 
 private:
   static std::unique_ptr<HiresTexture> Load(const std::string& base_filename, u32 width,
-                                            u32 height);
+                                            u32 height, bool on_gpu_thread);
   static void Prefetch();
+  static void PrefetchQueuedTextures();
+  // Replaces a texture that was loaded on the GPU thread with its transcoded form, once the disk
+  // cache writer has transcoded it
+  static void ReplaceCachedTexture(const std::string& base_filename,
+                                   VideoCommon::CustomTextureData data, bool has_arbitrary_mipmaps);
 
   HiresTexture() = default;
 
@@ -97,6 +97,8 @@ void Statistics::Display() const
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
+  draw_statistic("Split vertex loads", "%d", this_frame.num_split_vertex_loads);
+  draw_statistic("Split vertices", "%d", this_frame.num_split_vertices);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
   draw_statistic("Primitives (DL)", "%d", this_frame.num_dl_prims);
   draw_statistic("XF loads", "%d", this_frame.num_xf_loads);
@@ -108,6 +110,9 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Texture data hashed", "%i kB", this_frame.bytes_texture_hashed / 1024);
+  draw_statistic("Texture hashing skipped", "%i kB",
+                 this_frame.bytes_texture_hash_skipped / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
@@ -52,12 +52,18 @@ struct Statistics
     int num_primitive_joins = 0;
     int num_draw_calls = 0;
 
+    int num_split_vertex_loads = 0;
+    int num_split_vertices = 0;
+
     int num_dlists_called = 0;
 
     int bytes_vertex_streamed = 0;
     int bytes_index_streamed = 0;
     int bytes_uniform_streamed = 0;
 
+    int bytes_texture_hashed = 0;
+    int bytes_texture_hash_skipped = 0;
+
     int num_triangles_clipped = 0;
     int num_triangles_in = 0;
     int num_triangles_rejected = 0;
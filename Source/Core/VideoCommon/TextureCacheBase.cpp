@@ -18,6 +18,7 @@
 
 #include "Common/Align.h"
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 #include "Common/FileUtil.h"
@@ -60,6 +61,8 @@ static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
+// Forget the memory hashes of textures that aren't used anymore once there are this many
+static const size_t MAX_MEMORY_HASHES = 0x10000;
 
 static int xfb_count = 0;
 
@@ -111,6 +114,8 @@ void TextureCacheBase::Shutdown()
 
   HiresTexture::Shutdown();
 
+  m_texture_decoding_pool.Stop();
+
   // For correctness, we need to invalidate textures before the gpu context starts shutting down.
   Invalidate();
 }
@@ -129,6 +134,10 @@ bool TextureCacheBase::Initialize()
     return false;
   }
 
+  // The GPU thread decodes as well. Leave some cores for the CPU thread and the rest of the system.
+  m_texture_decoding_pool.Start(static_cast<u32>(std::clamp(cpu_info.num_cores - 3, 0, 3)),
+                                "Texture Decoding");
+
   return true;
 }
 
@@ -141,6 +150,7 @@ void TextureCacheBase::Invalidate()
     bind.reset();
   textures_by_hash.clear();
   textures_by_address.clear();
+  memory_hashes.clear();
 
   texture_pool.clear();
 }
@@ -158,8 +168,18 @@ void TextureCacheBase::ForceReload()
 
 void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 {
+  // Loaded custom textures look different depending on whether they went through the disk cache
+  const bool hires_textures_disk_cache_changed =
+      config.bHiresTexturesDiskCache != backup_config.hires_textures_disk_cache ||
+      config.bHiresTexturesDiskCacheCompression !=
+          backup_config.hires_textures_disk_cache_compression;
+  if (hires_textures_disk_cache_changed)
+    HiresTexture::Clear();
+
   if (config.bHiresTextures != backup_config.hires_textures ||
-      config.bCacheHiresTextures != backup_config.cache_hires_textures)
+      config.bCacheHiresTextures != backup_config.cache_hires_textures ||
+      config.iHiresTexturesCacheSize != backup_config.hires_textures_cache_size ||
+      hires_textures_disk_cache_changed)
   {
     HiresTexture::Update();
   }
@@ -172,6 +192,7 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
       config.bTexFmtOverlayEnable != backup_config.texfmt_overlay ||
       config.bTexFmtOverlayCenter != backup_config.texfmt_overlay_center ||
       config.bHiresTextures != backup_config.hires_textures ||
+      hires_textures_disk_cache_changed ||
       config.bEnableGPUTextureDecoding != backup_config.gpu_texture_decoding ||
       config.bDisableCopyToVRAM != backup_config.disable_vram_copies ||
       config.bArbitraryMipmapDetection != backup_config.arbitrary_mipmap_detection ||
@@ -187,6 +208,9 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 
 void TextureCacheBase::Cleanup(int _frameCount)
 {
+  if (memory_hashes.size() > MAX_MEMORY_HASHES)
+    memory_hashes.clear();
+
   TexAddrCache::iterator iter = textures_by_address.begin();
   TexAddrCache::iterator tcend = textures_by_address.end();
   while (iter != tcend)
@@ -262,6 +286,9 @@ void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
   backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   backup_config.hires_textures = config.bHiresTextures;
   backup_config.cache_hires_textures = config.bCacheHiresTextures;
+  backup_config.hires_textures_cache_size = config.iHiresTexturesCacheSize;
+  backup_config.hires_textures_disk_cache = config.bHiresTexturesDiskCache;
+  backup_config.hires_textures_disk_cache_compression = config.bHiresTexturesDiskCacheCompression;
   backup_config.stereo_3d = config.stereo_mode != StereoMode::Off;
   backup_config.efb_mono_depth = config.bStereoEFBMonoDepth;
   backup_config.gpu_texture_decoding = config.bEnableGPUTextureDecoding;
@@ -1292,9 +1319,22 @@ TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 
     // Otherwise, hash the backing memory and check it's unchanged.
     // FIXME: this doesn't correctly handle textures from tmem.
-    if (!entry->invalidated && entry->base_hash == entry->CalculateHash())
+    if (!entry->invalidated)
     {
-      return entry;
+      u64 hash;
+      if (entry->memory_stride == entry->BytesPerRow())
+      {
+        auto& memory = Core::System::GetInstance().GetMemory();
+        hash = HashTextureMemory(entry->addr, memory.GetPointer(entry->addr), entry->size_in_bytes,
+                                 entry->HashSampleSize());
+      }
+      else
+      {
+        hash = entry->CalculateHash();
+      }
+
+      if (entry->base_hash == hash)
+        return entry;
     }
   }
 
@@ -1325,6 +1365,35 @@ TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
   return entry.get();
 }
 
+u64 TextureCacheBase::HashTextureMemory(u32 address, const u8* ptr, u32 size, int sample_size)
+{
+  auto& memory = Core::System::GetInstance().GetMemory();
+  const std::optional<u64> write_generation = memory.GetWriteGeneration(ptr, size);
+  const u64 key = address | static_cast<u64>(size) << 32;
+
+  if (write_generation)
+  {
+    const auto iter = memory_hashes.find(key);
+    if (iter != memory_hashes.end() && iter->second.write_generation == *write_generation &&
+        iter->second.sample_size == sample_size)
+    {
+      ADDSTAT(g_stats.this_frame.bytes_texture_hash_skipped, size);
+      return iter->second.hash;
+    }
+  }
+
+  const u64 hash = Common::GetHash64(ptr, size, sample_size);
+  ADDSTAT(g_stats.this_frame.bytes_texture_hashed, size);
+
+  // Memory that is being written to can't be trusted until write tracking has caught up with it
+  if (write_generation)
+    memory_hashes[key] = {*write_generation, hash, sample_size};
+  else
+    memory_hashes.erase(key);
+
+  return hash;
+}
+
 RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize,
                                            const TextureInfo& texture_info)
 {
@@ -1363,8 +1432,16 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  if (texture_info.IsFromTmem())
+  {
+    base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
+                                  textureCacheSafetyColorSampleSize);
+  }
+  else
+  {
+    base_hash = HashTextureMemory(texture_info.GetRawAddress(), texture_info.GetData(),
+                                  texture_info.GetTextureSize(), textureCacheSafetyColorSampleSize);
+  }
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
@@ -1659,6 +1736,19 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
     // Initialized to null because only software loading uses this buffer
     u8* dst_buffer = nullptr;
 
+    // Levels which are decoded on the CPU, and the subset of them which still has to be decoded
+    struct CPUDecodedLevel
+    {
+      u32 level;
+      u32 width;
+      u32 height;
+      u32 row_length;
+      const u8* data;
+      size_t size;
+    };
+    std::vector<CPUDecodedLevel> cpu_levels;
+    std::vector<TexDecoderLevel> decode_levels;
+
     if (!decode_on_gpu ||
         !DecodeTextureOnGPU(
             entry, 0, texture_info.GetData(), texture_info.GetTextureSize(),
@@ -1688,9 +1778,9 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
       dst_buffer = temp;
       if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
       {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
+        decode_levels.push_back({dst_buffer, texture_info.GetData(),
+                                 static_cast<int>(expanded_width),
+                                 static_cast<int>(expanded_height)});
       }
       else
       {
@@ -1699,9 +1789,7 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
                                        expanded_height);
       }
 
-      entry->texture->Load(0, width, height, expanded_width, dst_buffer, decoded_texture_size);
-
-      arbitrary_mip_detector.AddLevel(width, height, expanded_width, dst_buffer);
+      cpu_levels.push_back({0, width, height, expanded_width, dst_buffer, decoded_texture_size});
 
       dst_buffer += decoded_texture_size;
     }
@@ -1724,19 +1812,28 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
-        entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
-                             mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
-
-        arbitrary_mip_detector.AddLevel(mip_level->GetRawWidth(), mip_level->GetRawHeight(),
-                                        mip_level->GetExpandedWidth(), dst_buffer);
+        decode_levels.push_back({dst_buffer, mip_level->GetData(),
+                                 static_cast<int>(mip_level->GetExpandedWidth()),
+                                 static_cast<int>(mip_level->GetExpandedHeight())});
+        cpu_levels.push_back({level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
+                              mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size});
 
         dst_buffer += decoded_mip_size;
       }
     }
 
+    // Decode all levels at once, so that large textures can be split between threads
+    TexDecoder_DecodeLevels(m_texture_decoding_pool, decode_levels,
+                            texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
+                            texture_info.GetTlutFormat());
+
+    for (const CPUDecodedLevel& level : cpu_levels)
+    {
+      entry->texture->Load(level.level, level.width, level.height, level.row_length, level.data,
+                           level.size);
+      arbitrary_mip_detector.AddLevel(level.width, level.height, level.row_length, level.data);
+    }
+
     entry->has_arbitrary_mips = arbitrary_mip_detector.HasArbitraryMipmaps(dst_buffer);
 
     if (g_ActiveConfig.bDumpTextures)
@@ -19,6 +19,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/BPMemory.h"
@@ -370,6 +371,10 @@ private:
   std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
   FindOverlappingTextures(u32 addr, u32 size_in_bytes);
 
+  // Hashes texture data in emulated memory. The hash from the last time the same range was hashed
+  // is reused if memory write tracking shows that the range hasn't been written to since then.
+  u64 HashTextureMemory(u32 address, const u8* ptr, u32 size, int sample_size);
+
   // Removes and unlinks texture from texture cache and returns it to the pool
   TexAddrCache::iterator InvalidateTexture(TexAddrCache::iterator t_iter,
                                            bool discard_pending_efb_copy = false);
@@ -406,6 +411,15 @@ private:
   // All textures in here will also be in textures_by_address
   TexHashCache textures_by_hash;
 
+  // Hashes of texture data in emulated memory, keyed by address and size
+  struct MemoryHash
+  {
+    u64 write_generation;
+    u64 hash;
+    int sample_size;
+  };
+  std::unordered_map<u64, MemoryHash> memory_hashes;
+
   // bound_textures are actually active in the current draw
   // It's valid for textures to be in here after they've been invalidated
   std::array<RcTcacheEntry, 8> bound_textures{};
@@ -421,6 +435,9 @@ private:
     bool texfmt_overlay_center;
     bool hires_textures;
     bool cache_hires_textures;
+    int hires_textures_cache_size;
+    bool hires_textures_disk_cache;
+    bool hires_textures_disk_cache_compression;
     bool copy_cache_enable;
     bool stereo_3d;
     bool efb_mono_depth;
@@ -452,6 +469,9 @@ private:
   // readbacks, saving the overhead of allocating a new buffer every time.
   std::unique_ptr<AbstractStagingTexture> m_readback_texture;
 
+  // Threads used to split up decoding large textures on the CPU.
+  Common::ThreadPool m_texture_decoding_pool;
+
   void OnFrameEnd();
 
   Common::Flag m_force_reload_textures;
@@ -3,10 +3,16 @@
 
 #pragma once
 
+#include <span>
 #include <tuple>
 #include "Common/CommonTypes.h"
 #include "Common/EnumFormatter.h"
 
+namespace Common
+{
+class ThreadPool;
+}
+
 enum
 {
   TMEM_SIZE = 1024 * 1024,
@@ -182,6 +188,19 @@ TextureFormat TexDecoder_GetEFBCopyBaseFormat(EFBCopyFormat format);
 
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
                        const u8* tlut, TLUTFormat tlutfmt);
+
+struct TexDecoderLevel
+{
+  u8* dst;
+  const u8* src;
+  int width;
+  int height;
+};
+
+// Decodes several levels of a texture like TexDecoder_Decode. Large textures are split into strips
+// of blocks which are decoded by the threads of the given pool.
+void TexDecoder_DecodeLevels(Common::ThreadPool& pool, std::span<const TexDecoderLevel> levels,
+                             TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt);
 void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
                                     int height);
 void TexDecoder_DecodeTexel(u8* dst, const u8* src, int s, int t, int imageWidth,
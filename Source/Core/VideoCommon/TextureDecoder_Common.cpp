@@ -4,10 +4,13 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <vector>
 
+#include "Common/Align.h"
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
+#include "Common/ThreadPool.h"
 
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -304,6 +307,59 @@ void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFor
     TexDecoder_DrawOverlay(dst, width, height, texformat);
 }
 
+void TexDecoder_DecodeLevels(Common::ThreadPool& pool, std::span<const TexDecoderLevel> levels,
+                             TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  // Splitting is only worth it if waking up the worker threads takes less time than decoding.
+  constexpr int MIN_TEXELS_FOR_SPLITTING = 256 * 256;
+  constexpr int TEXELS_PER_STRIP = 128 * 128;
+
+  int total_texels = 0;
+  for (const TexDecoderLevel& level : levels)
+    total_texels += level.width * level.height;
+
+  if (pool.GetNumWorkers() == 0 || total_texels < MIN_TEXELS_FOR_SPLITTING)
+  {
+    for (const TexDecoderLevel& level : levels)
+      TexDecoder_Decode(level.dst, level.src, level.width, level.height, texformat, tlut, tlutfmt);
+    return;
+  }
+
+  struct Strip
+  {
+    const TexDecoderLevel* level;
+    int first_row;
+    int num_rows;
+  };
+  std::vector<Strip> strips;
+
+  // Strips consist of whole rows of blocks, which are stored contiguously in both the source and
+  // the decoded texture.
+  const u32 block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+  for (const TexDecoderLevel& level : levels)
+  {
+    const int rows_per_strip = static_cast<int>(std::max(
+        block_height, Common::AlignUp<u32>(TEXELS_PER_STRIP / level.width, block_height)));
+    for (int row = 0; row < level.height; row += rows_per_strip)
+      strips.push_back({&level, row, std::min(rows_per_strip, level.height - row)});
+  }
+
+  pool.ParallelFor(static_cast<u32>(strips.size()), [&](u32 index) {
+    const Strip& strip = strips[index];
+    const TexDecoderLevel& level = *strip.level;
+    _TexDecoder_DecodeImpl(
+        reinterpret_cast<u32*>(level.dst) + strip.first_row * level.width,
+        level.src + TexDecoder_GetTextureSizeInBytes(level.width, strip.first_row, texformat),
+        level.width, strip.num_rows, texformat, tlut, tlutfmt);
+  });
+
+  if (TexFmt_Overlay_Enable)
+  {
+    for (const TexDecoderLevel& level : levels)
+      TexDecoder_DrawOverlay(level.dst, level.width, level.height, texformat);
+  }
+}
+
 static inline u32 DecodePixel_IA8(u16 val)
 {
   int a = val & 0xFF;
@@ -21,6 +21,7 @@ public:
 
 protected:
   int RunVertices(const u8* src, u8* dst, int count) override;
+  bool SupportsConcurrentRuns() const override { return true; }
 
 private:
   u32 m_src_ofs = 0;
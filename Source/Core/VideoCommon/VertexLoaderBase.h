@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -65,6 +66,10 @@ public:
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(const u8* src, u8* dst, int count) = 0;
 
+  // Whether RunVertices can be called on several threads at once for different parts of a
+  // primitive. Every call still updates the zfreeze caches from the last vertices it loads.
+  virtual bool SupportsConcurrentRuns() const { return false; }
+
   // per loader public state
   PortableVertexDeclaration m_native_vtx_decl{};
   const u32 m_vertex_size;  // number of bytes of a raw GC vertex
@@ -72,7 +77,7 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
+  std::atomic<int> m_numLoadedVertices = 0;
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
@@ -4,6 +4,8 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <iterator>
 #include <memory>
 #include <mutex>
@@ -13,9 +15,11 @@
 #include <utility>
 #include <vector>
 
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
 #include "Common/Logging/Log.h"
+#include "Common/ThreadPool.h"
 
 #include "Core/DolphinAnalytics.h"
 #include "Core/HW/Memmap.h"
@@ -54,6 +58,14 @@ static VertexLoaderMap s_vertex_loader_map;
 
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
 
+// Large primitives get split into parts of at least this many vertices, which are loaded on
+// several threads. Anything smaller isn't worth waking up the workers for. How often games reach
+// this is shown as "Split vertex loads" in the statistics window.
+constexpr int MIN_VERTICES_PER_LOADING_PART = 4096;
+constexpr u32 MAX_VERTEX_LOADING_WORKERS = 3;
+
+static Common::ThreadPool s_vertex_loading_pool;
+
 BitSet8 g_main_vat_dirty;
 BitSet8 g_preprocess_vat_dirty;
 bool g_bases_dirty;  // Main only
@@ -69,10 +81,17 @@ void Init()
   for (auto& map_entry : g_preprocess_vertex_loaders)
     map_entry = nullptr;
   SETSTAT(g_stats.num_vertex_loaders, 0);
+
+  // The GPU thread loads a part of each split primitive as well
+  s_vertex_loading_pool.Start(static_cast<u32>(std::clamp<int>(cpu_info.num_cores - 3, 0,
+                                                               MAX_VERTEX_LOADING_WORKERS)),
+                              "Vertex Loading");
 }
 
 void Clear()
 {
+  s_vertex_loading_pool.Stop();
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
@@ -333,6 +352,82 @@ static void CheckCPConfiguration(int vtx_attr_group)
   }
 }
 
+// Produces exactly the same output as a single call to loader->RunVertices, but splits large
+// primitives into parts which are loaded concurrently. All parts are done before this returns, so
+// nothing which runs after the draw (EFB access, bounding box, zfreeze) can observe the split.
+static int RunVertexLoader(VertexLoaderBase* loader, const u8* src, u8* dst, int count)
+{
+  // The thread calling ParallelFor helps with the parts, so splitting only pays off if there is at
+  // least one worker to run parts at the same time
+  const u32 num_workers = s_vertex_loading_pool.GetNumWorkers();
+  const u32 num_parts = std::min<u32>(count / MIN_VERTICES_PER_LOADING_PART, num_workers + 1);
+  if (num_workers == 0 || num_parts < 2 || !loader->SupportsConcurrentRuns())
+    return loader->RunVertices(src, dst, count);
+
+  INCSTAT(g_stats.this_frame.num_split_vertex_loads);
+  ADDSTAT(g_stats.this_frame.num_split_vertices, count);
+
+  const int part_size = count / num_parts;
+  const u32 src_stride = loader->m_vertex_size;
+  const u32 dst_stride = loader->m_native_vtx_decl.stride;
+  std::array<int, MAX_VERTEX_LOADING_WORKERS + 1> loaded_counts;
+
+  // Every run writes the zfreeze caches from its last 3 vertices. The values the parts write are
+  // thrown away below, so only what the caches contained before this primitive is kept.
+  const auto saved_position_cache = position_cache;
+  const auto saved_position_matrix_index_cache = position_matrix_index_cache;
+  const auto saved_tangent_cache = tangent_cache;
+  const auto saved_binormal_cache = binormal_cache;
+
+  // The loaders may write up to 4 bytes past the last vertex they load, which would race with the
+  // part after it. So every part except for the last one leaves out its last vertex, and those get
+  // loaded one at a time once all parts are done, restoring whatever they write past their end.
+  s_vertex_loading_pool.ParallelFor(num_parts, [&](u32 part) {
+    const int first = static_cast<int>(part) * part_size;
+    const int part_count = part == num_parts - 1 ? count - first : part_size - 1;
+    loaded_counts[part] =
+        loader->RunVertices(src + first * src_stride, dst + first * dst_stride, part_count);
+  });
+
+  for (u32 part = 0; part < num_parts - 1; ++part)
+  {
+    const int last = static_cast<int>(part + 1) * part_size - 1;
+    u8* const vertex_dst =
+        dst + (static_cast<int>(part) * part_size + loaded_counts[part]) * dst_stride;
+    std::array<u8, 4> overwritten;
+    std::memcpy(overwritten.data(), vertex_dst + dst_stride, overwritten.size());
+    loaded_counts[part] += loader->RunVertices(src + last * src_stride, vertex_dst, 1);
+    std::memcpy(vertex_dst + dst_stride, overwritten.data(), overwritten.size());
+  }
+
+  // Load the last vertices of the primitive once more on this thread, which leaves the zfreeze
+  // caches exactly as loading everything at once would have (including for skipped vertices)
+  position_cache = saved_position_cache;
+  position_matrix_index_cache = saved_position_matrix_index_cache;
+  tangent_cache = saved_tangent_cache;
+  binormal_cache = saved_binormal_cache;
+
+  constexpr int ZFREEZE_CACHED_VERTICES = 3;
+  std::vector<u8> zfreeze_scratch(ZFREEZE_CACHED_VERTICES * dst_stride + 4);
+  loader->RunVertices(src + (count - ZFREEZE_CACHED_VERTICES) * src_stride,
+                      zfreeze_scratch.data(), ZFREEZE_CACHED_VERTICES);
+  loader->m_numLoadedVertices -= ZFREEZE_CACHED_VERTICES;
+
+  // Skipped vertices (primitive restart indices) leave gaps between the parts
+  int loaded = loaded_counts[0];
+  for (u32 part = 1; part < num_parts; ++part)
+  {
+    const int first = static_cast<int>(part) * part_size;
+    if (loaded != first)
+    {
+      std::memmove(dst + loaded * dst_stride, dst + first * dst_stride,
+                   loaded_counts[part] * dst_stride);
+    }
+    loaded += loaded_counts[part];
+  }
+  return loaded;
+}
+
 template <bool IsPreprocess>
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src)
 {
@@ -385,7 +480,7 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, count, stride,
                                                                 cullall || can_cpu_cull);
 
-    count = loader->RunVertices(src, dst.GetPointer(), count);
+    count = RunVertexLoader(loader, src, dst.GetPointer(), count);
 
     if (can_cpu_cull && !cullall)
     {
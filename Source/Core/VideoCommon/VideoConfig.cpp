@@ -98,6 +98,10 @@ void VideoConfig::Refresh()
   bDumpBaseTextures = Config::Get(Config::GFX_DUMP_BASE_TEXTURES);
   bHiresTextures = Config::Get(Config::GFX_HIRES_TEXTURES);
   bCacheHiresTextures = Config::Get(Config::GFX_CACHE_HIRES_TEXTURES);
+  iHiresTexturesCacheSize = Config::Get(Config::GFX_HIRES_TEXTURES_CACHE_SIZE);
+  bHiresTexturesDiskCache = Config::Get(Config::GFX_HIRES_TEXTURES_DISK_CACHE);
+  bHiresTexturesDiskCacheCompression =
+      Config::Get(Config::GFX_HIRES_TEXTURES_DISK_CACHE_COMPRESSION);
   bDumpEFBTarget = Config::Get(Config::GFX_DUMP_EFB_TARGET);
   bDumpXFBTarget = Config::Get(Config::GFX_DUMP_XFB_TARGET);
   bDumpFramesAsImages = Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
@@ -130,6 +134,7 @@ void VideoConfig::Refresh()
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
   bCPUCull = Config::Get(Config::GFX_CPU_CULL);
+  iSWRasterizerThreads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
 
   texture_filtering_mode = Config::Get(Config::GFX_ENHANCE_FORCE_TEXTURE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -244,6 +249,15 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
     return 1;
 }
 
+u32 VideoConfig::GetSWRasterizerThreads() const
+{
+  if (iSWRasterizerThreads > 0)
+    return static_cast<u32>(iSWRasterizerThreads);
+
+  // Automatic number. The GPU thread rasterizes too, so this leaves one core for the CPU thread.
+  return static_cast<u32>(std::max(cpu_info.num_cores - 1, 1));
+}
+
 void CheckForConfigChanges()
 {
   const ShaderHostConfig old_shader_host_config = ShaderHostConfig::GetCurrent();
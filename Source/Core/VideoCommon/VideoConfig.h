@@ -130,6 +130,12 @@ struct VideoConfig final
   bool bDumpBaseTextures = false;
   bool bHiresTextures = false;
   bool bCacheHiresTextures = false;
+  // In MiB. 0 picks a size based on the amount of RAM.
+  int iHiresTexturesCacheSize = 0;
+  // Transcodes PNG custom textures into DDS files with full mip chains in the cache directory
+  bool bHiresTexturesDiskCache = false;
+  // Makes the disk cache block compress the textures, which saves memory at the cost of quality
+  bool bHiresTexturesDiskCacheCompression = false;
   bool bDumpEFBTarget = false;
   bool bDumpXFBTarget = false;
   bool bDumpFramesAsImages = false;
@@ -214,6 +220,11 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of threads used by the software renderer to rasterize.
+  // 1 rasterizes on the GPU thread only.
+  // 0 or less uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads = 1;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -316,6 +327,7 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetSWRasterizerThreads() const;
 };
 
 extern VideoConfig g_Config;
@@ -0,0 +1,42 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+
+// Benchmarks are tests named DISABLED_*Throughput, so that they only run when asked for by passing
+// --gtest_also_run_disabled_tests --gtest_filter='*Throughput' to a test binary. They print how
+// fast the code runs on the machine they run on, and don't check anything.
+
+namespace UnitTests
+{
+// Runs function once to warm up, then runs it the given number of times and prints how long a run
+// took on average. If bytes_per_run isn't zero, the throughput is printed too.
+template <typename Function>
+void RunBenchmark(std::string_view name, u64 runs, u64 bytes_per_run, Function function)
+{
+  function();
+
+  const auto start = std::chrono::steady_clock::now();
+  for (u64 i = 0; i < runs; ++i)
+    function();
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  const double us_per_run = elapsed.count() * 1e6 / runs;
+  if (bytes_per_run == 0)
+  {
+    fmt::print("{:<40} {:>12.2f} us per run\n", name, us_per_run);
+  }
+  else
+  {
+    fmt::print("{:<40} {:>12.2f} us per run, {:>7.2f} GB/s\n", name, us_per_run,
+               runs * bytes_per_run / elapsed.count() / 1e9);
+  }
+}
+}  // namespace UnitTests
@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 
+#include <array>
+#include <vector>
+
+#include "Common/CommonTypes.h"
 #include "Common/Crypto/SHA1.h"
 
+#include "../../Benchmark.h"
+
 // Just a few quick sanity checks
 TEST(SHA1, Vectors)
 {
@@ -28,3 +34,52 @@ TEST(SHA1, Vectors)
     EXPECT_EQ(test.expected, actual);
   }
 }
+
+TEST(SHA1, BatchMatchesSingle)
+{
+  constexpr size_t MAX_COUNT = 19;
+  constexpr size_t STRIDE = 0x440;
+  std::vector<u8> data(MAX_COUNT * STRIDE);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<u8>(i * 7 + i / 251);
+
+  // Cover lengths around the block size and around the point where padding needs an extra block
+  constexpr std::array<size_t, 11> msg_lens{0, 1, 55, 56, 63, 64, 65, 119, 120, 0x3FF, 0x400};
+  constexpr std::array<size_t, 6> counts{1, 2, 3, 8, 9, MAX_COUNT};
+
+  for (size_t msg_len : msg_lens)
+  {
+    for (size_t count : counts)
+    {
+      std::vector<Common::SHA1::Digest> digests(count);
+      Common::SHA1::CalculateDigests(data.data(), msg_len, STRIDE, count, digests.data());
+
+      for (size_t i = 0; i < count; ++i)
+      {
+        EXPECT_EQ(Common::SHA1::CalculateDigest(data.data() + i * STRIDE, msg_len), digests[i])
+            << "msg_len " << msg_len << ", count " << count << ", message " << i;
+      }
+    }
+  }
+}
+
+// Hashes of Wii partition data, with and without batching
+TEST(SHA1, DISABLED_BatchThroughput)
+{
+  // The H0 hashes of a Wii group cover 31 blocks of 0x400 bytes in each of its 64 clusters
+  constexpr size_t MSG_LEN = 0x400;
+  constexpr size_t COUNT = 31 * 64;
+  constexpr u64 RUNS = 512;
+  std::vector<u8> data(MSG_LEN * COUNT);
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<u8>(i * 7 + i / 251);
+
+  std::vector<Common::SHA1::Digest> digests(COUNT);
+  UnitTests::RunBenchmark("CalculateDigest", RUNS, data.size(), [&] {
+    for (size_t i = 0; i < COUNT; ++i)
+      digests[i] = Common::SHA1::CalculateDigest(data.data() + i * MSG_LEN, MSG_LEN);
+  });
+  UnitTests::RunBenchmark("CalculateDigests", RUNS, data.size(), [&] {
+    Common::SHA1::CalculateDigests(data.data(), MSG_LEN, MSG_LEN, COUNT, digests.data());
+  });
+}
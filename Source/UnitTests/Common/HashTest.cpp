@@ -0,0 +1,143 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+#include "../Benchmark.h"
+
+namespace
+{
+// 32x32 I4, 64x64 RGB5A3, 256x256 CMPR, 512x512 RGBA8, and a few sizes which aren't a multiple
+// of anything in particular
+constexpr std::array<u32, 7> TEXTURE_SIZES = {512, 8192, 32768, 1048576, 1000, 4100, 65541};
+
+std::vector<u8> MakeData(size_t size)
+{
+  std::vector<u8> data(size);
+  u32 state = 0x12345678;
+  for (u8& byte : data)
+  {
+    state = state * 1103515245 + 12345;
+    byte = static_cast<u8>(state >> 16);
+  }
+  return data;
+}
+}  // namespace
+
+TEST(Hash, FullHashDoesNotDependOnAlignment)
+{
+  for (const u32 size : TEXTURE_SIZES)
+  {
+    const std::vector<u8> data = MakeData(size);
+    std::vector<u8> buffer(size + 64);
+    for (u32 offset : {1, 4, 8, 31})
+    {
+      std::memcpy(buffer.data() + offset, data.data(), size);
+      EXPECT_EQ(Common::GetHash64(data.data(), size, 0),
+                Common::GetHash64(buffer.data() + offset, size, 0))
+          << "size " << size << ", offset " << offset;
+    }
+  }
+}
+
+TEST(Hash, FullHashDetectsSingleByteChanges)
+{
+  for (const u32 size : {512u, 4100u})
+  {
+    std::vector<u8> data = MakeData(size);
+    const u64 hash = Common::GetHash64(data.data(), size, 0);
+    for (u32 i = 0; i < size; ++i)
+    {
+      data[i] ^= 0x10;
+      EXPECT_NE(hash, Common::GetHash64(data.data(), size, 0)) << "size " << size << ", byte " << i;
+      data[i] ^= 0x10;
+    }
+  }
+}
+
+TEST(Hash, FullHashDependsOnOrder)
+{
+  std::vector<u8> data = MakeData(8192);
+  const u64 hash = Common::GetHash64(data.data(), static_cast<u32>(data.size()), 0);
+
+  // Swap two tiles of 128 bytes
+  std::swap_ranges(data.begin() + 1024, data.begin() + 1152, data.begin() + 3072);
+  EXPECT_NE(hash, Common::GetHash64(data.data(), static_cast<u32>(data.size()), 0));
+}
+
+TEST(Hash, FullHashDependsOnLength)
+{
+  std::vector<u8> data = MakeData(4096);
+  data[4000] = 0;
+  EXPECT_NE(Common::GetHash64(data.data(), 4000, 0), Common::GetHash64(data.data(), 4001, 0));
+}
+
+TEST(Hash, EnoughSamplesIsFullHash)
+{
+  for (const u32 size : TEXTURE_SIZES)
+  {
+    const std::vector<u8> data = MakeData(size);
+    EXPECT_EQ(Common::GetHash64(data.data(), size, 0),
+              Common::GetHash64(data.data(), size, size / 8))
+        << "size " << size;
+  }
+}
+
+TEST(Hash, WideFullHashGoldenValue)
+{
+  // The wide kernels are used for full hashes of at least 1 KiB on x86-64 CPUs with AVX2 and on
+  // ARM64 CPUs with CRC32. They must give the same results, so they share this value.
+#if defined(_M_X86_64)
+  const bool uses_wide_hash = cpu_info.bCRC32 && cpu_info.bAVX2;
+#elif defined(_M_ARM_64)
+  const bool uses_wide_hash = cpu_info.bCRC32;
+#else
+  const bool uses_wide_hash = false;
+#endif
+  if (!uses_wide_hash)
+    return;
+
+  const std::vector<u8> data = MakeData(8192);
+  EXPECT_EQ(Common::GetHash64(data.data(), static_cast<u32>(data.size()), 0),
+            0xbdef2351987db29bULL);
+}
+
+TEST(Hash, StableHash)
+{
+  std::array<u8, 256> data;
+  for (size_t i = 0; i < data.size(); ++i)
+    data[i] = static_cast<u8>(i);
+
+  // These must never change, since they are used in the names of files in the cache directory
+  EXPECT_EQ(Common::GetStableHash64(data.data(), 256), 0xbb4e0e11c5f8e635ULL);
+  EXPECT_EQ(Common::GetStableHash64(data.data(), 13), 0x352e6cbdc48d17a6ULL);
+}
+
+// Hashes of textures of typical sizes
+TEST(Hash, DISABLED_TextureHashThroughput)
+{
+  constexpr u64 BYTES_PER_SIZE = 1 << 30;
+
+  for (const u32 size : TEXTURE_SIZES)
+  {
+    const std::vector<u8> data = MakeData(size);
+    for (const u32 samples : {0u, 128u})
+    {
+      volatile u64 hash;
+      UnitTests::RunBenchmark(fmt::format("{} bytes, {} samples", size, samples),
+                              std::max<u64>(BYTES_PER_SIZE / size, 1), size,
+                              [&] { hash = Common::GetHash64(data.data(), size, samples); });
+    }
+  }
+}
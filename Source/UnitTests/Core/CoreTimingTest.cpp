@@ -3,9 +3,13 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
+#include <random>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -17,6 +21,8 @@
 #include "Core/System.h"
 #include "UICommon/UICommon.h"
 
+#include "../Benchmark.h"
+
 // Numbers are chosen randomly to make sure the correct one is given.
 static constexpr std::array<u64, 5> CB_IDS{{42, 144, 93, 1026, UINT64_C(0xFFFF7FFFF7FFFF)}};
 static constexpr int MAX_SLICE_LENGTH = 20000;  // Copied from CoreTiming internals
@@ -401,3 +407,135 @@ TEST(CoreTiming, Overclocking)
   Config::SetCurrent(Config::MAIN_OVERCLOCK, 1.0f);
   AdvanceAndCheck(system, 4, MAX_SLICE_LENGTH);
 }
+
+namespace EventQueueTest
+{
+struct EventGreater
+{
+  bool operator()(const CoreTiming::Event& left, const CoreTiming::Event& right) const
+  {
+    return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
+  }
+};
+
+// The std::vector min-heap that CoreTiming used before EventQueue, kept as a reference for
+// ordering and performance.
+class ReferenceHeap
+{
+public:
+  bool Empty() const { return m_heap.empty(); }
+  const CoreTiming::Event& Top() const { return m_heap.front(); }
+
+  void Push(const CoreTiming::Event& event)
+  {
+    m_heap.push_back(event);
+    std::push_heap(m_heap.begin(), m_heap.end(), EventGreater());
+  }
+
+  CoreTiming::Event Pop()
+  {
+    const CoreTiming::Event event = m_heap.front();
+    std::pop_heap(m_heap.begin(), m_heap.end(), EventGreater());
+    m_heap.pop_back();
+    return event;
+  }
+
+  void RemoveAll(CoreTiming::EventType* event_type)
+  {
+    auto itr = std::remove_if(m_heap.begin(), m_heap.end(),
+                              [&](const CoreTiming::Event& e) { return e.type == event_type; });
+    if (itr != m_heap.end())
+    {
+      m_heap.erase(itr, m_heap.end());
+      std::make_heap(m_heap.begin(), m_heap.end(), EventGreater());
+    }
+  }
+
+private:
+  std::vector<CoreTiming::Event> m_heap;
+};
+
+// Simulates a scheduler workload: events are popped in order, most of them reschedule themselves
+// with a random period (often colliding with other events), and some event types are frequently
+// descheduled like the DVD, SI and AI polling events are. Returns the order events were popped in.
+template <typename Queue>
+static std::vector<u64> RunWorkload(Queue& queue, std::vector<CoreTiming::EventType>& types,
+                                    int iterations)
+{
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<s64> period(0, 64);
+  std::uniform_int_distribution<size_t> type_dist(0, types.size() - 1);
+  std::uniform_int_distribution<int> action(0, 7);
+
+  u64 fifo_id = 0;
+  const auto push = [&](s64 time, CoreTiming::EventType* type) {
+    const u64 id = fifo_id++;
+    queue.Push(CoreTiming::Event{time, id, id, type});
+  };
+
+  for (CoreTiming::EventType& type : types)
+  {
+    for (int i = 0; i < 4; ++i)
+      push(period(rng), &type);
+  }
+
+  std::vector<u64> popped;
+  popped.reserve(iterations);
+  for (int i = 0; i < iterations && !queue.Empty(); ++i)
+  {
+    const CoreTiming::Event event = queue.Pop();
+    popped.push_back(event.userdata);
+
+    CoreTiming::EventType* type = &types[type_dist(rng)];
+    if (action(rng) == 0)
+      queue.RemoveAll(type);
+    push(event.time + period(rng), type);
+    push(event.time + period(rng), event.type);
+  }
+  return popped;
+}
+}  // namespace EventQueueTest
+
+TEST(CoreTiming, EventQueueMatchesReferenceHeap)
+{
+  using namespace EventQueueTest;
+
+  static constexpr int ITERATIONS = 200000;
+  std::vector<CoreTiming::EventType> types(32);
+
+  ReferenceHeap reference;
+  const std::vector<u64> reference_order = RunWorkload(reference, types, ITERATIONS);
+
+  CoreTiming::EventQueue queue;
+  const std::vector<u64> queue_order = RunWorkload(queue, types, ITERATIONS);
+
+  EXPECT_EQ(reference_order, queue_order);
+
+  // Events must be removable by type and clearable without leaving stale type links behind
+  queue.RemoveAll(&types[0]);
+  for (const CoreTiming::Event& event : queue.GetSortedEvents())
+    EXPECT_NE(&types[0], event.type);
+  queue.Clear();
+  EXPECT_TRUE(queue.Empty());
+  for (const CoreTiming::EventType& type : types)
+    EXPECT_EQ(CoreTiming::EventQueue::INVALID_INDEX, type.first_queued_event);
+}
+
+// EventQueue compared with the reference heap
+TEST(CoreTiming, DISABLED_EventQueueThroughput)
+{
+  using namespace EventQueueTest;
+
+  static constexpr int ITERATIONS = 200000;
+  static constexpr u64 RUNS = 10;
+  std::vector<CoreTiming::EventType> types(32);
+
+  UnitTests::RunBenchmark("Reference heap", RUNS, 0, [&] {
+    ReferenceHeap reference;
+    RunWorkload(reference, types, ITERATIONS);
+  });
+  UnitTests::RunBenchmark("EventQueue", RUNS, 0, [&] {
+    CoreTiming::EventQueue queue;
+    RunWorkload(queue, types, ITERATIONS);
+  });
+}
@@ -0,0 +1,190 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BlockCompression.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+constexpr u32 WIDTH = 64;
+constexpr u32 HEIGHT = 48;
+
+// Smooth gradients with a bit of noise, which is what block compression is meant for
+std::vector<u8> MakeImage(bool with_alpha)
+{
+  std::mt19937 rng(1234);
+  std::vector<u8> image(WIDTH * HEIGHT * 4);
+  for (u32 y = 0; y < HEIGHT; ++y)
+  {
+    for (u32 x = 0; x < WIDTH; ++x)
+    {
+      u8* texel = &image[(y * WIDTH + x) * 4];
+      const int noise = static_cast<int>(rng() % 9) - 4;
+      texel[0] = static_cast<u8>(std::clamp<int>(x * 255 / WIDTH + noise, 0, 255));
+      texel[1] = static_cast<u8>(std::clamp<int>(y * 255 / HEIGHT + noise, 0, 255));
+      texel[2] = static_cast<u8>(std::clamp<int>((x + y) * 2 + noise, 0, 255));
+      texel[3] = with_alpha ? static_cast<u8>(x * 2 + y * 2) : 0xff;
+    }
+  }
+  return image;
+}
+
+// Rearranges BC1 color blocks into the GameCube's CMPR layout, which stores the colors big endian
+// and the indices of each row starting from the most significant bits, and groups the blocks into
+// tiles of 2x2 blocks.
+std::vector<u8> ColorBlocksToCMPR(const u8* blocks, u32 block_stride)
+{
+  constexpr u32 BLOCKS_WIDE = WIDTH / VideoCommon::BC_BLOCK_SIZE;
+  constexpr u32 BLOCKS_HIGH = HEIGHT / VideoCommon::BC_BLOCK_SIZE;
+
+  std::vector<u8> cmpr(BLOCKS_WIDE * BLOCKS_HIGH * 8);
+  u8* dst = cmpr.data();
+  for (u32 tile_y = 0; tile_y < BLOCKS_HIGH; tile_y += 2)
+  {
+    for (u32 tile_x = 0; tile_x < BLOCKS_WIDE; tile_x += 2)
+    {
+      for (u32 i = 0; i < 4; ++i)
+      {
+        const u32 block_x = tile_x + (i & 1);
+        const u32 block_y = tile_y + (i >> 1);
+        const u8* src = blocks + (block_y * BLOCKS_WIDE + block_x) * block_stride;
+
+        dst[0] = src[1];
+        dst[1] = src[0];
+        dst[2] = src[3];
+        dst[3] = src[2];
+        for (u32 row = 0; row < 4; ++row)
+        {
+          u8 line = 0;
+          for (u32 column = 0; column < 4; ++column)
+            line |= ((src[4 + row] >> (column * 2)) & 3) << (6 - column * 2);
+          dst[4 + row] = line;
+        }
+        dst += 8;
+      }
+    }
+  }
+  return cmpr;
+}
+
+std::vector<u8> DecodeCMPR(const std::vector<u8>& cmpr)
+{
+  std::vector<u8> decoded(WIDTH * HEIGHT * 4);
+  TexDecoder_Decode(decoded.data(), cmpr.data(), WIDTH, HEIGHT, TextureFormat::CMPR, nullptr,
+                    TLUTFormat::IA8);
+  return decoded;
+}
+
+// The GameCube has no equivalent of BC3 alpha blocks, so they are decoded here
+std::array<u8, 16> DecodeAlphaBlock(const u8* block)
+{
+  std::array<int, 8> palette{block[0], block[1]};
+  for (int i = 2; i < 8; ++i)
+    palette[i] = ((8 - i) * block[0] + (i - 1) * block[1]) / 7;
+
+  u64 indices = 0;
+  for (int i = 0; i < 6; ++i)
+    indices |= static_cast<u64>(block[2 + i]) << (8 * i);
+
+  std::array<u8, 16> alpha;
+  for (size_t i = 0; i < alpha.size(); ++i)
+    alpha[i] = static_cast<u8>(palette[(indices >> (3 * i)) & 7]);
+  return alpha;
+}
+
+double MeanError(const std::vector<u8>& a, const std::vector<u8>& b, u32 channel)
+{
+  double sum = 0;
+  for (size_t i = channel; i < a.size(); i += 4)
+    sum += std::abs(a[i] - b[i]);
+  return sum / (a.size() / 4);
+}
+
+int MaxError(const std::vector<u8>& a, const std::vector<u8>& b, u32 channel)
+{
+  int max = 0;
+  for (size_t i = channel; i < a.size(); i += 4)
+    max = std::max(max, std::abs(a[i] - b[i]));
+  return max;
+}
+}  // namespace
+
+TEST(BlockCompression, BC1RoundTrip)
+{
+  const std::vector<u8> image = MakeImage(false);
+  std::vector<u8> compressed(
+      VideoCommon::GetBlockCompressedSize(WIDTH, HEIGHT, VideoCommon::BC1_BYTES_PER_BLOCK));
+  VideoCommon::CompressBC1(image.data(), WIDTH, HEIGHT, WIDTH, compressed.data());
+
+  const std::vector<u8> decoded =
+      DecodeCMPR(ColorBlocksToCMPR(compressed.data(), VideoCommon::BC1_BYTES_PER_BLOCK));
+  for (u32 channel = 0; channel < 3; ++channel)
+  {
+    EXPECT_LE(MeanError(image, decoded, channel), 6.0) << "channel " << channel;
+    EXPECT_LE(MaxError(image, decoded, channel), 24) << "channel " << channel;
+  }
+  EXPECT_EQ(MaxError(image, decoded, 3), 0);
+}
+
+TEST(BlockCompression, BC3RoundTrip)
+{
+  const std::vector<u8> image = MakeImage(true);
+  std::vector<u8> compressed(
+      VideoCommon::GetBlockCompressedSize(WIDTH, HEIGHT, VideoCommon::BC3_BYTES_PER_BLOCK));
+  VideoCommon::CompressBC3(image.data(), WIDTH, HEIGHT, WIDTH, compressed.data());
+
+  // The color half of each block follows the alpha half
+  std::vector<u8> decoded = DecodeCMPR(
+      ColorBlocksToCMPR(compressed.data() + 8, VideoCommon::BC3_BYTES_PER_BLOCK));
+  for (u32 block_y = 0; block_y < HEIGHT / 4; ++block_y)
+  {
+    for (u32 block_x = 0; block_x < WIDTH / 4; ++block_x)
+    {
+      const u8* block =
+          &compressed[(block_y * (WIDTH / 4) + block_x) * VideoCommon::BC3_BYTES_PER_BLOCK];
+      const std::array<u8, 16> alpha = DecodeAlphaBlock(block);
+      for (u32 i = 0; i < 16; ++i)
+        decoded[((block_y * 4 + i / 4) * WIDTH + block_x * 4 + i % 4) * 4 + 3] = alpha[i];
+    }
+  }
+
+  for (u32 channel = 0; channel < 3; ++channel)
+  {
+    EXPECT_LE(MeanError(image, decoded, channel), 6.0) << "channel " << channel;
+    EXPECT_LE(MaxError(image, decoded, channel), 24) << "channel " << channel;
+  }
+  EXPECT_LE(MeanError(image, decoded, 3), 1.0);
+  EXPECT_LE(MaxError(image, decoded, 3), 4);
+}
+
+TEST(BlockCompression, SolidColorIsExactUpToQuantization)
+{
+  std::vector<u8> image(WIDTH * HEIGHT * 4);
+  for (size_t i = 0; i < image.size(); i += 4)
+  {
+    image[i] = 200;
+    image[i + 1] = 100;
+    image[i + 2] = 50;
+    image[i + 3] = 0xff;
+  }
+
+  std::vector<u8> compressed(
+      VideoCommon::GetBlockCompressedSize(WIDTH, HEIGHT, VideoCommon::BC1_BYTES_PER_BLOCK));
+  VideoCommon::CompressBC1(image.data(), WIDTH, HEIGHT, WIDTH, compressed.data());
+
+  const std::vector<u8> decoded =
+      DecodeCMPR(ColorBlocksToCMPR(compressed.data(), VideoCommon::BC1_BYTES_PER_BLOCK));
+  EXPECT_LE(MaxError(image, decoded, 0), 4);
+  EXPECT_LE(MaxError(image, decoded, 1), 2);
+  EXPECT_LE(MaxError(image, decoded, 2), 4);
+}
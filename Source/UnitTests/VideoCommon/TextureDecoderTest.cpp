@@ -0,0 +1,159 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/ThreadPool.h"
+#include "VideoCommon/TextureDecoder.h"
+
+#include "../Benchmark.h"
+
+namespace
+{
+struct TextureMix
+{
+  TextureFormat format;
+  int width;
+  int height;
+  int levels;
+};
+
+// Representative of what games upload: large RGBA8 and CMPR textures with full mip chains,
+// paletted textures and smaller intensity textures.
+constexpr TextureMix TEXTURE_MIXES[] = {
+    {TextureFormat::RGBA8, 1024, 1024, 11}, {TextureFormat::RGBA8, 512, 512, 1},
+    {TextureFormat::CMPR, 1024, 1024, 8},   {TextureFormat::CMPR, 256, 256, 6},
+    {TextureFormat::C8, 512, 512, 1},       {TextureFormat::C4, 256, 256, 1},
+    {TextureFormat::RGB5A3, 512, 256, 5},   {TextureFormat::RGB565, 640, 480, 1},
+    {TextureFormat::IA8, 256, 256, 4},      {TextureFormat::I4, 1024, 512, 1},
+    {TextureFormat::I8, 128, 128, 1},
+};
+
+struct PreparedTexture
+{
+  TextureFormat format;
+  std::vector<u8> src;
+  std::vector<u8> reference;
+  std::vector<u8> decoded;
+  std::vector<TexDecoderLevel> levels;
+};
+
+PreparedTexture PrepareTexture(const TextureMix& mix, std::mt19937& rng)
+{
+  PreparedTexture texture;
+  texture.format = mix.format;
+
+  const int block_width = TexDecoder_GetBlockWidthInTexels(mix.format);
+  const int block_height = TexDecoder_GetBlockHeightInTexels(mix.format);
+
+  size_t src_size = 0;
+  size_t dst_size = 0;
+  std::vector<std::pair<int, int>> sizes;
+  for (int level = 0; level < mix.levels; level++)
+  {
+    const int width = std::max(mix.width >> level, 1);
+    const int height = std::max(mix.height >> level, 1);
+    const int expanded_width = (width + block_width - 1) / block_width * block_width;
+    const int expanded_height = (height + block_height - 1) / block_height * block_height;
+    sizes.emplace_back(expanded_width, expanded_height);
+    src_size += TexDecoder_GetTextureSizeInBytes(expanded_width, expanded_height, mix.format);
+    dst_size += expanded_width * expanded_height * 4;
+  }
+
+  texture.src.resize(src_size);
+  for (u8& byte : texture.src)
+    byte = static_cast<u8>(rng());
+  texture.reference.resize(dst_size);
+  texture.decoded.resize(dst_size);
+
+  size_t src_offset = 0;
+  size_t dst_offset = 0;
+  for (const auto& [width, height] : sizes)
+  {
+    texture.levels.push_back(
+        {texture.decoded.data() + dst_offset, texture.src.data() + src_offset, width, height});
+    src_offset += TexDecoder_GetTextureSizeInBytes(width, height, mix.format);
+    dst_offset += width * height * 4;
+  }
+
+  return texture;
+}
+
+std::vector<PreparedTexture> PrepareTextures(std::mt19937& rng)
+{
+  std::vector<PreparedTexture> textures;
+  for (const TextureMix& mix : TEXTURE_MIXES)
+    textures.push_back(PrepareTexture(mix, rng));
+  return textures;
+}
+
+std::vector<u8> MakeTLUT(std::mt19937& rng)
+{
+  std::vector<u8> tlut(512);
+  for (u8& byte : tlut)
+    byte = static_cast<u8>(rng());
+  return tlut;
+}
+
+void DecodeSerially(PreparedTexture& texture, const u8* tlut)
+{
+  for (const TexDecoderLevel& level : texture.levels)
+  {
+    const size_t offset = level.dst - texture.decoded.data();
+    TexDecoder_Decode(texture.reference.data() + offset, level.src, level.width, level.height,
+                      texture.format, tlut, TLUTFormat::RGB5A3);
+  }
+}
+}  // namespace
+
+TEST(TextureDecoder, DecodeLevelsMatchesDecode)
+{
+  std::mt19937 rng(1234);
+  const std::vector<u8> tlut = MakeTLUT(rng);
+  std::vector<PreparedTexture> textures = PrepareTextures(rng);
+
+  Common::ThreadPool pool;
+  pool.Start(3, "Texture Decoding");
+
+  for (PreparedTexture& texture : textures)
+  {
+    DecodeSerially(texture, tlut.data());
+    TexDecoder_DecodeLevels(pool, texture.levels, texture.format, tlut.data(),
+                            TLUTFormat::RGB5A3);
+    EXPECT_EQ(texture.reference, texture.decoded) << fmt::to_string(texture.format);
+  }
+}
+
+// Decoding mip levels on a thread pool compared with decoding them one after another
+TEST(TextureDecoder, DISABLED_DecodeLevelsThroughput)
+{
+  static constexpr u64 RUNS = 20;
+
+  std::mt19937 rng(1234);
+  const std::vector<u8> tlut = MakeTLUT(rng);
+  std::vector<PreparedTexture> textures = PrepareTextures(rng);
+
+  Common::ThreadPool pool;
+  pool.Start(3, "Texture Decoding");
+
+  UnitTests::RunBenchmark("Serial decoding", RUNS, 0, [&] {
+    for (PreparedTexture& texture : textures)
+      DecodeSerially(texture, tlut.data());
+  });
+  const auto decode_on_pool = [&] {
+    for (PreparedTexture& texture : textures)
+    {
+      TexDecoder_DecodeLevels(pool, texture.levels, texture.format, tlut.data(),
+                              TLUTFormat::RGB5A3);
+    }
+  };
+  UnitTests::RunBenchmark(fmt::format("Decoding with {} workers", pool.GetNumWorkers()), RUNS, 0,
+                          decode_on_pool);
+}